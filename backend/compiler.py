@@ -1 +1,209 @@
-# A placeholder file retained to ensure the build functions correctly.
+"""Triton-linalg compilation entry points.
+
+`make_linalg` lowers Triton IR to linalg on tensors with `triton-linalg-opt`.
+The results are kept in an on-disk, content-addressed cache, so identical
+kernels are not recompiled after a process restart.
+
+Environment variables:
+  TRITON_LINALG_OPT_PATH       path of triton-linalg-opt (default: $PATH).
+  TRITON_LINALG_CACHE_DIR      cache directory
+                               (default: ~/.triton/linalg_cache).
+  TRITON_LINALG_CACHE_SIZE     cache size cap in bytes (default: 1 GiB).
+  TRITON_LINALG_CACHE_DISABLE  set to 1 to bypass the cache.
+"""
+
+import functools
+import hashlib
+import json
+import os
+import shutil
+import subprocess
+import tempfile
+import threading
+
+__version__ = "0.1.0"
+
+_DEFAULT_CACHE_SIZE = 1 << 30
+_ENTRY_SUFFIX = ".mlir"
+
+
+def _opt_path():
+    path = os.environ.get("TRITON_LINALG_OPT_PATH") or shutil.which("triton-linalg-opt")
+    if not path or not os.path.exists(path):
+        raise RuntimeError("triton-linalg-opt not found, set TRITON_LINALG_OPT_PATH")
+    return path
+
+
+@functools.lru_cache(maxsize=None)
+def _tool_version(path, size, mtime):
+    """Hash of the triton-linalg-opt binary, so that a rebuilt tool misses."""
+    sha = hashlib.sha256()
+    with open(path, "rb") as f:
+        for chunk in iter(lambda: f.read(1 << 20), b""):
+            sha.update(chunk)
+    return f"{__version__}-{sha.hexdigest()}"
+
+
+def tool_version(path=None):
+    path = path or _opt_path()
+    stat = os.stat(path)
+    return _tool_version(path, stat.st_size, stat.st_mtime_ns)
+
+
+def cache_key(ttir, options, version):
+    """Content address of a compilation: input IR, pipeline options and tool."""
+    sha = hashlib.sha256()
+    for part in (ttir, json.dumps(options, sort_keys=True, default=str), version):
+        data = part.encode("utf-8")
+        # Length prefix keeps the concatenation unambiguous.
+        sha.update(len(data).to_bytes(8, "little"))
+        sha.update(data)
+    return sha.hexdigest()
+
+
+class LinalgCache:
+    """Content-addressed compile cache with atomic writes and an LRU size cap.
+
+    Entries are plain files named by their key. Reads refresh the entry mtime,
+    which is the recency used for eviction, so several processes can share a
+    directory without extra bookkeeping. The size of the directory is only
+    scanned on construction and when the running size exceeds the cap, as
+    other processes may have written or evicted entries in the meantime.
+    """
+
+    def __init__(self, cache_dir, max_size=_DEFAULT_CACHE_SIZE):
+        self.cache_dir = cache_dir
+        self.max_size = max_size
+        self.hits = 0
+        self.misses = 0
+        self.evictions = 0
+        self._lock = threading.Lock()
+        os.makedirs(cache_dir, exist_ok=True)
+        self._size = sum(size for _, size, _ in self._scan())
+
+    def _path(self, key):
+        return os.path.join(self.cache_dir, key + _ENTRY_SUFFIX)
+
+    def _scan(self):
+        """(mtime, size, path) of every entry of the cache directory."""
+        entries = []
+        with os.scandir(self.cache_dir) as it:
+            for entry in it:
+                if not entry.name.endswith(_ENTRY_SUFFIX):
+                    continue
+                try:
+                    stat = entry.stat()
+                except FileNotFoundError:
+                    continue
+                entries.append((stat.st_mtime_ns, stat.st_size, entry.path))
+        return entries
+
+    def get(self, key):
+        path = self._path(key)
+        try:
+            with open(path, "r", encoding="utf-8") as f:
+                data = f.read()
+            os.utime(path)
+        except FileNotFoundError:
+            with self._lock:
+                self.misses += 1
+            return None
+        with self._lock:
+            self.hits += 1
+        return data
+
+    def put(self, key, data):
+        path = self._path(key)
+        try:
+            replaced = os.stat(path).st_size
+        except FileNotFoundError:
+            replaced = 0
+        # Write to a temporary file in the same directory then rename, so that
+        # concurrent readers never observe a partial entry.
+        fd, tmp = tempfile.mkstemp(dir=self.cache_dir, prefix=".tmp-")
+        try:
+            with os.fdopen(fd, "w", encoding="utf-8") as f:
+                f.write(data)
+                f.flush()
+                os.fsync(f.fileno())
+                written = os.fstat(f.fileno()).st_size
+            os.replace(tmp, path)
+        except BaseException:
+            if os.path.exists(tmp):
+                os.unlink(tmp)
+            raise
+        with self._lock:
+            self._size += written - replaced
+            if self._size <= self.max_size:
+                return
+        self._evict()
+
+    def _evict(self):
+        entries = self._scan()
+        total = sum(size for _, size, _ in entries)
+        entries.sort()
+        evicted = 0
+        for _, size, path in entries:
+            if total <= self.max_size:
+                break
+            try:
+                os.unlink(path)
+                evicted += 1
+            except FileNotFoundError:
+                # Evicted by another process, which counted it.
+                pass
+            total -= size
+        with self._lock:
+            self._size = total
+            self.evictions += evicted
+
+    def stats(self):
+        with self._lock:
+            return {"hits": self.hits, "misses": self.misses, "evictions": self.evictions}
+
+
+_cache = None
+_cache_lock = threading.Lock()
+
+
+def get_cache():
+    """Process wide cache, or None if disabled."""
+    global _cache
+    if os.environ.get("TRITON_LINALG_CACHE_DISABLE", "0") == "1":
+        return None
+    with _cache_lock:
+        if _cache is None:
+            cache_dir = os.environ.get("TRITON_LINALG_CACHE_DIR",
+                                       os.path.join(os.path.expanduser("~"), ".triton", "linalg_cache"))
+            max_size = int(os.environ.get("TRITON_LINALG_CACHE_SIZE", _DEFAULT_CACHE_SIZE))
+            _cache = LinalgCache(cache_dir, max_size)
+        return _cache
+
+
+def _run_pipeline(opt, ttir, options):
+    pipeline = options.get("pipeline", "triton-to-linalg")
+    args = [opt, f"--{pipeline}"] + list(options.get("extra_args", []))
+    proc = subprocess.run(args, input=ttir, capture_output=True, text=True)
+    if proc.returncode != 0:
+        raise RuntimeError(f"triton-linalg-opt failed:\n{proc.stderr}")
+    return proc.stdout
+
+
+def make_linalg(ttir, options=None):
+    """Lower the textual Triton IR `ttir` to linalg, going through the cache.
+
+    `options` is a json serializable dict, `pipeline` selects the registered
+    pipeline (default: triton-to-linalg) and `extra_args` are appended to the
+    triton-linalg-opt command line. All of it is part of the cache key.
+    """
+    options = dict(options or {})
+    opt = _opt_path()
+    cache = get_cache()
+    if cache is None:
+        return _run_pipeline(opt, ttir, options)
+    key = cache_key(ttir, options, tool_version(opt))
+    linalg = cache.get(key)
+    if linalg is None:
+        linalg = _run_pipeline(opt, ttir, options)
+        cache.put(key, linalg)
+    return linalg
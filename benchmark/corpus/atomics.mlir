@@ -0,0 +1,23 @@
+// Histogram with scattered atomic adds and a spin lock through atomic_cas.
+tt.func public @histogram_kernel(%in_ptr: !tt.ptr<i32>, %hist_ptr: !tt.ptr<f32>, %lock_ptr: !tt.ptr<i32>, %n: i32) {
+  %c0_i32 = arith.constant 0 : i32
+  %c1_i32 = arith.constant 1 : i32
+  %c512_i32 = arith.constant 512 : i32
+  %cst = arith.constant dense<1.000000e+00> : tensor<512xf32>
+  %pid = tt.get_program_id x : i32
+  %0 = arith.muli %pid, %c512_i32 : i32
+  %1 = tt.make_range {end = 512 : i32, start = 0 : i32} : tensor<512xi32>
+  %2 = tt.splat %0 : i32 -> tensor<512xi32>
+  %offs = arith.addi %2, %1 : tensor<512xi32>
+  %3 = tt.splat %n : i32 -> tensor<512xi32>
+  %mask = arith.cmpi slt, %offs, %3 : tensor<512xi32>
+  %4 = tt.splat %in_ptr : !tt.ptr<i32> -> tensor<512x!tt.ptr<i32>>
+  %5 = tt.addptr %4, %offs : tensor<512x!tt.ptr<i32>>, tensor<512xi32>
+  %bins = tt.load %5, %mask {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<512x!tt.ptr<i32>>
+  %6 = tt.splat %hist_ptr : !tt.ptr<f32> -> tensor<512x!tt.ptr<f32>>
+  %7 = tt.addptr %6, %bins : tensor<512x!tt.ptr<f32>>, tensor<512xi32>
+  %8 = tt.atomic_rmw fadd, acq_rel, gpu, %7, %cst, %mask : (tensor<512x!tt.ptr<f32>>, tensor<512xf32>, tensor<512xi1>) -> tensor<512xf32>
+  %9 = tt.atomic_cas acq_rel, gpu, %lock_ptr, %c0_i32, %c1_i32 : (!tt.ptr<i32>, i32, i32) -> i32
+  %10 = tt.atomic_rmw xchg, acq_rel, gpu, %lock_ptr, %c0_i32 : (!tt.ptr<i32>, i32) -> i32
+  tt.return
+}
@@ -0,0 +1,24 @@
+// Embedding style gather followed by an indexed scatter.
+tt.func public @gather_scatter_kernel(%src_ptr: !tt.ptr<f32>, %idx_ptr: !tt.ptr<i32>, %dst_ptr: !tt.ptr<f32>, %dst_idx_ptr: !tt.ptr<i32>, %n: i32) {
+  %c256_i32 = arith.constant 256 : i32
+  %pid = tt.get_program_id x : i32
+  %0 = arith.muli %pid, %c256_i32 : i32
+  %1 = tt.make_range {end = 256 : i32, start = 0 : i32} : tensor<256xi32>
+  %2 = tt.splat %0 : i32 -> tensor<256xi32>
+  %offs = arith.addi %2, %1 : tensor<256xi32>
+  %3 = tt.splat %n : i32 -> tensor<256xi32>
+  %mask = arith.cmpi slt, %offs, %3 : tensor<256xi32>
+  %4 = tt.splat %idx_ptr : !tt.ptr<i32> -> tensor<256x!tt.ptr<i32>>
+  %5 = tt.addptr %4, %offs : tensor<256x!tt.ptr<i32>>, tensor<256xi32>
+  %idx = tt.load %5, %mask {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<256x!tt.ptr<i32>>
+  %6 = tt.splat %src_ptr : !tt.ptr<f32> -> tensor<256x!tt.ptr<f32>>
+  %7 = tt.addptr %6, %idx : tensor<256x!tt.ptr<f32>>, tensor<256xi32>
+  %val = tt.load %7, %mask {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<256x!tt.ptr<f32>>
+  %8 = tt.splat %dst_idx_ptr : !tt.ptr<i32> -> tensor<256x!tt.ptr<i32>>
+  %9 = tt.addptr %8, %offs : tensor<256x!tt.ptr<i32>>, tensor<256xi32>
+  %dst_idx = tt.load %9, %mask {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<256x!tt.ptr<i32>>
+  %10 = tt.splat %dst_ptr : !tt.ptr<f32> -> tensor<256x!tt.ptr<f32>>
+  %11 = tt.addptr %10, %dst_idx : tensor<256x!tt.ptr<f32>>, tensor<256xi32>
+  tt.store %11, %val, %mask {cache = 1 : i32, evict = 1 : i32} : tensor<256x!tt.ptr<f32>>
+  tt.return
+}
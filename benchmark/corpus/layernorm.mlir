@@ -0,0 +1,47 @@
+// Layer norm forward, one row per program.
+tt.func public @layer_norm_fwd(%x_ptr: !tt.ptr<f32>, %y_ptr: !tt.ptr<f32>, %w_ptr: !tt.ptr<f32>, %b_ptr: !tt.ptr<f32>, %stride: i32, %n: i32, %eps: f32) {
+  %cst = arith.constant dense<0.000000e+00> : tensor<512xf32>
+  %row = tt.get_program_id x : i32
+  %0 = arith.muli %row, %stride : i32
+  %offs = tt.make_range {end = 512 : i32, start = 0 : i32} : tensor<512xi32>
+  %1 = tt.splat %n : i32 -> tensor<512xi32>
+  %mask = arith.cmpi slt, %offs, %1 : tensor<512xi32>
+  %2 = tt.addptr %x_ptr, %0 : !tt.ptr<f32>, i32
+  %3 = tt.splat %2 : !tt.ptr<f32> -> tensor<512x!tt.ptr<f32>>
+  %4 = tt.addptr %3, %offs : tensor<512x!tt.ptr<f32>>, tensor<512xi32>
+  %x = tt.load %4, %mask, %cst {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<512x!tt.ptr<f32>>
+  %sum = "tt.reduce"(%x) ({
+  ^bb0(%a: f32, %b: f32):
+    %r = arith.addf %a, %b : f32
+    tt.reduce.return %r : f32
+  }) {axis = 0 : i32} : (tensor<512xf32>) -> f32
+  %nf = arith.sitofp %n : i32 to f32
+  %mean = arith.divf %sum, %nf : f32
+  %5 = tt.splat %mean : f32 -> tensor<512xf32>
+  %6 = arith.subf %x, %5 : tensor<512xf32>
+  %xc = arith.select %mask, %6, %cst : tensor<512xi1>, tensor<512xf32>
+  %7 = arith.mulf %xc, %xc : tensor<512xf32>
+  %sumsq = "tt.reduce"(%7) ({
+  ^bb0(%a: f32, %b: f32):
+    %r = arith.addf %a, %b : f32
+    tt.reduce.return %r : f32
+  }) {axis = 0 : i32} : (tensor<512xf32>) -> f32
+  %var = arith.divf %sumsq, %nf : f32
+  %8 = arith.addf %var, %eps : f32
+  %rstd = math.rsqrt %8 : f32
+  %9 = tt.splat %w_ptr : !tt.ptr<f32> -> tensor<512x!tt.ptr<f32>>
+  %10 = tt.addptr %9, %offs : tensor<512x!tt.ptr<f32>>, tensor<512xi32>
+  %w = tt.load %10, %mask {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<512x!tt.ptr<f32>>
+  %11 = tt.splat %b_ptr : !tt.ptr<f32> -> tensor<512x!tt.ptr<f32>>
+  %12 = tt.addptr %11, %offs : tensor<512x!tt.ptr<f32>>, tensor<512xi32>
+  %b = tt.load %12, %mask {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<512x!tt.ptr<f32>>
+  %13 = tt.splat %rstd : f32 -> tensor<512xf32>
+  %14 = arith.mulf %xc, %13 : tensor<512xf32>
+  %15 = arith.mulf %14, %w : tensor<512xf32>
+  %y = arith.addf %15, %b : tensor<512xf32>
+  %16 = tt.addptr %y_ptr, %0 : !tt.ptr<f32>, i32
+  %17 = tt.splat %16 : !tt.ptr<f32> -> tensor<512x!tt.ptr<f32>>
+  %18 = tt.addptr %17, %offs : tensor<512x!tt.ptr<f32>>, tensor<512xi32>
+  tt.store %18, %y, %mask {cache = 1 : i32, evict = 1 : i32} : tensor<512x!tt.ptr<f32>>
+  tt.return
+}
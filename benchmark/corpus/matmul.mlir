@@ -0,0 +1,74 @@
+// Blocked matmul main loop: C[M, N] = A[M, K] x B[K, N].
+tt.func public @matmul_kernel(%a_ptr: !tt.ptr<f16>, %b_ptr: !tt.ptr<f16>, %c_ptr: !tt.ptr<f32>, %M: i32, %N: i32, %K: i32, %stride_am: i32, %stride_bk: i32, %stride_cm: i32) {
+  %c0_i32 = arith.constant 0 : i32
+  %c32_i32 = arith.constant 32 : i32
+  %c64_i32 = arith.constant 64 : i32
+  %cst = arith.constant dense<0.000000e+00> : tensor<64x64xf32>
+  %cst_0 = arith.constant dense<0.000000e+00> : tensor<64x32xf16>
+  %cst_1 = arith.constant dense<0.000000e+00> : tensor<32x64xf16>
+  %pid_m = tt.get_program_id x : i32
+  %pid_n = tt.get_program_id y : i32
+  %0 = arith.muli %pid_m, %c64_i32 : i32
+  %1 = arith.muli %pid_n, %c64_i32 : i32
+  %2 = tt.make_range {end = 64 : i32, start = 0 : i32} : tensor<64xi32>
+  %3 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+  %4 = tt.splat %0 : i32 -> tensor<64xi32>
+  %offs_m = arith.addi %4, %2 : tensor<64xi32>
+  %5 = tt.splat %1 : i32 -> tensor<64xi32>
+  %offs_n = arith.addi %5, %2 : tensor<64xi32>
+  // A block pointers: a_ptr + offs_m[:, None] * stride_am + offs_k[None, :].
+  %6 = tt.expand_dims %offs_m {axis = 1 : i32} : tensor<64xi32> -> tensor<64x1xi32>
+  %7 = tt.splat %stride_am : i32 -> tensor<64x1xi32>
+  %8 = arith.muli %6, %7 : tensor<64x1xi32>
+  %9 = tt.broadcast %8 : tensor<64x1xi32> -> tensor<64x32xi32>
+  %10 = tt.expand_dims %3 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+  %11 = tt.broadcast %10 : tensor<1x32xi32> -> tensor<64x32xi32>
+  %12 = arith.addi %9, %11 : tensor<64x32xi32>
+  %13 = tt.splat %a_ptr : !tt.ptr<f16> -> tensor<64x32x!tt.ptr<f16>>
+  %a_ptrs = tt.addptr %13, %12 : tensor<64x32x!tt.ptr<f16>>, tensor<64x32xi32>
+  // B block pointers: b_ptr + offs_k[:, None] * stride_bk + offs_n[None, :].
+  %14 = tt.expand_dims %3 {axis = 1 : i32} : tensor<32xi32> -> tensor<32x1xi32>
+  %15 = tt.splat %stride_bk : i32 -> tensor<32x1xi32>
+  %16 = arith.muli %14, %15 : tensor<32x1xi32>
+  %17 = tt.broadcast %16 : tensor<32x1xi32> -> tensor<32x64xi32>
+  %18 = tt.expand_dims %offs_n {axis = 0 : i32} : tensor<64xi32> -> tensor<1x64xi32>
+  %19 = tt.broadcast %18 : tensor<1x64xi32> -> tensor<32x64xi32>
+  %20 = arith.addi %17, %19 : tensor<32x64xi32>
+  %21 = tt.splat %b_ptr : !tt.ptr<f16> -> tensor<32x64x!tt.ptr<f16>>
+  %b_ptrs = tt.addptr %21, %20 : tensor<32x64x!tt.ptr<f16>>, tensor<32x64xi32>
+  %22 = arith.muli %stride_bk, %c32_i32 : i32
+  %23 = tt.splat %22 : i32 -> tensor<32x64xi32>
+  %24 = tt.splat %c32_i32 : i32 -> tensor<64x32xi32>
+  %acc:3 = scf.for %k = %c0_i32 to %K step %c32_i32 iter_args(%acc_it = %cst, %a_it = %a_ptrs, %b_it = %b_ptrs) -> (tensor<64x64xf32>, tensor<64x32x!tt.ptr<f16>>, tensor<32x64x!tt.ptr<f16>>) : i32 {
+    %25 = arith.subi %K, %k : i32
+    %26 = tt.splat %25 : i32 -> tensor<1x32xi32>
+    %27 = arith.cmpi slt, %10, %26 : tensor<1x32xi32>
+    %28 = tt.broadcast %27 : tensor<1x32xi1> -> tensor<64x32xi1>
+    %a = tt.load %a_it, %28, %cst_0 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<64x32x!tt.ptr<f16>>
+    %29 = tt.splat %25 : i32 -> tensor<32x1xi32>
+    %30 = arith.cmpi slt, %14, %29 : tensor<32x1xi32>
+    %31 = tt.broadcast %30 : tensor<32x1xi1> -> tensor<32x64xi1>
+    %b = tt.load %b_it, %31, %cst_1 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<32x64x!tt.ptr<f16>>
+    %32 = tt.dot %a, %b, %acc_it {inputPrecision = 0 : i32, maxNumImpreciseAcc = 0 : i32} : tensor<64x32xf16> * tensor<32x64xf16> -> tensor<64x64xf32>
+    %33 = tt.addptr %a_it, %24 : tensor<64x32x!tt.ptr<f16>>, tensor<64x32xi32>
+    %34 = tt.addptr %b_it, %23 : tensor<32x64x!tt.ptr<f16>>, tensor<32x64xi32>
+    scf.yield %32, %33, %34 : tensor<64x64xf32>, tensor<64x32x!tt.ptr<f16>>, tensor<32x64x!tt.ptr<f16>>
+  }
+  // C store with boundary mask.
+  %35 = tt.splat %stride_cm : i32 -> tensor<64x1xi32>
+  %36 = arith.muli %6, %35 : tensor<64x1xi32>
+  %37 = tt.broadcast %36 : tensor<64x1xi32> -> tensor<64x64xi32>
+  %38 = tt.broadcast %18 : tensor<1x64xi32> -> tensor<64x64xi32>
+  %39 = arith.addi %37, %38 : tensor<64x64xi32>
+  %40 = tt.splat %c_ptr : !tt.ptr<f32> -> tensor<64x64x!tt.ptr<f32>>
+  %c_ptrs = tt.addptr %40, %39 : tensor<64x64x!tt.ptr<f32>>, tensor<64x64xi32>
+  %41 = tt.splat %M : i32 -> tensor<64x1xi32>
+  %42 = arith.cmpi slt, %6, %41 : tensor<64x1xi32>
+  %43 = tt.broadcast %42 : tensor<64x1xi1> -> tensor<64x64xi1>
+  %44 = tt.splat %N : i32 -> tensor<1x64xi32>
+  %45 = arith.cmpi slt, %18, %44 : tensor<1x64xi32>
+  %46 = tt.broadcast %45 : tensor<1x64xi1> -> tensor<64x64xi1>
+  %mask = arith.andi %43, %46 : tensor<64x64xi1>
+  tt.store %c_ptrs, %acc#0, %mask {cache = 1 : i32, evict = 1 : i32} : tensor<64x64x!tt.ptr<f32>>
+  tt.return
+}
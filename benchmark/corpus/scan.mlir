@@ -0,0 +1,20 @@
+// Row-wise cumulative sum.
+tt.func public @cumsum_kernel(%in_ptr: !tt.ptr<f32>, %out_ptr: !tt.ptr<f32>, %row_stride: i32) {
+  %row = tt.get_program_id x : i32
+  %0 = arith.muli %row, %row_stride : i32
+  %offs = tt.make_range {end = 2048 : i32, start = 0 : i32} : tensor<2048xi32>
+  %1 = tt.addptr %in_ptr, %0 : !tt.ptr<f32>, i32
+  %2 = tt.splat %1 : !tt.ptr<f32> -> tensor<2048x!tt.ptr<f32>>
+  %3 = tt.addptr %2, %offs : tensor<2048x!tt.ptr<f32>>, tensor<2048xi32>
+  %x = tt.load %3 {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<2048x!tt.ptr<f32>>
+  %y = "tt.scan"(%x) ({
+  ^bb0(%a: f32, %b: f32):
+    %r = arith.addf %a, %b : f32
+    tt.scan.return %r : f32
+  }) {axis = 0 : i32, reverse = false} : (tensor<2048xf32>) -> tensor<2048xf32>
+  %4 = tt.addptr %out_ptr, %0 : !tt.ptr<f32>, i32
+  %5 = tt.splat %4 : !tt.ptr<f32> -> tensor<2048x!tt.ptr<f32>>
+  %6 = tt.addptr %5, %offs : tensor<2048x!tt.ptr<f32>>, tensor<2048xi32>
+  tt.store %6, %y {cache = 1 : i32, evict = 1 : i32} : tensor<2048x!tt.ptr<f32>>
+  tt.return
+}
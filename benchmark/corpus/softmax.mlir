@@ -0,0 +1,33 @@
+// Row-wise softmax, one row per program.
+tt.func public @softmax_kernel(%out_ptr: !tt.ptr<f32>, %in_ptr: !tt.ptr<f32>, %row_stride: i32, %n_cols: i32) {
+  %cst = arith.constant dense<0xFF800000> : tensor<1024xf32>
+  %row = tt.get_program_id x : i32
+  %0 = arith.muli %row, %row_stride : i32
+  %1 = tt.addptr %in_ptr, %0 : !tt.ptr<f32>, i32
+  %offs = tt.make_range {end = 1024 : i32, start = 0 : i32} : tensor<1024xi32>
+  %2 = tt.splat %1 : !tt.ptr<f32> -> tensor<1024x!tt.ptr<f32>>
+  %3 = tt.addptr %2, %offs : tensor<1024x!tt.ptr<f32>>, tensor<1024xi32>
+  %4 = tt.splat %n_cols : i32 -> tensor<1024xi32>
+  %mask = arith.cmpi slt, %offs, %4 : tensor<1024xi32>
+  %x = tt.load %3, %mask, %cst {cache = 1 : i32, evict = 1 : i32, isVolatile = false} : tensor<1024x!tt.ptr<f32>>
+  %max = "tt.reduce"(%x) ({
+  ^bb0(%a: f32, %b: f32):
+    %r = arith.maxnumf %a, %b : f32
+    tt.reduce.return %r : f32
+  }) {axis = 0 : i32} : (tensor<1024xf32>) -> f32
+  %5 = tt.splat %max : f32 -> tensor<1024xf32>
+  %6 = arith.subf %x, %5 : tensor<1024xf32>
+  %num = math.exp %6 : tensor<1024xf32>
+  %den = "tt.reduce"(%num) ({
+  ^bb0(%a: f32, %b: f32):
+    %r = arith.addf %a, %b : f32
+    tt.reduce.return %r : f32
+  }) {axis = 0 : i32} : (tensor<1024xf32>) -> f32
+  %7 = tt.splat %den : f32 -> tensor<1024xf32>
+  %y = arith.divf %num, %7 : tensor<1024xf32>
+  %8 = tt.addptr %out_ptr, %0 : !tt.ptr<f32>, i32
+  %9 = tt.splat %8 : !tt.ptr<f32> -> tensor<1024x!tt.ptr<f32>>
+  %10 = tt.addptr %9, %offs : tensor<1024x!tt.ptr<f32>>, tensor<1024xi32>
+  tt.store %10, %y, %mask {cache = 1 : i32, evict = 1 : i32} : tensor<1024x!tt.ptr<f32>>
+  tt.return
+}
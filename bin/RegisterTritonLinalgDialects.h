@@ -10,6 +10,7 @@
 #include "triton-linalg/Conversion/Passes.h"
 #include "triton-linalg/Dialect/Triton/Transforms/Passes.h"
 #include "triton-linalg/Dialect/Arith/Transforms/Passes.h"
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
 
 inline void registerTritonLinalgDialects(mlir::DialectRegistry &registry) {
   // Triton.
@@ -26,6 +27,7 @@ inline void registerTritonLinalgDialects(mlir::DialectRegistry &registry) {
 
 inline void registerTritonLinalgPasses() {
   ::mlir::triton::arith_ext::registerArithExtPasses();
+  ::mlir::triton::linalg_ext::registerLinalgExtPasses();
   ::mlir::triton::registerTritonLinalgConversionPasses();
   ::mlir::triton::registerTritonTransformsExtendPasses();
 }
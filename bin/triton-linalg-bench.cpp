@@ -0,0 +1,420 @@
+//===- triton-linalg-bench.cpp - Compile time benchmark ---------*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+//
+// Runs the triton-to-linalg pipeline over a corpus of kernels and reports wall
+// time, peak RSS and IR op count after every pass (including the nested pass
+// pipelines and the DataFlowSolver run inside convert-triton-to-linalg).
+//
+// With `--baseline`, the results are compared against a previously written
+// report and the tool exits with a non-zero code when a pass or a kernel got
+// slower than the given threshold.
+//
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <chrono>
+#include <stdint.h>
+#include <string>
+#include <sys/resource.h>
+#include <utility>
+#include <vector>
+
+#include "./RegisterTritonLinalgDialects.h"
+#include "triton-linalg/Analysis/AxisInfoAnalysis.h"
+#include "triton-linalg/Pipelines/Pipelines.h"
+
+#include "mlir/IR/Action.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/OwningOpRef.h"
+#include "mlir/InitAllDialects.h"
+#include "mlir/InitAllExtensions.h"
+#include "mlir/Parser/Parser.h"
+#include "mlir/Pass/PassInstrumentation.h"
+#include "mlir/Pass/PassManager.h"
+#include "mlir/Support/FileUtilities.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace mlir;
+
+static llvm::cl::list<std::string>
+    inputFilenames(llvm::cl::Positional, llvm::cl::OneOrMore,
+                   llvm::cl::desc("<kernel .mlir files>"));
+
+static llvm::cl::opt<unsigned>
+    repeat("repeat", llvm::cl::init(3),
+           llvm::cl::desc("Number of times the pipeline is run per kernel, "
+                          "the fastest run is reported"));
+
+static llvm::cl::opt<std::string>
+    outputFilename("o", llvm::cl::init(""),
+                   llvm::cl::desc("Write the report as json to this file"),
+                   llvm::cl::value_desc("filename"));
+
+static llvm::cl::opt<std::string> baselineFilename(
+    "baseline", llvm::cl::init(""),
+    llvm::cl::desc("Json report to compare against, enables the regression "
+                   "threshold mode"),
+    llvm::cl::value_desc("filename"));
+
+static llvm::cl::opt<double>
+    threshold("threshold", llvm::cl::init(10.0),
+              llvm::cl::desc("Allowed slowdown in percent against the "
+                             "baseline before reporting a regression"));
+
+static llvm::cl::opt<double> minTimeMs(
+    "min-time-ms", llvm::cl::init(1.0),
+    llvm::cl::desc("Ignore regressions whose absolute slowdown is below this "
+                   "value (in milliseconds), to filter out timer noise"));
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/// Statistics of one pass (or of the axis info solver) in the pipeline.
+struct PassRecord {
+  /// Unique key of the pass inside the pipeline: the ordinal and the name of
+  /// the pass and all of its parent passes, so that the repeated canonicalize
+  /// runs are kept apart.
+  std::string key;
+  std::string name;
+  unsigned depth = 0;
+  double wallMs = 0;
+  /// High water mark of the process RSS after the pass.
+  int64_t peakRssKb = 0;
+  /// Growth of the high water mark caused by this pass.
+  int64_t rssGrowthKb = 0;
+  /// Number of operations nested under the ops the pass ran on.
+  int64_t numOps = 0;
+};
+
+struct KernelProfile {
+  std::string file;
+  double totalMs = 0;
+  SmallVector<PassRecord> records;
+};
+
+int64_t getPeakRssKb() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+int64_t countOps(Operation *op) {
+  int64_t num = 0;
+  op->walk([&](Operation *) { ++num; });
+  return num;
+}
+
+/// Collects a PassRecord for each pass executed by the pass manager. Passes
+/// nested under a pass adaptor are merged over all the ops they run on.
+class CompileTimeProfiler : public PassInstrumentation {
+public:
+  explicit CompileTimeProfiler(KernelProfile &profile) : profile(profile) {}
+
+  void runBeforePass(Pass *pass, Operation *op) override {
+    begin(pass->getArgument().empty() ? pass->getName() : pass->getArgument(),
+          op);
+  }
+  void runAfterPass(Pass *pass, Operation *op) override { end(op); }
+  void runAfterPassFailed(Pass *pass, Operation *op) override { end(op); }
+
+  /// Action handler timing the axis info solver as a child of the current
+  /// pass.
+  void handleAction(function_ref<void()> transform,
+                    const tracing::Action &action) {
+    if (action.getTag() != triton::AxisInfoSolverAction::tag) {
+      transform();
+      return;
+    }
+    ArrayRef<IRUnit> units = action.getContextIRUnits();
+    Operation *op =
+        units.empty() ? nullptr : units.front().dyn_cast<Operation *>();
+    begin("axis-info-solver", op);
+    transform();
+    end(op);
+  }
+
+private:
+  struct Frame {
+    size_t recordIdx;
+    Clock::time_point start;
+    int64_t rssBefore;
+    Operation *lastChildOp = nullptr;
+    unsigned numChildren = 0;
+  };
+
+  void begin(StringRef name, Operation *op) {
+    std::string key;
+    unsigned ordinal = topLevelChildren;
+    if (!stack.empty()) {
+      Frame &parent = stack.back();
+      // A pass adaptor reruns its nested pipeline for each op, restart the
+      // numbering so that the runs are merged into the same records.
+      if (parent.lastChildOp != op) {
+        parent.lastChildOp = op;
+        parent.numChildren = 0;
+      }
+      ordinal = parent.numChildren++;
+      key = profile.records[parent.recordIdx].key + "/";
+    } else {
+      ++topLevelChildren;
+    }
+    key += std::to_string(ordinal) + ":" + name.str();
+
+    auto it = recordIdxs.find(key);
+    size_t idx;
+    if (it == recordIdxs.end()) {
+      idx = profile.records.size();
+      recordIdxs[key] = idx;
+      PassRecord record;
+      record.key = key;
+      record.name = name.str();
+      record.depth = stack.size();
+      profile.records.push_back(std::move(record));
+    } else {
+      idx = it->second;
+    }
+    stack.push_back({idx, Clock::now(), getPeakRssKb()});
+  }
+
+  void end(Operation *op) {
+    Frame frame = stack.pop_back_val();
+    double elapsed =
+        std::chrono::duration<double, std::milli>(Clock::now() - frame.start)
+            .count();
+    PassRecord &record = profile.records[frame.recordIdx];
+    int64_t rssAfter = getPeakRssKb();
+    record.wallMs += elapsed;
+    record.peakRssKb = std::max(record.peakRssKb, rssAfter);
+    record.rssGrowthKb += rssAfter - frame.rssBefore;
+    // Op counts are sampled outside of the timed region.
+    if (op)
+      record.numOps += countOps(op);
+  }
+
+  KernelProfile &profile;
+  SmallVector<Frame> stack;
+  llvm::StringMap<size_t> recordIdxs;
+  unsigned topLevelChildren = 0;
+};
+
+/// Run the pipeline once on `file` and fill `profile`.
+LogicalResult profileKernel(const DialectRegistry &registry, StringRef file,
+                            KernelProfile &profile) {
+  std::string errorMessage;
+  auto input = openInputFile(file, &errorMessage);
+  if (!input) {
+    llvm::errs() << errorMessage << "\n";
+    return failure();
+  }
+  // Passes are timed sequentially, multithreading would make the per pass
+  // numbers meaningless.
+  MLIRContext context(registry, MLIRContext::Threading::DISABLED);
+  context.loadAllAvailableDialects();
+  llvm::SourceMgr sourceMgr;
+  sourceMgr.AddNewSourceBuffer(std::move(input), llvm::SMLoc());
+  OwningOpRef<ModuleOp> module = parseSourceFile<ModuleOp>(sourceMgr, &context);
+  if (!module)
+    return failure();
+
+  profile.file = llvm::sys::path::filename(file).str();
+  auto profiler = std::make_unique<CompileTimeProfiler>(profile);
+  CompileTimeProfiler *profilerPtr = profiler.get();
+  context.registerActionHandler(
+      [profilerPtr](function_ref<void()> transform,
+                    const tracing::Action &action) {
+        profilerPtr->handleAction(transform, action);
+      });
+
+  PassManager pm(&context);
+  pm.addInstrumentation(std::move(profiler));
+  triton::buildTritonToLinalgPipeline(pm);
+
+  auto start = Clock::now();
+  LogicalResult result = pm.run(module.get());
+  profile.totalMs =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  if (failed(result))
+    llvm::errs() << "pipeline failed on " << file << "\n";
+  return result;
+}
+
+/// Keep the fastest run of each record across repeated runs.
+void mergeProfile(KernelProfile &best, const KernelProfile &run) {
+  if (best.records.empty()) {
+    best = run;
+    return;
+  }
+  best.totalMs = std::min(best.totalMs, run.totalMs);
+  for (auto [bestRecord, record] : llvm::zip(best.records, run.records)) {
+    bestRecord.wallMs = std::min(bestRecord.wallMs, record.wallMs);
+    bestRecord.peakRssKb = std::max(bestRecord.peakRssKb, record.peakRssKb);
+    bestRecord.rssGrowthKb =
+        std::max(bestRecord.rssGrowthKb, record.rssGrowthKb);
+  }
+}
+
+void printProfile(const KernelProfile &profile, raw_ostream &os) {
+  os << "===" << std::string(73, '-') << "===\n";
+  os << "  " << profile.file << "  (total "
+     << llvm::format("%.3f", profile.totalMs) << " ms)\n";
+  os << "===" << std::string(73, '-') << "===\n";
+  os << llvm::format("  %10s  %12s  %10s  %8s  %s\n", "wall(ms)",
+                     "peak-rss(kb)", "growth(kb)", "ops", "pass");
+  for (const PassRecord &record : profile.records) {
+    os << llvm::format("  %10.3f  %12lld  %10lld  %8lld  ", record.wallMs,
+                       (long long)record.peakRssKb,
+                       (long long)record.rssGrowthKb, (long long)record.numOps)
+       << std::string(2 * record.depth, ' ') << record.name << "\n";
+  }
+  os << "\n";
+}
+
+llvm::json::Value toJSON(ArrayRef<KernelProfile> profiles) {
+  llvm::json::Array kernels;
+  for (const KernelProfile &profile : profiles) {
+    llvm::json::Array passes;
+    for (const PassRecord &record : profile.records) {
+      passes.push_back(llvm::json::Object{{"key", record.key},
+                                          {"wall_ms", record.wallMs},
+                                          {"peak_rss_kb", record.peakRssKb},
+                                          {"rss_growth_kb", record.rssGrowthKb},
+                                          {"ops", record.numOps}});
+    }
+    kernels.push_back(llvm::json::Object{{"file", profile.file},
+                                         {"total_ms", profile.totalMs},
+                                         {"passes", std::move(passes)}});
+  }
+  return llvm::json::Object{{"kernels", std::move(kernels)}};
+}
+
+bool isRegression(double baseMs, double curMs) {
+  return curMs - baseMs > minTimeMs &&
+         curMs > baseMs * (1.0 + threshold / 100.0);
+}
+
+/// Compare `profiles` against the baseline report, return failure if any
+/// kernel or pass regressed.
+LogicalResult checkBaseline(ArrayRef<KernelProfile> profiles) {
+  auto buffer = llvm::MemoryBuffer::getFile(baselineFilename);
+  if (!buffer) {
+    llvm::errs() << "cannot open baseline " << baselineFilename << "\n";
+    return failure();
+  }
+  auto parsed = llvm::json::parse((*buffer)->getBuffer());
+  if (!parsed) {
+    llvm::errs() << "invalid baseline: " << llvm::toString(parsed.takeError())
+                 << "\n";
+    return failure();
+  }
+  llvm::StringMap<double> baseKernels;
+  llvm::StringMap<double> basePasses;
+  if (auto *root = parsed->getAsObject()) {
+    if (auto *kernels = root->getArray("kernels")) {
+      for (auto &kernel : *kernels) {
+        auto *obj = kernel.getAsObject();
+        if (!obj)
+          continue;
+        auto file = obj->getString("file");
+        if (!file)
+          continue;
+        if (auto total = obj->getNumber("total_ms"))
+          baseKernels[*file] = *total;
+        if (auto *passes = obj->getArray("passes")) {
+          for (auto &pass : *passes) {
+            auto *passObj = pass.getAsObject();
+            if (!passObj)
+              continue;
+            auto key = passObj->getString("key");
+            auto wall = passObj->getNumber("wall_ms");
+            if (key && wall)
+              basePasses[(*file + "|" + *key).str()] = *wall;
+          }
+        }
+      }
+    }
+  }
+
+  bool regressed = false;
+  auto report = [&](StringRef what, double baseMs, double curMs) {
+    regressed = true;
+    llvm::errs() << "regression: " << what << ": "
+                 << llvm::format("%.3f", baseMs) << " ms -> "
+                 << llvm::format("%.3f", curMs) << " ms ("
+                 << llvm::format("%+.1f", (curMs / baseMs - 1.0) * 100.0)
+                 << "%)\n";
+  };
+  for (const KernelProfile &profile : profiles) {
+    auto kernelIt = baseKernels.find(profile.file);
+    if (kernelIt == baseKernels.end())
+      continue;
+    if (isRegression(kernelIt->second, profile.totalMs))
+      report(profile.file, kernelIt->second, profile.totalMs);
+    for (const PassRecord &record : profile.records) {
+      auto passIt = basePasses.find(profile.file + "|" + record.key);
+      if (passIt != basePasses.end() &&
+          isRegression(passIt->second, record.wallMs))
+        report(profile.file + " " + record.key, passIt->second, record.wallMs);
+    }
+  }
+  return failure(regressed);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  llvm::InitLLVM y(argc, argv);
+  llvm::cl::ParseCommandLineOptions(argc, argv,
+                                    "Triton-Linalg compile time benchmark\n");
+
+  ::mlir::DialectRegistry registry;
+  ::mlir::registerAllDialects(registry);
+  ::mlir::registerAllExtensions(registry);
+  registerTritonLinalgDialects(registry);
+
+  SmallVector<KernelProfile> profiles;
+  for (const std::string &file : inputFilenames) {
+    KernelProfile best;
+    for (unsigned i = 0, e = std::max(1u, unsigned(repeat)); i < e; ++i) {
+      KernelProfile run;
+      if (failed(profileKernel(registry, file, run)))
+        return 1;
+      mergeProfile(best, run);
+    }
+    printProfile(best, llvm::outs());
+    profiles.push_back(std::move(best));
+  }
+
+  if (!outputFilename.empty()) {
+    std::string errorMessage;
+    auto output = openOutputFile(outputFilename, &errorMessage);
+    if (!output) {
+      llvm::errs() << errorMessage << "\n";
+      return 1;
+    }
+    output->os() << llvm::formatv("{0:2}", toJSON(profiles)) << "\n";
+    output->keep();
+  }
+
+  if (!baselineFilename.empty() && failed(checkBaseline(profiles)))
+    return 1;
+  return 0;
+}
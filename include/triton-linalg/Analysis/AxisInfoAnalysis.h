@@ -14,9 +14,13 @@
 #include "triton-linalg/Dialect/Triton/Interfaces/InferAxisInfoInterface.h"
 
 #include "mlir/Analysis/DataFlow/SparseAnalysis.h"
+#include "mlir/Analysis/DataFlowFramework.h"
+#include "mlir/IR/Action.h"
 #include "mlir/IR/Value.h"
 #include "mlir/Interfaces/ControlFlowInterfaces.h"
+#include "mlir/Pass/AnalysisManager.h"
 #include "llvm/ADT/ArrayRef.h"
+#include <memory>
 #include <type_traits>
 
 namespace mlir {
@@ -58,6 +62,53 @@ public:
   }
 };
 
+/// Action wrapping the DataFlowSolver run that computes axis info, so that
+/// tools can observe (e.g. time) it through an action handler.
+class AxisInfoSolverAction
+    : public tracing::ActionImpl<AxisInfoSolverAction> {
+public:
+  using Base = tracing::ActionImpl<AxisInfoSolverAction>;
+  AxisInfoSolverAction(ArrayRef<IRUnit> irUnits) : Base(irUnits) {}
+  static constexpr StringLiteral tag = "triton-linalg-axis-info-solver";
+  void print(raw_ostream &os) const override {
+    os << "AxisInfoSolverAction";
+  }
+};
+
+/// Axis info of all values nested under an operation, in a form that can be
+/// cached by the pass analysis manager:
+///
+/// ```c++
+///   auto &axisInfo = getAnalysis<AxisInfoSolverAnalysis>();
+///   const AxisInfoExt *info = axisInfo.lookup(value);
+/// ```
+///
+/// The DataFlowSolver (dead code, sparse constant propagation and axis info
+/// analysis) is run once on construction, and is invalidated by any pass
+/// which does not mark it preserved.
+class AxisInfoSolverAnalysis {
+public:
+  AxisInfoSolverAnalysis(Operation *op);
+
+  /// Whether the solver converged. Lattices are meaningless otherwise.
+  LogicalResult getStatus() const { return status; }
+
+  /// Returns the solver, to be passed to the patterns querying
+  /// `AxisInfoLattice` states.
+  DataFlowSolver &getSolver() { return *solver; }
+
+  /// Returns the axis info of `value`, or nullptr if it was not computed.
+  const AxisInfoExt *lookup(Value value) const;
+
+  bool isInvalidated(const AnalysisManager::PreservedAnalyses &pa) {
+    return !pa.isPreserved<AxisInfoSolverAnalysis>();
+  }
+
+private:
+  std::unique_ptr<DataFlowSolver> solver;
+  LogicalResult status = success();
+};
+
 } // namespace triton
 } // namespace mlir
 
@@ -11,11 +11,12 @@ namespace mlir {
 class DataFlowSolver;
 class RewritePatternSet;
 namespace triton {
+class LoweringStatistics;
 class TritonLinalgTypeConverter;
 
 void populateTritonAtomicRmwToLinalgPatterns(
     RewritePatternSet &patterns, TritonLinalgTypeConverter &converter,
-    mlir::DataFlowSolver &solver);
+    mlir::DataFlowSolver &solver, LoweringStatistics *statistics = nullptr);
 
 } // namespace triton
 } // namespace mlir
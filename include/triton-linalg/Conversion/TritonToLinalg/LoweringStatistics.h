@@ -0,0 +1,76 @@
+//===- LoweringStatistics.h - Memory access lowering statistics -*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TRITON_LINALG_CONVERSION_TRITONTOLINALG_LOWERINGSTATISTICS_H
+#define TRITON_LINALG_CONVERSION_TRITONTOLINALG_LOWERINGSTATISTICS_H
+
+#include <optional>
+#include <string>
+
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/Location.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/Twine.h"
+
+namespace mlir {
+class Operation;
+namespace triton {
+
+/// The lowering a memory access op (load, store or atomic) takes.
+enum class MemAccessLowering : unsigned {
+  Contiguous = 0,
+  Scalar,
+  Scattered,
+  TensorPointer,
+};
+constexpr unsigned kNumMemAccessLowerings = 4;
+
+/// Collect the lowering taken by each memory access op per function, and why
+/// the contiguous lowering is missed by the ops falling back to the scattered
+/// one. This is what tells which kernels are worth rewriting.
+///
+/// The dialect conversion may roll back a pattern and lower the op again, so
+/// only the last lowering recorded for each op is kept, and the statistics are
+/// only meaningful once the conversion succeeds.
+class LoweringStatistics {
+public:
+  /// Record that the contiguous lowering of `op` fails because of `reason`.
+  void recordMissed(Operation *op, const Twine &reason);
+
+  /// Record that `op` is lowered by `kind`, replacing any lowering recorded
+  /// for `op` before. The missed reason recorded for `op` is kept if it falls
+  /// back to the scattered lowering.
+  void recordLowering(Operation *op, MemAccessLowering kind);
+
+  unsigned getNumLowerings(MemAccessLowering kind) const;
+  unsigned getNumMissed() const;
+
+  /// Emit a remark on each op missing the contiguous lowering, and a remark
+  /// summarizing the lowerings on each function.
+  void emitRemarks() const;
+
+private:
+  struct OpLowering {
+    MemAccessLowering kind = MemAccessLowering::Contiguous;
+    LocationAttr loc;
+    StringAttr funcName;
+    LocationAttr funcLoc;
+    /// Why the contiguous lowering is missed, if lowered to the scattered one.
+    std::optional<std::string> missedReason;
+  };
+
+  /// Reasons of the contiguous lowering failures of each op.
+  llvm::DenseMap<Operation *, std::string> missedReasons;
+  /// The last lowering recorded for each op, in order of the first record.
+  /// The ops are only used as keys, as they are erased by the conversion.
+  llvm::MapVector<Operation *, OpLowering> lowerings;
+};
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_LINALG_CONVERSION_TRITONTOLINALG_LOWERINGSTATISTICS_H
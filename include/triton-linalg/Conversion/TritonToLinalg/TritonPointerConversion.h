@@ -10,6 +10,8 @@
 #include <stdint.h>
 #include <utility>
 
+#include "triton-linalg/Conversion/TritonToLinalg/LoweringStatistics.h"
+#include "triton-linalg/Conversion/TritonToLinalg/Utils.h"
 #include "mlir/Dialect/Utils/IndexingUtils.h"
 #include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/BuiltinTypes.h"
@@ -21,6 +23,7 @@
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Twine.h"
 
 namespace mlir {
 class ConversionPatternRewriter;
@@ -115,6 +118,12 @@ Value reshapeGatherScatterValueTo(Value value, RankedTensorType resultTy,
 Value selectByMask(Location loc, Value mask, Value trueVal, Value falseVal,
                    ConversionPatternRewriter &rewriter);
 
+/// Check whether the offsets of `ptr` are computed element by element from a
+/// tensor of integers loaded from memory, as for the indirect accesses of
+/// embedding lookups, histograms and sparse kernels, whose indices are
+/// usually random and repeated. Scalars loaded from memory do not count.
+bool hasLoadedOffsets(Value ptr);
+
 /// This class represents additional information bound to dimensions.
 /// It contains two members, one is 'contigSize' and the other is
 /// 'broadcastSize', which represent the length of continuity or broadcast
@@ -165,6 +174,17 @@ private:
 
 class TritonPtrConversionBase {
 protected:
+  TritonPtrConversionBase(LoweringStatistics *statistics = nullptr)
+      : statistics{statistics} {}
+
+  /// Record that `op` is lowered by `kind` if statistics are collected.
+  void recordLowering(Operation *op, MemAccessLowering kind) const;
+
+  /// Record that the contiguous lowering of `op` fails because of `reason` if
+  /// statistics are collected. Always return failure.
+  LogicalResult notifyContiguousMissed(Operation *op,
+                                       const Twine &reason) const;
+
   /// Retrieve the corresponding memref based on baseptr, offsets, strides, and
   /// sizes, where permutations indicate that a transpose operation is required
   /// before obtaining the memref. As this pertains to memref, it's sufficient
@@ -175,7 +195,7 @@ protected:
                   ArrayRef<OpFoldResult> sizes, ArrayRef<OpFoldResult> strides,
                   ArrayRef<int64_t> permutations, ArrayRef<DimInfo> dimInfos,
                   Type elementType, ConversionPatternRewriter &rewriter,
-                  StringAttr cacheMode = nullptr) const;
+                  const MemoryHints &hints = {}) const;
 
   /// Retrieve the corresponding memref based on baseptr, offset, strides and
   /// sizes.
@@ -183,7 +203,7 @@ protected:
                   ArrayRef<OpFoldResult> sizes, ArrayRef<OpFoldResult> strides,
                   ArrayRef<int64_t> permutations, ArrayRef<DimInfo> dimInfos,
                   Type elementType, ConversionPatternRewriter &rewriter,
-                  StringAttr cacheMode = nullptr) const;
+                  const MemoryHints &hints = {}) const;
 
 public:
   /// Based on the permutations and dimInfos information, insert
@@ -201,6 +221,9 @@ public:
       Value value, ArrayRef<int64_t> permutations, ArrayRef<DimInfo> dimInfos,
       ArrayRef<OpFoldResult> offsets,
       ConversionPatternRewriter &rewriter) const;
+
+private:
+  LoweringStatistics *statistics;
 };
 
 /// Transform the values according to the rules based on the permutations.
@@ -263,8 +286,9 @@ public:
   };
 
 protected:
-  TritonPtrLoadStoreOpConversionBase(mlir::DataFlowSolver &solver)
-      : solver{solver} {}
+  TritonPtrLoadStoreOpConversionBase(mlir::DataFlowSolver &solver,
+                                     LoweringStatistics *statistics = nullptr)
+      : TritonPtrConversionBase(statistics), solver{solver} {}
 
   SmallVector<DimInfo> getDimInfos(const triton::AxisInfoExt *axisInfo,
                                    ArrayRef<int64_t> tensorShape) const;
@@ -300,9 +324,9 @@ protected:
                       ConversionPatternRewriter &rewriter) const;
 
   FailureOr<PtrInfo>
-  getPtrInfo(Location loc, Value ptr, Value mask, RankedTensorType tensorType,
+  getPtrInfo(Operation *op, Value ptr, Value mask, RankedTensorType tensorType,
              ConversionPatternRewriter &rewriter,
-             StringAttr cacheMode = nullptr,
+             const MemoryHints &hints = {},
              bool allowMaskTrackerFailureIgnore = false) const;
 };
 
@@ -313,7 +337,7 @@ class TritonPtrScalarConversionBase
 protected:
   Value getMemRef(Location loc, Value ptr, Type elementType,
                   ConversionPatternRewriter &rewriter,
-                  StringAttr cacheMode = nullptr) const;
+                  const MemoryHints &hints = {}) const;
 };
 
 class TritonPtrScatterConversionBase
@@ -327,22 +351,81 @@ protected:
   /// ```
   Value getDynamicMemRef(Location loc, Value ptr, RankedTensorType tensorType,
                          ConversionPatternRewriter &rewriter,
-                         StringAttr cacheMode = nullptr) const;
+                         const MemoryHints &hints = {}) const;
+
+  /// Return true if the pointers are not a block but each row of them is
+  /// contiguous along the last dim, and the mask if exists is constant along
+  /// the last dim, such as `base + idx[:, None] * stride + arange(0, N)[None,
+  /// :]`. Such an access gathers/scatters one window of a row per index.
+  bool isRowContiguous(Value ptr, Value mask,
+                       ArrayRef<int64_t> tensorShape) const;
+
+  /// Return true if the pointers are provably pairwise distinct, i.e. they are
+  /// affine in the tensor indices with positive constant strides, such as
+  /// `base + arange(0, M)[:, None] * 2 * N + arange(0, N)[None, :] * 2`, and
+  /// the strides sorted ascending each exceed the span of the smaller ones.
+  /// The windows of a scatter through such pointers never overlap, so its
+  /// batches can be computed in parallel.
+  bool hasUniqueOffsets(Value ptr, ArrayRef<int64_t> tensorShape) const;
+
+  /// Return true if some pointers are provably repeated, i.e. the pointers
+  /// are constant along runs of more than one element of a dim, such as
+  /// `base + arange(0, N) // K`.
+  bool hasRepeatedOffsets(Value ptr, ArrayRef<int64_t> tensorShape) const;
 };
 
 class TritonTensorPtrLoadStoreOpConversionBase
     : public TritonPtrConversionBase {
 protected:
+  using TritonPtrConversionBase::TritonPtrConversionBase;
+
+  /// Get the offset of the first in-bounds element of each dim of the block,
+  /// if boundaryCheck is true, return min(tensorShape[dim], max(0,
+  /// -offset[dim])), and 0 otherwise.
+  SmallVector<OpFoldResult>
+  getPadOffsets(Location loc, std::optional<ArrayRef<int>> boundaryCheck,
+                ArrayRef<int64_t> tensorShape,
+                const TensorPointerMetaInfoTracker &tracker,
+                ConversionPatternRewriter &rewriter) const;
+
   /// Get the actual size of each dim needed to be load, if boundaryCheck is
-  /// true, return min(tensorShape[dim], dimSize[dim] - offset[dim]).
+  /// true, return max(0, min(tensorShape[dim], dimSize[dim] - offset[dim]) -
+  /// padOffsets[dim]).
   SmallVector<OpFoldResult>
   getActualSizes(Location loc, std::optional<ArrayRef<int>> boundaryCheck,
                  ArrayRef<int64_t> tensorShape,
                  const TensorPointerMetaInfoTracker &tracker,
+                 ArrayRef<OpFoldResult> padOffsets,
                  ConversionPatternRewriter &rewriter) const;
 
   SmallVector<DimInfo> getDimInfos(ArrayRef<OpFoldResult> strides,
                                    ArrayRef<int64_t> tensorShape) const;
+
+  /// Get the memref of the in-bounds part of the block accessed by `op`
+  /// through a block pointer, which starts at `padOffsets` in the block.
+  /// If every dim of the block is boundary-checked, a single aux.view spans
+  /// the whole tensor described by the root tt.make_tensor_ptr. It is created
+  /// above the outermost loop in which the base, shape and strides are
+  /// invariant, and the block is a memref.subview of it with the actual
+  /// `sizes`, so loop-carried offsets only feed the subview:
+  /// ```mlir
+  ///   %view = aux.view %ptr to offset: [0], sizes: [%dim0, %dim1],
+  ///                            strides: [%stride0, %stride1]
+  ///   scf.for ... iter_args(%off = ...) {
+  ///     %block = memref.subview %view[%off, 0] [%size0, 16] [1, 1]
+  ///   }
+  /// ```
+  /// Otherwise the block may lie partly outside of the tensor, and it is
+  /// viewed at its exact offsets.
+  Value getBlockMemRef(Operation *op,
+                       const TensorPointerMetaInfoTracker &tracker,
+                       std::optional<ArrayRef<int>> boundaryCheck,
+                       ArrayRef<OpFoldResult> padOffsets,
+                       ArrayRef<OpFoldResult> sizes,
+                       ArrayRef<int64_t> permutations,
+                       ArrayRef<DimInfo> dimInfos, Type elementType,
+                       ConversionPatternRewriter &rewriter,
+                       const MemoryHints &hints = {}) const;
 };
 
 } // namespace triton
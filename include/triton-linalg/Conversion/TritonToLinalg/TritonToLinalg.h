@@ -15,16 +15,28 @@ class RewritePatternSet;
 class ConversionTarget;
 class DataFlowSolver;
 namespace triton {
+class LoweringStatistics;
 class TritonLinalgTypeConverter;
 
+/// Populate the patterns converting Triton to Linalg. If `statistics` is
+/// given, the lowerings of the memory access ops are recorded into it.
 void populateAllTritonToLinalgPattern(RewritePatternSet &patterns,
                                       TritonLinalgTypeConverter &converter,
                                       ConversionTarget &target,
-                                      mlir::DataFlowSolver &solver);
+                                      mlir::DataFlowSolver &solver,
+                                      LoweringStatistics *statistics = nullptr);
 
 /// Create a pass to convert a subset of Triton ops to Linalg.
 std::unique_ptr<mlir::Pass> createTritonToLinalgPass();
 
+/// Create a pass to convert triton functions, calls and returns to the func
+/// dialect, leaving the function bodies to `createTritonToLinalgFuncPass`.
+std::unique_ptr<mlir::Pass> createTritonFuncToFuncPass();
+
+/// Create a pass to convert a subset of Triton ops to Linalg within a
+/// func.func.
+std::unique_ptr<mlir::Pass> createTritonToLinalgFuncPass();
+
 } // namespace triton
 } // namespace mlir
 
@@ -7,6 +7,7 @@
 #ifndef TRITON_LINALG_CONVERSION_TRITONTOLINALG_UTILS_H
 #define TRITON_LINALG_CONVERSION_TRITONTOLINALG_UTILS_H
 
+#include "triton-linalg/Dialect/Utils/Conventions.h"
 #include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/Location.h"
 #include "mlir/IR/Types.h"
@@ -18,8 +19,12 @@ class Value;
 class OpFoldResult;
 class OpBuilder;
 class MLIRContext;
+class Operation;
 namespace triton {
 enum class CacheModifier : uint32_t;
+enum class EvictionPolicy : uint32_t;
+class LoadOp;
+class StoreOp;
 } // namespace triton
 } // namespace mlir
 
@@ -33,6 +38,24 @@ Value getPadOrInsertOpWithOther(Location loc, Value other, Type otherType,
                                 OpBuilder &rewriter);
 
 StringAttr getCacheModeAttr(MLIRContext *context, triton::CacheModifier mode);
+
+/// Get the evict mode attr of `policy`, nullptr for the normal policy.
+EvictModeAttr getEvictModeAttr(MLIRContext *context,
+                               triton::EvictionPolicy policy);
+
+/// Memory access hints of a triton load/store, which are carried onto the
+/// aux.view and linalg_ext ops accessing the same memory.
+struct MemoryHints {
+  StringAttr cacheMode;
+  EvictModeAttr evictMode;
+  bool isVolatile = false;
+};
+
+MemoryHints getMemoryHints(triton::LoadOp op);
+MemoryHints getMemoryHints(triton::StoreOp op);
+
+/// Attach the non-default `hints` to `op`.
+void setMemoryHints(Operation *op, const MemoryHints &hints);
 } // namespace triton
 } // namespace mlir
 #endif // TRITON_LINALG_CONVERSION_TRITONTOLINALG_UTILS_H
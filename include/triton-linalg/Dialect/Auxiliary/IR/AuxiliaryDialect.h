@@ -9,6 +9,7 @@
 #ifndef TRITON_DIALECT_AUXILIARY_IR_AUXILIARYDIALECT_H
 #define TRITON_DIALECT_AUXILIARY_IR_AUXILIARYDIALECT_H
 // IWYU pragma: begin_keep
+#include "triton-linalg/Dialect/Utils/Conventions.h"
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/IR/Attributes.h"
@@ -9,6 +9,7 @@
 
 // IWYU pragma: begin_keep
 #include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtInterface.h"
+#include "triton-linalg/Dialect/Utils/Conventions.h"
 #include "triton-linalg/Interfaces/InferResultTypeOpInterface.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/Linalg/IR/LinalgInterfaces.h"
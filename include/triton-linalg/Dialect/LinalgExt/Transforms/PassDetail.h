@@ -0,0 +1,63 @@
+//===- PassDetail.h - Details for linalg_ext transforms ---------*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TRITON_LINALG_DIALECT_LINALGEXT_TRANSFORMS_PASSDETAIL_H
+#define TRITON_LINALG_DIALECT_LINALGEXT_TRANSFORMS_PASSDETAIL_H
+// IWYU pragma: begin_keep
+#include "mlir/IR/DialectRegistry.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+class ModuleOp;
+
+// Forward declaration from Dialect.h
+template <typename ConcreteDialect>
+void registerDialect(DialectRegistry &registry);
+
+namespace func {
+class FuncOp;
+class FuncDialect;
+} // namespace func
+
+namespace affine {
+class AffineDialect;
+} // namespace affine
+
+namespace arith {
+class ArithDialect;
+} // namespace arith
+
+namespace linalg {
+class LinalgDialect;
+} // namespace linalg
+
+namespace math {
+class MathDialect;
+} // namespace math
+
+namespace scf {
+class SCFDialect;
+} // namespace scf
+
+namespace tensor {
+class TensorDialect;
+} // namespace tensor
+
+namespace vector {
+class VectorDialect;
+} // namespace vector
+
+namespace triton {
+namespace linalg_ext {
+// IWYU pragma: end_keep
+#define GEN_PASS_CLASSES
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h.inc"
+
+} // namespace linalg_ext
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_LINALG_DIALECT_LINALGEXT_TRANSFORMS_PASSDETAIL_H
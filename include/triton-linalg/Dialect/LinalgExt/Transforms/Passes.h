@@ -0,0 +1,55 @@
+//===- Passes.h - Passes for linalg_ext -------------------------*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TRITON_LINALG_DIALECT_LINALGEXT_TRANSFORMS_PASSES_H
+#define TRITON_LINALG_DIALECT_LINALGEXT_TRANSFORMS_PASSES_H
+
+#include "triton-linalg/Dialect/LinalgExt/Transforms/PassDetail.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Pass/PassRegistry.h"
+
+namespace mlir {
+namespace triton {
+namespace linalg_ext {
+
+/// Create a pass to decompose linalg_ext.scan into a blocked parallel prefix.
+std::unique_ptr<Pass> createDecomposeScanPass();
+
+/// Create a pass to fuse softmax and layernorm row chains.
+std::unique_ptr<Pass> createFuseRowNormalizationPass();
+
+/// Create a pass to capture the splat operands of linalg ops as scalars.
+std::unique_ptr<Pass> createFoldSplatOperandsPass();
+
+/// Create a pass to fuse producer-consumer elementwise linalg ops.
+std::unique_ptr<Pass> createFuseElementwisePass();
+
+/// Create a pass to sort and deduplicate the indices of marked gathers.
+std::unique_ptr<Pass> createSortGatherIndicesPass();
+
+/// Create a pass to combine the batches of equal indices of marked atomics.
+std::unique_ptr<Pass> createCombineAtomicRMWPass();
+
+/// Create a pass to lower batch convolutions to tiled im2col and batch matmul.
+std::unique_ptr<Pass> createConvToIm2ColMatmulPass();
+
+/// Create a pass to reuse dead tensors as the inits of linalg ops.
+std::unique_ptr<Pass> createReuseTensorInitsPass();
+
+/// Create a pass to lower linalg_ext.libdevice_call to CPU implementations.
+std::unique_ptr<Pass> createLowerLibdeviceCallPass();
+
+/// Create a pass to pick and apply the tile sizes of linalg and linalg_ext ops.
+std::unique_ptr<Pass> createTuneTileSizesPass();
+
+#define GEN_PASS_REGISTRATION
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h.inc"
+
+} // namespace linalg_ext
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_LINALG_DIALECT_LINALGEXT_TRANSFORMS_PASSES_H
@@ -35,6 +35,8 @@ public:
   ArrayRef<OpFoldResult> getStrides() const { return strides; }
   ArrayRef<OpFoldResult> getOffsets() const { return offsets; }
   ArrayRef<int32_t> getOrder() const { return order; }
+  /// Return the root MakeTensorPtrOp of the traced block pointer.
+  triton::MakeTensorPtrOp getMakeTensorPtrOp() const { return makeTensorPtr; }
 
   LogicalResult parse(Value operand, Location loc,
                       ConversionPatternRewriter &rewriter);
@@ -49,6 +51,7 @@ private:
   SmallVector<OpFoldResult> strides;
   SmallVector<OpFoldResult> offsets;
   ArrayRef<int32_t> order;
+  triton::MakeTensorPtrOp makeTensorPtr;
 };
 
 /// Data structure used to extract the normal pointer used for load and store.
@@ -7,10 +7,19 @@
 #ifndef TRITON_LINALG_DIALECT_UTILS_CONVENTIONS_H
 #define TRITON_LINALG_DIALECT_UTILS_CONVENTIONS_H
 #include "mlir/IR/Attributes.h"
+#include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/OpImplementation.h" // IWYU pragma: keep
+#include "mlir/Support/LogicalResult.h"
 #include "llvm/ADT/StringRef.h"
 #include <stdint.h>
 
+//===----------------------------------------------------------------------===//
+// Memory Access Hint Enum Attributes
+//===----------------------------------------------------------------------===//
+
+#include "triton-linalg/Dialect/Utils/MemoryHintsEnums.h.inc"
+
 namespace mlir {
 class Operation;
 namespace scf {
@@ -32,6 +41,26 @@ constexpr llvm::StringLiteral getIsLinearMemoryAttrKey() {
 
 /// Determine whether the current module is running in linear memory space.
 bool isLinearMemory(::mlir::ModuleOp op);
+
+/// Return the keys of the memory access hints carried by aux.view and the
+/// linalg_ext ops which access memory.
+constexpr llvm::StringLiteral getCacheModeAttrKey() {
+  return llvm::StringLiteral("cache_mode");
+}
+constexpr llvm::StringLiteral getEvictModeAttrKey() {
+  return llvm::StringLiteral("evict_mode");
+}
+constexpr llvm::StringLiteral getIsVolatileAttrKey() {
+  return llvm::StringLiteral("is_volatile");
+}
+
+/// Verify the memory access hints of `op`, the cache mode should be one of
+/// "cmnormal" and "cmtransient". The evict mode is an `EvictModeAttr`, which is
+/// checked by the op verifiers.
+LogicalResult verifyMemoryHints(Operation *op);
+
+/// Copy the memory access hints of `from` to `to`.
+void copyMemoryHints(Operation *from, Operation *to);
 } // namespace triton
 } // namespace mlir
 
@@ -6,9 +6,33 @@
 #ifndef TRITON_LINALG_PIPELINE_PIPELINES_H
 #define TRITON_LINALG_PIPELINE_PIPELINES_H
 
+#include "mlir/Pass/PassOptions.h"
+#include "llvm/Support/CommandLine.h"
+
 namespace mlir {
+class OpPassManager;
 namespace triton {
 
+/// Options of the triton-to-linalg pipeline.
+struct TritonToLinalgPipelineOptions
+    : public PassPipelineOptions<TritonToLinalgPipelineOptions> {
+  PassOptions::Option<bool> sortGatherIndices{
+      *this, "sort-gather-indices",
+      llvm::cl::desc("Load the batches of the gathers of loaded offsets in "
+                     "index order, with O(n^2) compares of the n batches"),
+      llvm::cl::init(false)};
+  PassOptions::Option<bool> combineAtomicRMW{
+      *this, "combine-atomic-rmw",
+      llvm::cl::desc("Issue a single atomic per distinct index of the atomics "
+                     "of loaded or repeated offsets, with O(n^2 * w) work "
+                     "for n batches of w elements"),
+      llvm::cl::init(false)};
+};
+
+/// Populate `pm` with the passes lowering triton ir to linalg.
+void buildTritonToLinalgPipeline(
+    OpPassManager &pm, const TritonToLinalgPipelineOptions &options = {});
+
 void registerTritonLinalgPipelines();
 
 } // namespace triton
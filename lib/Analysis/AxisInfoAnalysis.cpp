@@ -16,12 +16,17 @@
 #include <optional>
 #include <stdint.h>
 
+#include "mlir/Analysis/DataFlow/ConstantPropagationAnalysis.h"
+#include "mlir/Analysis/DataFlow/DeadCodeAnalysis.h"
 #include "mlir/Analysis/DataFlow/SparseAnalysis.h"
+#include "mlir/Analysis/DataFlowFramework.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/IR/BuiltinAttributeInterfaces.h"
 #include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/MLIRContext.h"
 #include "mlir/IR/Operation.h"
 #include "mlir/IR/Types.h"
 #include "mlir/IR/Value.h"
@@ -62,6 +67,18 @@ void AxisInfoAnalysisExt::visitOperation(
     ArrayRef<AxisInfoLattice *> results) {
   LLVM_DEBUG(llvm::dbgs() << "Inferring axis info for " << *op << "\n");
 
+  // The casts bridging converted function arguments back to triton pointers
+  // (e.g. i64 to !tt.ptr<f32>) keep the axis info of their source.
+  if (auto castOp = dyn_cast<UnrealizedConversionCastOp>(op)) {
+    if (operands.size() != 1 || results.size() != 1 ||
+        operands[0]->getValue().getRank() !=
+            AxisInfoExt::getPessimisticValueState(op->getResult(0))
+                .getRank())
+      return setAllToEntryStates(results);
+    return propagateIfChanged(results[0],
+                              results[0]->join(operands[0]->getValue()));
+  }
+
   auto inferrable = dyn_cast<InferAxisInfoInterface>(op);
   if (!inferrable) {
     return setAllToEntryStates(results);
@@ -138,3 +155,23 @@ void AxisInfoAnalysisExt::visitNonControlFlowArguments(
   return SparseForwardDataFlowAnalysis::visitNonControlFlowArguments(
       op, successor, argLattices, firstIndex);
 }
+
+//===----------------------------------------------------------------------===//
+// AxisInfoSolverAnalysis
+//===----------------------------------------------------------------------===//
+
+AxisInfoSolverAnalysis::AxisInfoSolverAnalysis(Operation *op)
+    : solver(std::make_unique<DataFlowSolver>()) {
+  solver->load<dataflow::DeadCodeAnalysis>();
+  solver->load<dataflow::SparseConstantPropagation>();
+  solver->load<AxisInfoAnalysisExt>();
+  op->getContext()->executeAction<AxisInfoSolverAction>(
+      [&] { status = solver->initializeAndRun(op); }, {op});
+}
+
+const AxisInfoExt *AxisInfoSolverAnalysis::lookup(Value value) const {
+  auto *lattice = solver->lookupState<AxisInfoLattice>(value);
+  if (!lattice || lattice->getValue().getRank() == 0)
+    return nullptr;
+  return &lattice->getValue();
+}
@@ -36,6 +36,7 @@
 #include "mlir/Transforms/DialectConversion.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/PointerUnion.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 
@@ -83,21 +84,26 @@ public:
       return failure();
 
     auto initDims = getDims(rewriter, loc, trueValue);
-    if (condition.getType().isSignlessInteger(1)) {
-      Value initCondition = rewriter.create<tensor::EmptyOp>(
-          loc, initDims, rewriter.getIntegerType(1));
-      condition = rewriter.create<linalg::FillOp>(loc, condition, initCondition)
-                      .getResult(0);
-    }
+    // A scalar condition is captured by the payload, rather than filled into
+    // a tensor read by the map.
+    bool isScalarCondition = condition.getType().isSignlessInteger(1);
+    SmallVector<Value> inputs;
+    if (!isScalarCondition)
+      inputs.push_back(condition);
+    inputs.append({trueValue, falseValue});
 
     auto resElementType = getElementTypeOrSelf(op.getType());
     Value initTensor =
         rewriter.create<tensor::EmptyOp>(loc, initDims, resElementType);
     auto mapOp = rewriter.create<linalg::MapOp>(
-        loc, ValueRange({condition, trueValue, falseValue}), initTensor,
+        loc, inputs, initTensor,
         [&](OpBuilder &b, Location loc, ValueRange args) {
-          Value innerResult = b.create<arith::SelectOp>(loc, resElementType,
-                                                        args, op->getAttrs());
+          SmallVector<Value> operands;
+          if (isScalarCondition)
+            operands.push_back(condition);
+          operands.append(args.begin(), args.end());
+          Value innerResult = b.create<arith::SelectOp>(
+              loc, resElementType, operands, op->getAttrs());
           b.create<linalg::YieldOp>(loc, innerResult);
         },
         linalg::getPrunedAttributeList(op));
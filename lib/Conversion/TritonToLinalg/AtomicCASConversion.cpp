@@ -7,6 +7,7 @@
 #include <optional>
 
 #include "triton-linalg/Conversion/TritonToLinalg/AtomicCASConversion.h"
+#include "triton-linalg/Conversion/TritonToLinalg/LoweringStatistics.h"
 #include "triton-linalg/Conversion/TritonToLinalg/TritonPointerConversion.h"
 #include "triton-linalg/Conversion/TritonToLinalg/TypeConverter.h"
 #include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtOps.h"
@@ -47,9 +48,10 @@ public:
   TritonScalarAtomicCASOpConversion(TritonLinalgTypeConverter &converter,
                                     MLIRContext *context,
                                     DataFlowSolver &solver,
-                                    PatternBenefit benefit)
+                                    PatternBenefit benefit,
+                                    LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<triton::AtomicCASOp>(converter, context, benefit),
-        TritonPtrScalarConversionBase(solver) {}
+        TritonPtrScalarConversionBase(solver, statistics) {}
 
   LogicalResult
   matchAndRewrite(triton::AtomicCASOp op, OpAdaptor adaptor,
@@ -91,6 +93,7 @@ public:
                                        ValueRange({zero}))
             .getResult();
     op.replaceAllUsesWith(scalarRet);
+    recordLowering(op, MemAccessLowering::Scalar);
     rewriter.eraseOp(op);
     return success();
   }
@@ -101,9 +104,10 @@ class TritonAtomicCASPattern : public OpConversionPattern<triton::AtomicCASOp>,
 public:
   TritonAtomicCASPattern(TritonLinalgTypeConverter &converter,
                          MLIRContext *context, DataFlowSolver &solver,
-                         PatternBenefit benefit = 1)
+                         PatternBenefit benefit = 1,
+                         LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<triton::AtomicCASOp>(converter, context, benefit),
-        TritonPtrContiguousConversionBase(solver) {}
+        TritonPtrContiguousConversionBase(solver, statistics) {}
 
   LogicalResult
   matchAndRewrite(triton::AtomicCASOp op, OpAdaptor adaptor,
@@ -115,16 +119,16 @@ public:
       return failure();
 
     auto loc = op.getLoc();
-    auto ptrInfo = getPtrInfo(loc, op.getPtr(), nullptr, resultTy, rewriter);
+    auto ptrInfo = getPtrInfo(op, op.getPtr(), nullptr, resultTy, rewriter);
     if (failed(ptrInfo))
       return failure();
     // Atomic does not support broadcast and permutations.
     for (auto dimInfo : ptrInfo->dimInfos) {
       if (dimInfo.getContigSize() != dimInfo.getDimSize())
-        return failure();
+        return notifyContiguousMissed(op, "pointer is broadcast on a dim");
     }
     if (!isConsecutive(ptrInfo->permutations)) {
-      return failure();
+      return notifyContiguousMissed(op, "pointer dims are permuted");
     }
 
     Value originTensor = rewriter.create<bufferization::ToTensorOp>(
@@ -138,6 +142,7 @@ public:
                 loc, op.getResult().getType(),
                 ValueRange({originTensor, op.getCmp(), op.getVal()}), init)
             .getResults()[0];
+    recordLowering(op, MemAccessLowering::Contiguous);
     rewriter.replaceOp(op, ret);
     return success();
   }
@@ -149,9 +154,10 @@ class TritonGatherAtomicCASPattern
 public:
   TritonGatherAtomicCASPattern(TritonLinalgTypeConverter &converter,
                                MLIRContext *context, DataFlowSolver &solver,
-                               PatternBenefit benefit = 1)
+                               PatternBenefit benefit = 1,
+                               LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<triton::AtomicCASOp>(converter, context, benefit),
-        TritonPtrScatterConversionBase(solver) {}
+        TritonPtrScatterConversionBase(solver, statistics) {}
 
   LogicalResult
   matchAndRewrite(triton::AtomicCASOp op, OpAdaptor adaptor,
@@ -173,6 +179,7 @@ public:
         rewriter.create<bufferization::ToTensorOp>(loc, memref, true, true);
     auto init = rewriter.create<tensor::EmptyOp>(loc, resultTy.getShape(),
                                                  resultTy.getElementType());
+    recordLowering(op, MemAccessLowering::Scattered);
     rewriter.replaceOpWithNewOp<triton::linalg_ext::GatherAtomicCASOp>(
         op, op.getResult().getType(),
         ValueRange(
@@ -186,10 +193,11 @@ public:
 
 void triton::populateTritonAtomicCASToLinalgPatterns(
     RewritePatternSet &patterns, TritonLinalgTypeConverter &converter,
-    DataFlowSolver &solver) {
+    DataFlowSolver &solver, LoweringStatistics *statistics) {
   MLIRContext *context = patterns.getContext();
   patterns.add<TritonScalarAtomicCASOpConversion, TritonAtomicCASPattern>(
-      converter, context, solver, 1);
+      converter, context, solver, 1, statistics);
   // Make gather/scatter pattern run at last.
-  patterns.add<TritonGatherAtomicCASPattern>(converter, context, solver, 0);
+  patterns.add<TritonGatherAtomicCASPattern>(converter, context, solver, 0,
+                                             statistics);
 }
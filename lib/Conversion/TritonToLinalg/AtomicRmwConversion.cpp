@@ -8,10 +8,13 @@
 #include <stdint.h>
 
 #include "triton-linalg/Conversion/TritonToLinalg/AtomicRmwConversion.h"
+#include "triton-linalg/Conversion/TritonToLinalg/LoweringStatistics.h"
 #include "triton-linalg/Conversion/TritonToLinalg/TritonPointerConversion.h"
 #include "triton-linalg/Conversion/TritonToLinalg/TypeConverter.h"
+#include "triton-linalg/Conversion/TritonToLinalg/Utils.h"
 #include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtOps.h"
 #include "triton-linalg/Dialect/Triton/Utils/PointerMetaInfoTracker.h"
+#include "triton-linalg/Dialect/Utils/ShapeUtils.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Bufferization/IR/Bufferization.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
@@ -86,10 +89,10 @@ public:
   TritonScalarAtomicRMWOpConversion(
       mlir::triton::TritonLinalgTypeConverter &converter,
       mlir::MLIRContext *context, mlir::DataFlowSolver &solver,
-      mlir::PatternBenefit benefit)
+      mlir::PatternBenefit benefit, LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<mlir::triton::AtomicRMWOp>(converter, context,
                                                        benefit),
-        TritonPtrScalarConversionBase(solver) {}
+        TritonPtrScalarConversionBase(solver, statistics) {}
 
   LogicalResult
   matchAndRewrite(triton::AtomicRMWOp op, OpAdaptor adaptor,
@@ -156,10 +159,79 @@ public:
     Value zeroConst = rewriter.create<arith::ConstantOp>(
         loc, rewriter.getIntegerAttr(op.getResult().getType(), 0));
     rewriter.create<scf::YieldOp>(loc, ValueRange(zeroConst));
+    recordLowering(op, MemAccessLowering::Scalar);
     rewriter.replaceOp(op, ifOp.getResult(0));
     return success();
   }
 };
+class TritonContiguousAtomicRMWOpConversion
+    : public OpConversionPattern<triton::AtomicRMWOp>,
+      public TritonPtrContiguousConversionBase {
+  using OpConversionPattern<triton::AtomicRMWOp>::OpConversionPattern;
+
+public:
+  TritonContiguousAtomicRMWOpConversion(
+      TritonLinalgTypeConverter &converter, MLIRContext *context,
+      DataFlowSolver &solver, PatternBenefit benefit,
+      LoweringStatistics *statistics = nullptr)
+      : OpConversionPattern<triton::AtomicRMWOp>(converter, context, benefit),
+        TritonPtrContiguousConversionBase(solver, statistics) {}
+
+  LogicalResult
+  matchAndRewrite(triton::AtomicRMWOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto resultTy = op.getResult().getType().dyn_cast<RankedTensorType>();
+    if (!resultTy)
+      return failure();
+
+    auto loc = op.getLoc();
+    auto ptrInfo =
+        getPtrInfo(op, op.getPtr(), op.getMask(), resultTy, rewriter);
+    if (failed(ptrInfo))
+      return failure();
+    // Atomic does not support broadcast and permutations.
+    for (auto dimInfo : ptrInfo->dimInfos) {
+      if (dimInfo.getContigSize() != dimInfo.getDimSize())
+        return notifyContiguousMissed(op, "pointer is broadcast on a dim");
+    }
+    if (!isConsecutive(ptrInfo->permutations))
+      return notifyContiguousMissed(op, "pointer dims are permuted");
+
+    Type resultEltType = resultTy.getElementType();
+    auto maybeKind = getAtomicRMWType(op.getAtomicRmwOp(), resultEltType);
+    if (!maybeKind)
+      return failure();
+
+    // The memref is the subview of the unmasked part, update the
+    // corresponding part of value only.
+    Value value = adaptor.getVal();
+    if (op.getMask()) {
+      value = rewriter.create<tensor::ExtractSliceOp>(
+          loc, value, ptrInfo->offsets, ptrInfo->sizes,
+          SmallVector<OpFoldResult>(resultTy.getRank(),
+                                    rewriter.getIndexAttr(1)));
+    }
+    Value originTensor = rewriter.create<bufferization::ToTensorOp>(
+        loc, ptrInfo->memref, true, true);
+    Value init =
+        rewriter.create<tensor::EmptyOp>(loc, ptrInfo->sizes, resultEltType);
+    Value ret = rewriter
+                    .create<linalg_ext::AtomicRMWOp>(
+                        loc, init.getType(), ValueRange{originTensor, value},
+                        init, *maybeKind)
+                    .getResults()[0];
+    // Masked off elements return 0, align with GPU behaviour.
+    if (op.getMask()) {
+      ret = getPadOrInsertOpWithOther(loc, Value(), resultTy, ret,
+                                      ptrInfo->offsets, ptrInfo->sizes,
+                                      rewriter);
+    }
+    recordLowering(op, MemAccessLowering::Contiguous);
+    rewriter.replaceOp(op, ret);
+    return success();
+  }
+};
+
 class TritonScatteredAtomicRMWOpConversion
     : public mlir::OpConversionPattern<mlir::triton::AtomicRMWOp>,
       public TritonPtrScatterConversionBase {
@@ -169,10 +241,10 @@ public:
   TritonScatteredAtomicRMWOpConversion(
       mlir::triton::TritonLinalgTypeConverter &converter,
       mlir::MLIRContext *context, mlir::DataFlowSolver &solver,
-      mlir::PatternBenefit benefit)
+      mlir::PatternBenefit benefit, LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<mlir::triton::AtomicRMWOp>(converter, context,
                                                        benefit),
-        TritonPtrScatterConversionBase(solver) {}
+        TritonPtrScatterConversionBase(solver, statistics) {}
 
   mlir::LogicalResult
   matchAndRewrite(mlir::triton::AtomicRMWOp op, OpAdaptor adaptor,
@@ -229,13 +301,16 @@ public:
       return failure();
 
     SmallVector<Value> atomicInits{originTensor, atomicResultInit};
-    Value out = rewriter
-                    .create<linalg_ext::GatherAtomicRMWOp>(
-                        loc, atomicInputs, atomicInits, *maybeKind)
-                    ->getResult(1);
+    auto atomicOp = rewriter.create<linalg_ext::GatherAtomicRMWOp>(
+        loc, atomicInputs, atomicInits, *maybeKind);
+    atomicOp.setCombineIndices(
+        hasLoadedOffsets(op.getPtr()) ||
+        hasRepeatedOffsets(op.getPtr(), resultTy.getShape()));
+    Value out = atomicOp->getResult(1);
 
     // Reshape output to origin shape.
     out = reshapeGatherScatterValueTo(out, resultTy, rewriter);
+    recordLowering(op, MemAccessLowering::Scattered);
     rewriter.replaceOp(op, out);
 
     return success();
@@ -244,9 +319,12 @@ public:
 
 void triton::populateTritonAtomicRmwToLinalgPatterns(
     RewritePatternSet &patterns, TritonLinalgTypeConverter &converter,
-    mlir::DataFlowSolver &solver) {
+    mlir::DataFlowSolver &solver, LoweringStatistics *statistics) {
   MLIRContext *context = patterns.getContext();
+  patterns.add<TritonContiguousAtomicRMWOpConversion>(converter, context,
+                                                      solver, 1, statistics);
+  // Make gather/scatter pattern run at last.
   patterns.add<TritonScalarAtomicRMWOpConversion,
                TritonScatteredAtomicRMWOpConversion>(converter, context, solver,
-                                                     0);
+                                                     0, statistics);
 }
@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include "triton-linalg/Conversion/TritonToLinalg/LoadStoreConversion.h"
+#include "triton-linalg/Conversion/TritonToLinalg/LoweringStatistics.h"
 #include "triton-linalg/Conversion/TritonToLinalg/TritonPointerConversion.h"
 #include "triton-linalg/Conversion/TritonToLinalg/TypeConverter.h"
 #include "triton-linalg/Conversion/TritonToLinalg/Utils.h"
@@ -25,6 +26,8 @@
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinAttributeInterfaces.h" // IWYU pragma: keep
 #include "mlir/IR/BuiltinAttributes.h"
@@ -68,9 +71,10 @@ class TritonContiguousLoadOpConversion
 public:
   TritonContiguousLoadOpConversion(TritonLinalgTypeConverter &converter,
                                    MLIRContext *context, DataFlowSolver &solver,
-                                   PatternBenefit benefit)
+                                   PatternBenefit benefit,
+                                   LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<triton::LoadOp>(converter, context, benefit),
-        TritonPtrContiguousConversionBase(solver) {}
+        TritonPtrContiguousConversionBase(solver, statistics) {}
 
   LogicalResult
   matchAndRewrite(triton::LoadOp op, OpAdaptor adaptor,
@@ -87,9 +91,8 @@ public:
     auto module = op->getParentOfType<ModuleOp>();
     bool allowMaskTrackFailureIgnore = isLinearMemory(module);
     auto ptrInfo =
-        getPtrInfo(loc, op.getPtr(), op.getMask(), resultTy, rewriter,
-                   getCacheModeAttr(op.getContext(), op.getCache()),
-                   allowMaskTrackFailureIgnore);
+        getPtrInfo(op, op.getPtr(), op.getMask(), resultTy, rewriter,
+                   getMemoryHints(op), allowMaskTrackFailureIgnore);
     if (failed(ptrInfo)) {
       return failure();
     }
@@ -106,6 +109,7 @@ public:
       sliceTensor = transformResultWithTransposeAndDimInfo(
           sliceTensor, ptrInfo->permutations, ptrInfo->dimInfos, ptrInfo->sizes,
           rewriter);
+      recordLowering(op, MemAccessLowering::Contiguous);
       rewriter.replaceOp(op, sliceTensor);
       return success();
     }
@@ -123,6 +127,7 @@ public:
       sliceTensor =
           selectByMask(loc, op.getMask(), sliceTensor, op.getOther(), rewriter);
     }
+    recordLowering(op, MemAccessLowering::Contiguous);
     rewriter.replaceOp(op, sliceTensor);
     return success();
   }
@@ -137,9 +142,10 @@ public:
   TritonContiguousStoreOpConversion(TritonLinalgTypeConverter &converter,
                                     MLIRContext *context,
                                     DataFlowSolver &solver,
-                                    PatternBenefit benefit)
+                                    PatternBenefit benefit,
+                                    LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<triton::StoreOp>(converter, context, benefit),
-        TritonPtrContiguousConversionBase(solver) {}
+        TritonPtrContiguousConversionBase(solver, statistics) {}
 
   LogicalResult
   matchAndRewrite(triton::StoreOp op, OpAdaptor adaptor,
@@ -154,8 +160,8 @@ public:
       return failure();
 
     auto loc = op.getLoc();
-    auto ptrInfo = getPtrInfo(loc, op.getPtr(), op.getMask(), valueTy, rewriter,
-                              getCacheModeAttr(op.getContext(), op.getCache()));
+    auto ptrInfo = getPtrInfo(op, op.getPtr(), op.getMask(), valueTy, rewriter,
+                              getMemoryHints(op));
     if (failed(ptrInfo))
       return failure();
 
@@ -179,6 +185,7 @@ public:
         rewriter.create<bufferization::MaterializeInDestinationOp>(
             op.getLoc(), value, ptrInfo->memref);
     materializeOp.setWritable(true);
+    recordLowering(op, MemAccessLowering::Contiguous);
     rewriter.eraseOp(op);
     return success();
   }
@@ -191,9 +198,10 @@ class TritonScalarLoadOpConversion : public OpConversionPattern<triton::LoadOp>,
 public:
   TritonScalarLoadOpConversion(TritonLinalgTypeConverter &converter,
                                MLIRContext *context, DataFlowSolver &solver,
-                               PatternBenefit benefit)
+                               PatternBenefit benefit,
+                               LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<triton::LoadOp>(converter, context, benefit),
-        TritonPtrScalarConversionBase(solver) {}
+        TritonPtrScalarConversionBase(solver, statistics) {}
 
   LogicalResult
   matchAndRewrite(triton::LoadOp op, OpAdaptor adaptor,
@@ -203,12 +211,13 @@ public:
 
     auto loc = op.getLoc();
     auto elementType = op.getResult().getType();
-    auto memref = getMemRef(loc, op.getPtr(), elementType, rewriter,
-                            getCacheModeAttr(op.getContext(), op.getCache()));
+    auto memref =
+        getMemRef(loc, op.getPtr(), elementType, rewriter, getMemoryHints(op));
     Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
     Value scalar =
         rewriter.create<memref::LoadOp>(loc, elementType, memref, c0);
     if (!op.getMask()) {
+      recordLowering(op, MemAccessLowering::Scalar);
       rewriter.replaceOp(op, scalar);
       return success();
     }
@@ -227,6 +236,7 @@ public:
             b.create<scf::YieldOp>(loc, other);
           }
         });
+    recordLowering(op, MemAccessLowering::Scalar);
     rewriter.replaceOp(op, ifOp.getResults());
     return success();
   }
@@ -240,9 +250,10 @@ class TritonScalarStoreOpConversion
 public:
   TritonScalarStoreOpConversion(TritonLinalgTypeConverter &converter,
                                 MLIRContext *context, DataFlowSolver &solver,
-                                PatternBenefit benefit)
+                                PatternBenefit benefit,
+                                LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<triton::StoreOp>(converter, context, benefit),
-        TritonPtrScalarConversionBase(solver) {}
+        TritonPtrScalarConversionBase(solver, statistics) {}
 
   LogicalResult
   matchAndRewrite(triton::StoreOp op, OpAdaptor adaptor,
@@ -252,10 +263,11 @@ public:
 
     auto loc = op.getLoc();
     auto memref = getMemRef(loc, op.getPtr(), op.getValue().getType(), rewriter,
-                            getCacheModeAttr(op.getContext(), op.getCache()));
+                            getMemoryHints(op));
 
     Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
     rewriter.create<memref::StoreOp>(loc, op.getValue(), memref, c0);
+    recordLowering(op, MemAccessLowering::Scalar);
     rewriter.eraseOp(op);
     return success();
   }
@@ -269,9 +281,10 @@ class TritonScatteredLoadOpConversion
 public:
   TritonScatteredLoadOpConversion(TritonLinalgTypeConverter &converter,
                                   MLIRContext *context, DataFlowSolver &solver,
-                                  PatternBenefit benefit)
+                                  PatternBenefit benefit,
+                                  LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<triton::LoadOp>(converter, context, benefit),
-        TritonPtrScatterConversionBase(solver) {}
+        TritonPtrScatterConversionBase(solver, statistics) {}
 
   LogicalResult
   matchAndRewrite(triton::LoadOp op, OpAdaptor adaptor,
@@ -288,10 +301,26 @@ public:
     PointerMetaInfoTracker tracker;
     if (failed(tracker.parse(op.getPtr(), loc, rewriter)))
       return failure();
-    Value memref = getDynamicMemRef(loc, tracker.getBase(), resultTy, rewriter);
+    auto hints = getMemoryHints(op);
+    Value memref =
+        getDynamicMemRef(loc, tracker.getBase(), resultTy, rewriter, hints);
     Value originTensor =
         rewriter.create<bufferization::ToTensorOp>(loc, memref, true, true);
 
+    // If the mask is a rectangular region, only gather the region and pad the
+    // border with other, rather than a masked gather into the whole window.
+    if (mask && resultTy.getRank() > 0) {
+      MaskTracker maskTracker;
+      maskTracker.parse(mask, loc, rewriter);
+      if (!maskTracker.hasFailedDim()) {
+        Value ret = gatherMaskedRegion(op, originTensor, tracker.getOffset(),
+                                       maskTracker, rewriter);
+        recordLowering(op, MemAccessLowering::Scattered);
+        rewriter.replaceOp(op, ret);
+        return success();
+      }
+    }
+
     // Get window.
     auto window = op.getOther();
     if (!window) {
@@ -314,20 +343,77 @@ public:
     }
 
     // Do gather operation.
-    Value gatherRes = rewriter
-                          .create<linalg_ext::GatherOp>(
-                              loc, gatherInputs, window,
-                              /*dimensionMap=*/SmallVector<int64_t>({0}),
-                              /*rangedData=*/false,
-                              [](OpBuilder &b, Location loc, ValueRange args) {
-                                b.create<linalg_ext::ExtYieldOp>(loc, args[0]);
-                              })
-                          .getResult()[0];
+    auto gatherOp = rewriter.create<linalg_ext::GatherOp>(
+        loc, gatherInputs, window,
+        /*dimensionMap=*/SmallVector<int64_t>({0}),
+        /*rangedData=*/false, [](OpBuilder &b, Location loc, ValueRange args) {
+          b.create<linalg_ext::ExtYieldOp>(loc, args[0]);
+        });
+    setMemoryHints(gatherOp, hints);
+    gatherOp.setSortIndices(hasLoadedOffsets(op.getPtr()));
+    Value gatherRes = gatherOp.getResult()[0];
     gatherRes = reshapeGatherScatterValueTo(gatherRes, resultTy, rewriter);
+    recordLowering(op, MemAccessLowering::Scattered);
     rewriter.replaceOp(op, gatherRes.getDefiningOp()->getResults());
 
     return success();
   }
+
+private:
+  /// Gather the in-bound region proved by `maskTracker` without mask, then
+  /// pad the out-of-bound border with other.
+  Value gatherMaskedRegion(triton::LoadOp op, Value originTensor, Value offset,
+                           const MaskTracker &maskTracker,
+                           ConversionPatternRewriter &rewriter) const {
+    auto loc = op.getLoc();
+    auto resultTy = op.getResult().getType().cast<RankedTensorType>();
+    Type elementTy = resultTy.getElementType();
+    int64_t rank = resultTy.getRank();
+    SmallVector<OpFoldResult> offsets =
+        getMaskedOffsets(rank, maskTracker, rewriter);
+    SmallVector<OpFoldResult> sizes =
+        getActualSizes(loc, resultTy.getShape(), maskTracker, rewriter);
+    SmallVector<OpFoldResult> strides(rank, rewriter.getIndexAttr(1));
+
+    // Flatten the indices of the region to match the gather.
+    auto seq = llvm::seq<int64_t>(0, rank);
+    SmallVector<ReassociationIndices> reassociation({{seq.begin(), seq.end()}});
+    Value indices = rewriter.create<tensor::ExtractSliceOp>(
+        loc, offset, offsets, sizes, strides);
+    if (rank > 1) {
+      indices =
+          rewriter.create<tensor::CollapseShapeOp>(loc, indices, reassociation);
+    }
+    indices = appendUnitDim(rewriter, loc, indices);
+    Value window = rewriter.create<tensor::EmptyOp>(
+        loc, getDims(rewriter, loc, indices), elementTy);
+
+    auto hints = getMemoryHints(op);
+    auto gatherOp = rewriter.create<linalg_ext::GatherOp>(
+        loc, ValueRange{originTensor, indices}, window,
+        /*dimensionMap=*/SmallVector<int64_t>({0}),
+        /*rangedData=*/false, [](OpBuilder &b, Location loc, ValueRange args) {
+          b.create<linalg_ext::ExtYieldOp>(loc, args[0]);
+        });
+    setMemoryHints(gatherOp, hints);
+    gatherOp.setSortIndices(hasLoadedOffsets(op.getPtr()));
+
+    // Reshape the region back.
+    Value region = rewriter.create<tensor::CollapseShapeOp>(
+        loc, gatherOp.getResult()[0],
+        SmallVector<ReassociationIndices>{{0, 1}});
+    if (rank > 1) {
+      SmallVector<int64_t> regionShape = llvm::to_vector(
+          llvm::map_range(sizes, [](OpFoldResult ofr) {
+            return getConstantIntValue(ofr).value_or(ShapedType::kDynamic);
+          }));
+      region = rewriter.create<tensor::ExpandShapeOp>(
+          loc, RankedTensorType::get(regionShape, elementTy), region,
+          reassociation, sizes);
+    }
+    return getPadOrInsertOpWithOther(loc, op.getOther(), resultTy, region,
+                                     offsets, sizes, rewriter);
+  }
 };
 
 class TritonScatteredStoreOpConversion
@@ -338,9 +424,10 @@ class TritonScatteredStoreOpConversion
 public:
   TritonScatteredStoreOpConversion(TritonLinalgTypeConverter &converter,
                                    MLIRContext *context, DataFlowSolver &solver,
-                                   PatternBenefit benefit)
+                                   PatternBenefit benefit,
+                                   LoweringStatistics *statistics = nullptr)
       : OpConversionPattern<triton::StoreOp>(converter, context, benefit),
-        TritonPtrScatterConversionBase(solver) {}
+        TritonPtrScatterConversionBase(solver, statistics) {}
 
   LogicalResult
   matchAndRewrite(triton::StoreOp op, OpAdaptor adaptor,
@@ -358,7 +445,9 @@ public:
     if (failed(tracker.parse(op.getPtr(), loc, rewriter)))
       return failure();
 
-    Value memref = getDynamicMemRef(loc, tracker.getBase(), valueTy, rewriter);
+    auto hints = getMemoryHints(op);
+    Value memref =
+        getDynamicMemRef(loc, tracker.getBase(), valueTy, rewriter, hints);
     Value originTensor =
         rewriter.create<bufferization::ToTensorOp>(loc, memref);
     // Get scatter init.
@@ -379,17 +468,19 @@ public:
       scatterInputs.push_back(mask);
     }
 
-    Value scatterRes = rewriter
-                           .create<linalg_ext::ScatterOp>(
-                               loc, scatterInputs, scatterInit,
-                               SmallVector<int64_t>({0}), false, true,
-                               [](OpBuilder &b, Location loc, ValueRange args) {
-                                 b.create<linalg_ext::ExtYieldOp>(loc, args[0]);
-                               })
-                           ->getResult(0);
+    // The single element windows do not overlap if the offsets are unique.
+    bool overlapWindow = !hasUniqueOffsets(op.getPtr(), valueTy.getShape());
+    auto scatterOp = rewriter.create<linalg_ext::ScatterOp>(
+        loc, scatterInputs, scatterInit, SmallVector<int64_t>({0}), false,
+        overlapWindow, [](OpBuilder &b, Location loc, ValueRange args) {
+          b.create<linalg_ext::ExtYieldOp>(loc, args[0]);
+        });
+    setMemoryHints(scatterOp, hints);
+    Value scatterRes = scatterOp->getResult(0);
 
     rewriter.create<aux::StoreResourceOp>(op.getLoc(), originTensor,
                                           scatterRes);
+    recordLowering(op, MemAccessLowering::Scattered);
     rewriter.eraseOp(op);
     return success();
   }
@@ -420,6 +511,187 @@ private:
   }
 };
 
+/// Extract the last dim index 0 of `value`, dropping the last dim.
+static Value extractFirstColumn(Location loc, Value value,
+                                ConversionPatternRewriter &rewriter) {
+  auto valueTy = value.getType().cast<RankedTensorType>();
+  auto rank = valueTy.getRank();
+  SmallVector<OpFoldResult> sizes =
+      getAsIndexOpFoldResult(rewriter.getContext(), valueTy.getShape());
+  sizes.back() = rewriter.getIndexAttr(1);
+  return rewriter.create<tensor::ExtractSliceOp>(
+      loc,
+      RankedTensorType::get(valueTy.getShape().drop_back(),
+                            valueTy.getElementType()),
+      value, SmallVector<OpFoldResult>(rank, rewriter.getIndexAttr(0)), sizes,
+      SmallVector<OpFoldResult>(rank, rewriter.getIndexAttr(1)));
+}
+
+/// Get the reassociation which collapses all dims but the last one.
+static SmallVector<ReassociationIndices> getRowReassociation(int64_t rank) {
+  SmallVector<ReassociationIndices> reassociation(2);
+  for (int64_t i = 0; i < rank - 1; ++i)
+    reassociation[0].push_back(i);
+  reassociation[1].push_back(rank - 1);
+  return reassociation;
+}
+
+/// Collapse `value` to a tensor of rows, i.e. tensor<axbxcxf32> to
+/// tensor<(a*b)xcxf32>.
+static Value collapseToRows(Location loc, Value value,
+                            ConversionPatternRewriter &rewriter) {
+  auto rank = value.getType().cast<RankedTensorType>().getRank();
+  if (rank == 2)
+    return value;
+  return rewriter.create<tensor::CollapseShapeOp>(loc, value,
+                                                  getRowReassociation(rank));
+}
+
+/// Lower a load whose rows are contiguous, such as
+/// `base + idx[:, None] * stride + arange(0, N)[None, :]`, to a gather with
+/// one index per row and a window of the row size, instead of one index per
+/// element:
+/// ```mlir
+///   %view = aux.view %ptr : memref<9223372036854775807xf32>
+///   %rows = tensor.extract_slice %offset[0, 0] [M, 1] [1, 1]
+///   %res = linalg_ext.gather dimension_map = [0] ranged_data(false)
+///       ins(%view, %rows : tensor<9223372036854775807xf32>, tensor<Mx1xi32>)
+///       outs(%window : tensor<MxNxf32>)
+/// ```
+class TritonRowGatherLoadOpConversion
+    : public OpConversionPattern<triton::LoadOp>,
+      TritonPtrScatterConversionBase {
+  using OpConversionPattern<triton::LoadOp>::OpConversionPattern;
+
+public:
+  TritonRowGatherLoadOpConversion(TritonLinalgTypeConverter &converter,
+                                  MLIRContext *context, DataFlowSolver &solver,
+                                  PatternBenefit benefit,
+                                  LoweringStatistics *statistics = nullptr)
+      : OpConversionPattern<triton::LoadOp>(converter, context, benefit),
+        TritonPtrScatterConversionBase(solver, statistics) {}
+
+  LogicalResult
+  matchAndRewrite(triton::LoadOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (triton::isTensorPointerType(op.getPtr().getType()))
+      return failure();
+    auto resultTy = op.getResult().getType().dyn_cast<RankedTensorType>();
+    if (!resultTy ||
+        !isRowContiguous(op.getPtr(), op.getMask(), resultTy.getShape()))
+      return failure();
+
+    auto loc = op.getLoc();
+    PointerMetaInfoTracker tracker;
+    if (failed(tracker.parse(op.getPtr(), loc, rewriter)))
+      return failure();
+    auto hints = getMemoryHints(op);
+    Value memref =
+        getDynamicMemRef(loc, tracker.getBase(), resultTy, rewriter, hints);
+    Value originTensor =
+        rewriter.create<bufferization::ToTensorOp>(loc, memref, true, true);
+
+    // Get window.
+    Value window = op.getOther();
+    if (!window) {
+      window = rewriter.create<tensor::EmptyOp>(loc, resultTy.getShape(),
+                                                resultTy.getElementType());
+    }
+    window = collapseToRows(loc, window, rewriter);
+
+    // Get the offset of the first element of each row.
+    Value indices = flattenValueToMatchGatherScatter(
+        rewriter, extractFirstColumn(loc, tracker.getOffset(), rewriter));
+    SmallVector<Value> gatherInputs{originTensor, indices};
+    if (op.getMask()) {
+      gatherInputs.push_back(flattenValueToMatchGatherScatter(
+          rewriter, extractFirstColumn(loc, op.getMask(), rewriter), false));
+    }
+
+    auto gatherOp = rewriter.create<linalg_ext::GatherOp>(
+        loc, gatherInputs, window,
+        /*dimensionMap=*/SmallVector<int64_t>({0}),
+        /*rangedData=*/false, [](OpBuilder &b, Location loc, ValueRange args) {
+          b.create<linalg_ext::ExtYieldOp>(loc, args[0]);
+        });
+    setMemoryHints(gatherOp, hints);
+    gatherOp.setSortIndices(hasLoadedOffsets(op.getPtr()));
+    Value gatherRes = gatherOp.getResult()[0];
+    if (resultTy.getRank() > 2) {
+      gatherRes = rewriter.create<tensor::ExpandShapeOp>(
+          loc, resultTy, gatherRes, getRowReassociation(resultTy.getRank()));
+    }
+    recordLowering(op, MemAccessLowering::Scattered);
+    rewriter.replaceOp(op, gatherRes);
+    return success();
+  }
+};
+
+/// Lower a store whose rows are contiguous to a scatter with one index per
+/// row, see TritonRowGatherLoadOpConversion.
+class TritonRowScatterStoreOpConversion
+    : public OpConversionPattern<triton::StoreOp>,
+      TritonPtrScatterConversionBase {
+  using OpConversionPattern<triton::StoreOp>::OpConversionPattern;
+
+public:
+  TritonRowScatterStoreOpConversion(TritonLinalgTypeConverter &converter,
+                                    MLIRContext *context,
+                                    DataFlowSolver &solver,
+                                    PatternBenefit benefit,
+                                    LoweringStatistics *statistics = nullptr)
+      : OpConversionPattern<triton::StoreOp>(converter, context, benefit),
+        TritonPtrScatterConversionBase(solver, statistics) {}
+
+  LogicalResult
+  matchAndRewrite(triton::StoreOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (triton::isTensorPointerType(op.getPtr().getType()))
+      return failure();
+    auto valueTy = op.getValue().getType().dyn_cast<RankedTensorType>();
+    if (!valueTy ||
+        !isRowContiguous(op.getPtr(), op.getMask(), valueTy.getShape()))
+      return failure();
+
+    auto loc = op.getLoc();
+    PointerMetaInfoTracker tracker;
+    if (failed(tracker.parse(op.getPtr(), loc, rewriter)))
+      return failure();
+    auto hints = getMemoryHints(op);
+    Value memref =
+        getDynamicMemRef(loc, tracker.getBase(), valueTy, rewriter, hints);
+    Value originTensor =
+        rewriter.create<bufferization::ToTensorOp>(loc, memref);
+    Value scatterInit = rewriter.create<tensor::EmptyOp>(
+        loc, getDim(rewriter, loc, originTensor, 0), valueTy.getElementType());
+
+    // Get the offset of the first element of each row and the rows.
+    Value indices = flattenValueToMatchGatherScatter(
+        rewriter, extractFirstColumn(loc, tracker.getOffset(), rewriter));
+    Value updates = collapseToRows(loc, op.getValue(), rewriter);
+    SmallVector<Value> scatterInputs{updates, indices};
+    if (op.getMask()) {
+      scatterInputs.push_back(flattenValueToMatchGatherScatter(
+          rewriter, extractFirstColumn(loc, op.getMask(), rewriter), false));
+    }
+
+    // The stride between the rows is unknown, so rows may overlap.
+    auto scatterOp = rewriter.create<linalg_ext::ScatterOp>(
+        loc, scatterInputs, scatterInit,
+        /*dimensionMap=*/SmallVector<int64_t>({0}), /*rangedData=*/false,
+        /*overlapWindow=*/true,
+        [](OpBuilder &b, Location loc, ValueRange args) {
+          b.create<linalg_ext::ExtYieldOp>(loc, args[0]);
+        });
+    setMemoryHints(scatterOp, hints);
+    rewriter.create<aux::StoreResourceOp>(loc, originTensor,
+                                          scatterOp->getResult(0));
+    recordLowering(op, MemAccessLowering::Scattered);
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
 //////////////////////////// TensorPtr ///////////////////////////////////////
 /// Order is the reverse of permutation in linalg::Transpose.
 static SmallVector<int64_t> getPermutationFromOrder(ArrayRef<int32_t> order) {
@@ -436,6 +708,12 @@ class TritonTensorPtrLoadOpConversion
   using OpConversionPattern<triton::LoadOp>::OpConversionPattern;
 
 public:
+  TritonTensorPtrLoadOpConversion(TritonLinalgTypeConverter &converter,
+                                  MLIRContext *context,
+                                  LoweringStatistics *statistics = nullptr)
+      : OpConversionPattern<triton::LoadOp>(converter, context),
+        TritonTensorPtrLoadStoreOpConversionBase(statistics) {}
+
   LogicalResult
   matchAndRewrite(triton::LoadOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
@@ -454,13 +732,13 @@ public:
     SmallVector<int64_t> permutations =
         getPermutationFromOrder(tracker.getOrder());
     auto dimInfos = getDimInfos(tracker.getStrides(), resultTy.getShape());
+    auto padOffsets = getPadOffsets(loc, op.getBoundaryCheck(),
+                                    resultTy.getShape(), tracker, rewriter);
     auto sizes = getActualSizes(loc, op.getBoundaryCheck(), resultTy.getShape(),
-                                tracker, rewriter);
-    auto originalMemRef =
-        getMemRef(rewriter.getRemappedValue(tracker.getBase()),
-                  tracker.getOffsets(), sizes, tracker.getStrides(),
-                  permutations, dimInfos, resultTy.getElementType(), rewriter,
-                  getCacheModeAttr(op.getContext(), op.getCache()));
+                                tracker, padOffsets, rewriter);
+    auto originalMemRef = getBlockMemRef(
+        op, tracker, op.getBoundaryCheck(), padOffsets, sizes, permutations,
+        dimInfos, resultTy.getElementType(), rewriter, getMemoryHints(op));
 
     Value sliceTensor = rewriter.create<bufferization::ToTensorOp>(
         loc, originalMemRef, true, true);
@@ -474,10 +752,14 @@ public:
     if (op.getBoundaryCheck().empty()) {
       sliceTensor = transformResultWithTransposeAndDimInfo(
           sliceTensor, permutations, dimInfos, sizes, rewriter);
+      recordLowering(op, MemAccessLowering::TensorPointer);
       rewriter.replaceOp(op, sliceTensor);
       return success();
     }
 
+    // Only the in-bounds block is loaded, pad it to the block shape. Without
+    // padding option the padded elements are undefined, so the block is only
+    // inserted into an empty tensor.
     Value other = rewriter.create<tensor::EmptyOp>(loc, resultTy.getShape(),
                                                    resultTy.getElementType());
     if (op.getPadding()) {
@@ -500,10 +782,9 @@ public:
 
     auto value = transformResultWithTransposeAndDimInfo(
         sliceTensor, permutations, dimInfos, sizes, rewriter);
-    value = getPadOrInsertOpWithOther(
-        loc, other, resultTy, value,
-        SmallVector<OpFoldResult>(resultTy.getRank(), rewriter.getIndexAttr(0)),
-        sizes, rewriter);
+    value = getPadOrInsertOpWithOther(loc, other, resultTy, value, padOffsets,
+                                      sizes, rewriter);
+    recordLowering(op, MemAccessLowering::TensorPointer);
     rewriter.replaceOp(op, value);
     return success();
   }
@@ -515,6 +796,12 @@ class TritonTensorPtrStoreOpConversion
   using OpConversionPattern<triton::StoreOp>::OpConversionPattern;
 
 public:
+  TritonTensorPtrStoreOpConversion(TritonLinalgTypeConverter &converter,
+                                   MLIRContext *context,
+                                   LoweringStatistics *statistics = nullptr)
+      : OpConversionPattern<triton::StoreOp>(converter, context),
+        TritonTensorPtrLoadStoreOpConversionBase(statistics) {}
+
   LogicalResult
   matchAndRewrite(triton::StoreOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
@@ -533,13 +820,13 @@ public:
     SmallVector<int64_t> permutations =
         getPermutationFromOrder(tracker.getOrder());
     auto dimInfos = getDimInfos(tracker.getStrides(), valueTy.getShape());
+    auto padOffsets = getPadOffsets(loc, op.getBoundaryCheck(),
+                                    valueTy.getShape(), tracker, rewriter);
     auto sizes = getActualSizes(loc, op.getBoundaryCheck(), valueTy.getShape(),
-                                tracker, rewriter);
-    auto originalMemRef =
-        getMemRef(rewriter.getRemappedValue(tracker.getBase()),
-                  tracker.getOffsets(), sizes, tracker.getStrides(),
-                  permutations, dimInfos, valueTy.getElementType(), rewriter,
-                  getCacheModeAttr(op.getContext(), op.getCache()));
+                                tracker, padOffsets, rewriter);
+    auto originalMemRef = getBlockMemRef(
+        op, tracker, op.getBoundaryCheck(), padOffsets, sizes, permutations,
+        dimInfos, valueTy.getElementType(), rewriter, getMemoryHints(op));
     auto value = op.getValue();
     auto zeroAttr = rewriter.getIndexAttr(0);
     SmallVector<OpFoldResult> defaultOffsets(dimInfos.size(), zeroAttr);
@@ -548,7 +835,9 @@ public:
     if (!op.getBoundaryCheck().empty()) {
       auto rank = value.getType().cast<ShapedType>().getRank();
       value = rewriter.create<tensor::ExtractSliceOp>(
-          loc, value, SmallVector<OpFoldResult>(rank, rewriter.getIndexAttr(0)),
+          loc, value,
+          permutateAndRemoveBroadcastDims<OpFoldResult>(
+              padOffsets, permutations, dimInfos),
           permutateAndRemoveBroadcastDims<OpFoldResult>(sizes, permutations,
                                                         dimInfos),
           SmallVector<OpFoldResult>(rank, rewriter.getIndexAttr(1)));
@@ -557,6 +846,7 @@ public:
         rewriter.create<bufferization::MaterializeInDestinationOp>(
             op.getLoc(), value, originalMemRef);
     materializeOp.setWritable(true);
+    recordLowering(op, MemAccessLowering::TensorPointer);
     rewriter.eraseOp(op);
     return success();
   }
@@ -566,17 +856,22 @@ public:
 
 void triton::populateTritonLoadStoreToLinalgPatterns(
     RewritePatternSet &patterns, TritonLinalgTypeConverter &converter,
-    DataFlowSolver &solver) {
+    DataFlowSolver &solver, LoweringStatistics *statistics) {
   MLIRContext *context = patterns.getContext();
   patterns
       .add<TritonContiguousLoadOpConversion, TritonContiguousStoreOpConversion,
            TritonScalarLoadOpConversion, TritonScalarStoreOpConversion>(
-          converter, context, solver, 1);
+          converter, context, solver, 1, statistics);
+  // Row gather/scatter patterns only match pointers which are not a block,
+  // on which contiguous patterns fail.
+  patterns
+      .add<TritonRowGatherLoadOpConversion, TritonRowScatterStoreOpConversion>(
+          converter, context, solver, 1, statistics);
   // Make gather/scatter pattern run at last.
   patterns
       .add<TritonScatteredLoadOpConversion, TritonScatteredStoreOpConversion>(
-          converter, context, solver, 0);
+          converter, context, solver, 0, statistics);
   patterns
       .add<TritonTensorPtrLoadOpConversion, TritonTensorPtrStoreOpConversion>(
-          converter, context);
+          converter, context, statistics);
 }
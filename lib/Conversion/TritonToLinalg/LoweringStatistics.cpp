@@ -0,0 +1,92 @@
+//===- LoweringStatistics.cpp - Lowering statistics -------------*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+#include <array>
+
+#include "triton-linalg/Conversion/TritonToLinalg/LoweringStatistics.h"
+#include "mlir/IR/Diagnostics.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Interfaces/FunctionInterfaces.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/ErrorHandling.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+static StringRef getLoweringName(MemAccessLowering kind) {
+  switch (kind) {
+  case MemAccessLowering::Contiguous:
+    return "contiguous";
+  case MemAccessLowering::Scalar:
+    return "scalar";
+  case MemAccessLowering::Scattered:
+    return "scattered";
+  case MemAccessLowering::TensorPointer:
+    return "tensor-pointer";
+  }
+  llvm_unreachable("unknown memory access lowering");
+}
+
+void LoweringStatistics::recordMissed(Operation *op, const Twine &reason) {
+  missedReasons[op] = reason.str();
+}
+
+void LoweringStatistics::recordLowering(Operation *op,
+                                        MemAccessLowering kind) {
+  OpLowering lowering;
+  lowering.kind = kind;
+  lowering.loc = op->getLoc();
+  if (auto func = op->getParentOfType<FunctionOpInterface>()) {
+    lowering.funcName = SymbolTable::getSymbolName(func);
+    lowering.funcLoc = func.getLoc();
+  }
+  auto it = missedReasons.find(op);
+  if (kind == MemAccessLowering::Scattered && it != missedReasons.end())
+    lowering.missedReason = it->second;
+  lowerings[op] = std::move(lowering);
+}
+
+unsigned LoweringStatistics::getNumLowerings(MemAccessLowering kind) const {
+  return llvm::count_if(lowerings, [kind](const auto &it) {
+    return it.second.kind == kind;
+  });
+}
+
+unsigned LoweringStatistics::getNumMissed() const {
+  return llvm::count_if(lowerings, [](const auto &it) {
+    return it.second.missedReason.has_value();
+  });
+}
+
+void LoweringStatistics::emitRemarks() const {
+  struct FuncLowerings {
+    LocationAttr loc;
+    std::array<unsigned, kNumMemAccessLowerings> counts{};
+  };
+  // Lowerings per function, in order of the first lowered op.
+  llvm::MapVector<StringAttr, FuncLowerings> funcLowerings;
+  for (const auto &it : lowerings) {
+    const OpLowering &lowering = it.second;
+    if (lowering.missedReason) {
+      mlir::emitRemark(lowering.loc)
+          << "memory access misses the contiguous lowering: "
+          << *lowering.missedReason;
+    }
+    if (!lowering.funcName)
+      continue;
+    auto &counts = funcLowerings[lowering.funcName];
+    counts.loc = lowering.funcLoc;
+    ++counts.counts[static_cast<unsigned>(lowering.kind)];
+  }
+  for (const auto &it : funcLowerings) {
+    auto diag = mlir::emitRemark(it.second.loc) << "memory access lowerings:";
+    for (unsigned i = 0; i < kNumMemAccessLowerings; ++i) {
+      diag << (i ? ", " : " ") << it.second.counts[i] << " "
+           << getLoweringName(static_cast<MemAccessLowering>(i));
+    }
+  }
+}
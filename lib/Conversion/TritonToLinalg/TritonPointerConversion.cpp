@@ -25,6 +25,7 @@
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h"
 #include "mlir/Dialect/LLVMIR/LLVMTypes.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
 #include "mlir/Dialect/Utils/StaticValueUtils.h"
@@ -41,12 +42,14 @@
 #include "mlir/IR/Types.h"
 #include "mlir/IR/Value.h"
 #include "mlir/IR/ValueRange.h"
+#include "mlir/Interfaces/LoopLikeInterface.h"
 #include "mlir/Support/LLVM.h"
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "triton/Dialect/Triton/IR/Dialect.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Sequence.h"
 #include "llvm/ADT/SmallVector.h"
@@ -147,6 +150,33 @@ static Value extractSliceAndDropLastNdims(Location loc, Value value,
       .getResult();
 }
 
+bool triton::hasLoadedOffsets(Value ptr) {
+  // Only follow the tensors computed element by element, so that scalars
+  // loaded from memory, e.g. the start of a sequence, are not counted.
+  SmallVector<Value> worklist{ptr};
+  DenseSet<Value> visited;
+  while (!worklist.empty()) {
+    Value value = worklist.pop_back_val();
+    if (!value.getType().isa<RankedTensorType>() ||
+        !visited.insert(value).second)
+      continue;
+    Operation *op = value.getDefiningOp();
+    if (!op)
+      continue;
+    if (auto loadOp = dyn_cast<triton::LoadOp>(op)) {
+      if (getElementTypeOrSelf(loadOp.getType()).isIntOrIndex())
+        return true;
+      continue;
+    }
+    if (!isa<triton::AddPtrOp, triton::BroadcastOp, triton::ExpandDimsOp,
+             triton::ReshapeOp>(op) &&
+        !OpTrait::hasElementwiseMappableTraits(op))
+      continue;
+    worklist.append(op->operand_begin(), op->operand_end());
+  }
+  return false;
+}
+
 Value triton::flattenValueToMatchGatherScatter(
     ConversionPatternRewriter &rewriter, Value value, bool appendUnitDim) {
   if (!value)
@@ -233,11 +263,25 @@ Value triton::reshapeGatherScatterValueTo(
 // TritonPtrConversionBase
 //===----------------------------------------------------------------------===//
 
+void TritonPtrConversionBase::recordLowering(Operation *op,
+                                             MemAccessLowering kind) const {
+  if (statistics)
+    statistics->recordLowering(op, kind);
+}
+
+LogicalResult
+TritonPtrConversionBase::notifyContiguousMissed(Operation *op,
+                                                const Twine &reason) const {
+  if (statistics)
+    statistics->recordMissed(op, reason);
+  return failure();
+}
+
 Value TritonPtrConversionBase::getMemRef(
     Value base, OpFoldResult offset, ArrayRef<OpFoldResult> sizes,
     ArrayRef<OpFoldResult> strides, ArrayRef<int64_t> permutations,
     ArrayRef<DimInfo> dimInfos, Type elementType,
-    ConversionPatternRewriter &rewriter, StringAttr cacheMode) const {
+    ConversionPatternRewriter &rewriter, const MemoryHints &hints) const {
   auto llvmPtrType = LLVM::LLVMPointerType::get(rewriter.getContext());
   assert(sizes.size() == strides.size() &&
          (sizes.size() == permutations.size() || permutations.empty()) &&
@@ -253,15 +297,19 @@ Value TritonPtrConversionBase::getMemRef(
   if (!offset)
     offset = rewriter.getIndexAttr(0);
 
-  return rewriter.create<triton::aux::ViewOp>(
-      loc, elementType, llvmPtr, offset, newSizes, newStrides, cacheMode);
+  // All the hints, including the cache mode, are set by setMemoryHints.
+  auto viewOp = rewriter.create<triton::aux::ViewOp>(
+      loc, elementType, llvmPtr, offset, newSizes, newStrides,
+      /*cacheMode=*/nullptr);
+  setMemoryHints(viewOp, hints);
+  return viewOp;
 }
 
 Value TritonPtrConversionBase::getMemRef(
     Value base, ArrayRef<OpFoldResult> offsets, ArrayRef<OpFoldResult> sizes,
     ArrayRef<OpFoldResult> strides, ArrayRef<int64_t> permutations,
     ArrayRef<DimInfo> dimInfos, Type elementType,
-    ConversionPatternRewriter &rewriter, StringAttr cacheMode) const {
+    ConversionPatternRewriter &rewriter, const MemoryHints &hints) const {
   assert(sizes.size() == offsets.size() && sizes.size() == strides.size() &&
          sizes.size() == permutations.size() &&
          sizes.size() == dimInfos.size());
@@ -276,7 +324,7 @@ Value TritonPtrConversionBase::getMemRef(
   }
 
   return getMemRef(base, finalOffset, sizes, strides, permutations, dimInfos,
-                   elementType, rewriter, cacheMode);
+                   elementType, rewriter, hints);
 }
 
 Value TritonPtrConversionBase::transformResultWithTransposeAndDimInfo(
@@ -557,15 +605,16 @@ TritonPtrContiguousConversionBase::getOffsetAndStrides(
 using PtrInfo = TritonPtrLoadStoreOpConversionBase::PtrInfo;
 
 FailureOr<PtrInfo> TritonPtrContiguousConversionBase::getPtrInfo(
-    Location loc, Value ptr, Value mask, RankedTensorType tensorType,
-    ConversionPatternRewriter &rewriter, StringAttr cacheMode,
+    Operation *op, Value ptr, Value mask, RankedTensorType tensorType,
+    ConversionPatternRewriter &rewriter, const MemoryHints &hints,
     bool allowMaskTrackerFailureIgnore) const {
+  Location loc = op->getLoc();
   PtrInfo ret;
   const auto *axisInfo = getAxisInfo(ptr);
   ret.offsets =
       SmallVector<OpFoldResult>(tensorType.getRank(), rewriter.getIndexAttr(0));
   if (!axisInfo)
-    return failure();
+    return notifyContiguousMissed(op, "AxisInfo of the pointer is unknown");
 
   // Analyze the mask operand to determine at runtime the size of the data we
   // move.
@@ -579,7 +628,8 @@ FailureOr<PtrInfo> TritonPtrContiguousConversionBase::getPtrInfo(
       if (allowMaskTrackerFailureIgnore) {
         ret.isMaskTrackerFailed = true;
       } else {
-        return failure();
+        return notifyContiguousMissed(
+            op, "MaskTracker failed on a dim of the mask");
       }
     } else {
       ret.offsets = llvm::to_vector(maskTracker.getStarts());
@@ -587,12 +637,14 @@ FailureOr<PtrInfo> TritonPtrContiguousConversionBase::getPtrInfo(
   }
 
   ret.dimInfos = getDimInfos(axisInfo, tensorType.getShape());
-  if (!isBlockPtr(ret.dimInfos))
-    return failure();
+  if (!isBlockPtr(ret.dimInfos)) {
+    return notifyContiguousMissed(
+        op, "AxisInfo stride of the pointer is unknown on a dim");
+  }
 
   PointerMetaInfoTracker ptrInfoTracker;
   if (failed(ptrInfoTracker.parse(ptr, loc, rewriter)))
-    return failure();
+    return notifyContiguousMissed(op, "base of the pointer is not a splat");
   ret.sizes = getActualSizes(
       loc, tensorType.getShape(),
       mask ? (ret.isMaskTrackerFailed ? std::nullopt
@@ -611,7 +663,7 @@ FailureOr<PtrInfo> TritonPtrContiguousConversionBase::getPtrInfo(
       getMemRef(rewriter.getRemappedValue(ptrInfoTracker.getBase()),
                 getAsOpFoldResult(offset), ret.sizes,
                 getAsOpFoldResult(strides), ret.permutations, ret.dimInfos,
-                tensorType.getElementType(), rewriter, cacheMode);
+                tensorType.getElementType(), rewriter, hints);
   ret.offsets = getMaskedOffsets(
       tensorType.getRank(),
       mask ? std::optional<MaskTracker>(maskTracker) : std::nullopt, rewriter);
@@ -623,12 +675,12 @@ FailureOr<PtrInfo> TritonPtrContiguousConversionBase::getPtrInfo(
 //===----------------------------------------------------------------------===//
 Value TritonPtrScalarConversionBase::getMemRef(
     Location loc, Value ptr, Type elementType,
-    ConversionPatternRewriter &rewriter, StringAttr cacheMode) const {
+    ConversionPatternRewriter &rewriter, const MemoryHints &hints) const {
   OpFoldResult c1 = rewriter.getIndexAttr(1);
   OpFoldResult c0 = rewriter.getIndexAttr(0);
   return TritonPtrConversionBase::getMemRef(rewriter.getRemappedValue(ptr), c0,
                                             {c1}, {c1}, {}, {}, elementType,
-                                            rewriter, cacheMode);
+                                            rewriter, hints);
 }
 
 //===----------------------------------------------------------------------===//
@@ -636,22 +688,101 @@ Value TritonPtrScalarConversionBase::getMemRef(
 //===----------------------------------------------------------------------===//
 Value TritonPtrScatterConversionBase::getDynamicMemRef(
     Location loc, Value ptr, RankedTensorType tensorType,
-    ConversionPatternRewriter &rewriter, StringAttr cacheMode) const {
+    ConversionPatternRewriter &rewriter, const MemoryHints &hints) const {
   OpFoldResult c1 = rewriter.getIndexAttr(1);
   // Using the maximum size to represent the pointer size of unknown shape.
   OpFoldResult size =
       rewriter.getIndexAttr(std::numeric_limits<int64_t>().max());
   return getMemRef(rewriter.getRemappedValue(ptr), nullptr, {size}, {c1}, {},
-                   {}, tensorType.getElementType(), rewriter, cacheMode);
+                   {}, tensorType.getElementType(), rewriter, hints);
+}
+
+bool TritonPtrScatterConversionBase::isRowContiguous(
+    Value ptr, Value mask, ArrayRef<int64_t> tensorShape) const {
+  int64_t rank = tensorShape.size();
+  if (rank < 2 || tensorShape.back() == 1)
+    return false;
+  const auto *axisInfo = getAxisInfo(ptr);
+  if (!axisInfo || axisInfo->getRank() != rank ||
+      isBlockPtr(getDimInfos(axisInfo, tensorShape)) ||
+      !axisInfo->isContiguousDim(tensorShape, rank - 1))
+    return false;
+  if (!mask)
+    return true;
+  const auto *maskAxisInfo = getAxisInfo(mask);
+  return maskAxisInfo && maskAxisInfo->getRank() == rank &&
+         maskAxisInfo->isConstantDim(tensorShape, rank - 1);
+}
+
+bool TritonPtrScatterConversionBase::hasUniqueOffsets(
+    Value ptr, ArrayRef<int64_t> tensorShape) const {
+  int64_t rank = tensorShape.size();
+  const auto *axisInfo = getAxisInfo(ptr);
+  if (!axisInfo || axisInfo->getRank() != rank)
+    return false;
+  SmallVector<std::pair<int64_t, int64_t>> strideAndSizes;
+  for (int64_t dim = 0; dim < rank; ++dim) {
+    if (tensorShape[dim] == 1)
+      continue;
+    // A stride value of -1 is unknown, so that only positive strides are
+    // taken as known.
+    if (ShapedType::isDynamic(tensorShape[dim]) ||
+        !axisInfo->isStrideDim(tensorShape, dim) ||
+        axisInfo->getStrideValue(dim) <= 0)
+      return false;
+    strideAndSizes.emplace_back(axisInfo->getStrideValue(dim),
+                                tensorShape[dim]);
+  }
+  // Offsets are `sum(stride[d] * i[d])`, which is injective if every stride
+  // exceeds the largest offset reached by the smaller strides.
+  llvm::sort(strideAndSizes);
+  int64_t span = 0;
+  for (auto [stride, size] : strideAndSizes) {
+    if (stride <= span)
+      return false;
+    span += stride * (size - 1);
+  }
+  return true;
+}
+
+bool TritonPtrScatterConversionBase::hasRepeatedOffsets(
+    Value ptr, ArrayRef<int64_t> tensorShape) const {
+  const auto *axisInfo = getAxisInfo(ptr);
+  if (!axisInfo || axisInfo->getRank() != static_cast<int>(tensorShape.size()))
+    return false;
+  return llvm::any_of(llvm::seq<int>(0, axisInfo->getRank()), [&](int dim) {
+    return tensorShape[dim] > 1 && axisInfo->getConstancy(dim) > 1;
+  });
 }
 
 //===----------------------------------------------------------------------===//
 // TritonTensorPtrLoadStoreOpConversionBase
 //===----------------------------------------------------------------------===//
+SmallVector<OpFoldResult>
+TritonTensorPtrLoadStoreOpConversionBase::getPadOffsets(
+    Location loc, std::optional<ArrayRef<int>> boundaryCheck,
+    ArrayRef<int64_t> tensorShape, const TensorPointerMetaInfoTracker &tracker,
+    ConversionPatternRewriter &rewriter) const {
+  auto zeroAttr = rewriter.getIndexAttr(0);
+  SmallVector<OpFoldResult> padOffsets(tensorShape.size(), zeroAttr);
+  if (boundaryCheck) {
+    for (auto i : boundaryCheck.value()) {
+      // The elements before the start of the tensor are out of bounds.
+      OpFoldResult padOffset =
+          subOFRs(zeroAttr, tracker.getOffsets()[i], loc, rewriter);
+      padOffset = maxOFRs(padOffset, zeroAttr, loc, rewriter);
+      padOffsets[i] = minOFRs(padOffset, rewriter.getIndexAttr(tensorShape[i]),
+                              loc, rewriter);
+    }
+  }
+  return padOffsets;
+}
+
 SmallVector<OpFoldResult>
 TritonTensorPtrLoadStoreOpConversionBase::getActualSizes(
     Location loc, std::optional<ArrayRef<int>> boundaryCheck,
     ArrayRef<int64_t> tensorShape, const TensorPointerMetaInfoTracker &tracker,
+    ArrayRef<OpFoldResult> padOffsets,
     ConversionPatternRewriter &rewriter) const {
   SmallVector<OpFoldResult> blockSizes = llvm::to_vector<4>(
       llvm::map_range(tensorShape, [&rewriter](int64_t dim) -> OpFoldResult {
@@ -661,7 +792,11 @@ TritonTensorPtrLoadStoreOpConversionBase::getActualSizes(
     for (auto i : boundaryCheck.value()) {
       OpFoldResult remainSize = subOFRs(tracker.getSizes()[i],
                                         tracker.getOffsets()[i], loc, rewriter);
-      blockSizes[i] = minOFRs(remainSize, blockSizes[i], loc, rewriter);
+      remainSize = minOFRs(remainSize, blockSizes[i], loc, rewriter);
+      remainSize = subOFRs(remainSize, padOffsets[i], loc, rewriter);
+      // A block starting beyond the tensor has no element in bounds.
+      blockSizes[i] =
+          maxOFRs(remainSize, rewriter.getIndexAttr(0), loc, rewriter);
     }
   }
   return blockSizes;
@@ -682,3 +817,69 @@ SmallVector<DimInfo> TritonTensorPtrLoadStoreOpConversionBase::getDimInfos(
   }
   return dimInfos;
 }
+
+Value TritonTensorPtrLoadStoreOpConversionBase::getBlockMemRef(
+    Operation *op, const TensorPointerMetaInfoTracker &tracker,
+    std::optional<ArrayRef<int>> boundaryCheck,
+    ArrayRef<OpFoldResult> padOffsets, ArrayRef<OpFoldResult> sizes,
+    ArrayRef<int64_t> permutations, ArrayRef<DimInfo> dimInfos,
+    Type elementType, ConversionPatternRewriter &rewriter,
+    const MemoryHints &hints) const {
+  auto makeTensorPtrOp = tracker.getMakeTensorPtrOp();
+  Location loc = op->getLoc();
+  SmallVector<OpFoldResult> blockOffsets;
+  for (auto [offset, padOffset] : llvm::zip(tracker.getOffsets(), padOffsets))
+    blockOffsets.push_back(addOFRs(offset, padOffset, loc, rewriter));
+
+  // The block only lies within the tensor on the boundary-checked dims, it
+  // may run past it or start before it on the others. Such a block is viewed
+  // at its exact offsets.
+  bool isInBounds =
+      llvm::all_of(llvm::seq<int>(0, dimInfos.size()), [&](int i) {
+        return dimInfos[i].isBroadcastDim() ||
+               (boundaryCheck && llvm::is_contained(*boundaryCheck, i));
+      });
+  if (!isInBounds)
+    return getMemRef(rewriter.getRemappedValue(tracker.getBase()),
+                     blockOffsets, sizes, tracker.getStrides(), permutations,
+                     dimInfos, elementType, rewriter, hints);
+
+  // Find the outermost loop in which the view is invariant.
+  SmallVector<Value> invariants{makeTensorPtrOp.getBase()};
+  llvm::append_range(invariants, makeTensorPtrOp.getShape());
+  llvm::append_range(invariants, makeTensorPtrOp.getStrides());
+  Operation *hoistPoint = op;
+  while (auto loop = hoistPoint->getParentOfType<LoopLikeOpInterface>()) {
+    if (!llvm::all_of(invariants, [&loop](Value value) {
+          return loop.isDefinedOutsideOfLoop(value);
+        }))
+      break;
+    hoistPoint = loop;
+  }
+
+  Value view;
+  {
+    OpBuilder::InsertionGuard guard(rewriter);
+    rewriter.setInsertionPoint(hoistPoint);
+    SmallVector<OpFoldResult> shape, strides;
+    for (auto &&[dim, stride] : llvm::zip(makeTensorPtrOp.getShape(),
+                                          makeTensorPtrOp.getStrides())) {
+      shape.push_back(rewriter.createOrFold<arith::IndexCastOp>(
+          loc, rewriter.getIndexType(), dim));
+      strides.push_back(rewriter.createOrFold<arith::IndexCastOp>(
+          loc, rewriter.getIndexType(), stride));
+    }
+    view = getMemRef(rewriter.getRemappedValue(makeTensorPtrOp.getBase()),
+                     rewriter.getIndexAttr(0), shape, strides, permutations,
+                     dimInfos, elementType, rewriter, hints);
+  }
+
+  auto offsets = permutateAndRemoveBroadcastDims<OpFoldResult>(
+      blockOffsets, permutations, dimInfos);
+  auto blockSizes =
+      permutateAndRemoveBroadcastDims(sizes, permutations, dimInfos);
+  SmallVector<OpFoldResult> blockStrides(blockSizes.size(),
+                                         rewriter.getIndexAttr(1));
+  return rewriter.create<memref::SubViewOp>(loc, view, offsets, blockSizes,
+                                            blockStrides);
+}
@@ -21,6 +21,7 @@
 #include "triton-linalg/Conversion/TritonToLinalg/AtomicCASConversion.h"
 #include "triton-linalg/Conversion/TritonToLinalg/AtomicRmwConversion.h"
 #include "triton-linalg/Conversion/TritonToLinalg/LoadStoreConversion.h"
+#include "triton-linalg/Conversion/TritonToLinalg/LoweringStatistics.h"
 #include "triton-linalg/Conversion/TritonToLinalg/TritonToLinalg.h"
 #include "triton-linalg/Conversion/TritonToLinalg/TypeConverter.h"
 #include "triton-linalg/Conversion/TritonToLinalg/Utils.h"
@@ -36,6 +37,7 @@
 #include "mlir/Analysis/DataFlow/DeadCodeAnalysis.h"
 #include "mlir/Analysis/DataFlow/SparseAnalysis.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Arith/Utils/Utils.h"
 #include "mlir/Dialect/Bufferization/IR/Bufferization.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/GPU/IR/GPUDialect.h"
@@ -47,7 +49,9 @@
 #include "mlir/Dialect/SCF/Transforms/Patterns.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
+#include "mlir/Dialect/Utils/StructuredOpsUtils.h"
 #include "mlir/IR/AffineExpr.h"
+#include "mlir/IR/AffineMap.h"
 #include "mlir/IR/Block.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinAttributeInterfaces.h"
@@ -75,11 +79,14 @@
 #include "triton/Dialect/Triton/IR/Types.h"
 #include "llvm/ADT/ADL.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/STLForwardCompat.h"
 #include "llvm/ADT/Sequence.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/ADT/iterator.h"
@@ -124,8 +131,10 @@ getBroadcastDimensions(ArrayRef<int64_t> srcShape, ArrayRef<int64_t> dstShape) {
   return dimensions;
 }
 
+/// Slice the first element of `input` along `dim`, or the last one if
+/// `fromEnd` is set.
 static Value sliceFirst(ConversionPatternRewriter &rewriter, Location loc,
-                        Value input, int64_t dim) {
+                        Value input, int64_t dim, bool fromEnd = false) {
   ShapedType inputType = input.getType().cast<ShapedType>();
   auto sizes =
       llvm::to_vector(llvm::map_range(inputType.getShape(), [&](int64_t t) {
@@ -136,6 +145,8 @@ static Value sliceFirst(ConversionPatternRewriter &rewriter, Location loc,
   sizes[dim] = rewriter.getIndexAttr(1);
   // Retrieve slice offsets of input.
   SmallVector<OpFoldResult> offsets(rank, rewriter.getIndexAttr(0));
+  if (fromEnd)
+    offsets[dim] = rewriter.getIndexAttr(inputType.getDimSize(dim) - 1);
   // Retrieve slice strides of input.
   SmallVector<OpFoldResult> strides(rank, rewriter.getIndexAttr(1));
   // Create the slice of input.
@@ -143,8 +154,10 @@ static Value sliceFirst(ConversionPatternRewriter &rewriter, Location loc,
                                                  strides);
 }
 
+/// Slice all but the first element of `input` along `dim`, or all but the
+/// last one if `fromEnd` is set.
 static Value sliceRemaining(ConversionPatternRewriter &rewriter, Location loc,
-                            Value input, int64_t dim) {
+                            Value input, int64_t dim, bool fromEnd = false) {
   ShapedType inputType = input.getType().cast<ShapedType>();
   auto sizes =
       llvm::to_vector(llvm::map_range(inputType.getShape(), [&](int64_t t) {
@@ -155,7 +168,8 @@ static Value sliceRemaining(ConversionPatternRewriter &rewriter, Location loc,
   sizes[dim] = rewriter.getIndexAttr(inputType.getDimSize(dim) - 1);
   // Retrieve slice offsets of input.
   SmallVector<OpFoldResult> offsets(rank, rewriter.getIndexAttr(0));
-  offsets[dim] = rewriter.getIndexAttr(1);
+  if (!fromEnd)
+    offsets[dim] = rewriter.getIndexAttr(1);
   // Retrieve slice strides of input.
   SmallVector<OpFoldResult> strides(rank, rewriter.getIndexAttr(1));
   // Create the slice of input.
@@ -163,6 +177,345 @@ static Value sliceRemaining(ConversionPatternRewriter &rewriter, Location loc,
                                                  strides);
 }
 
+/// Collect the reduction kinds of the operands compared in `cond`, the
+/// condition of a select based combiner such as argmax, in which the lhs is
+/// picked when `cond` holds if `lhsPicked` is set. The identity of the
+/// recorded kind is the value which never wins the comparison as the rhs,
+/// e.g. `maximumf` for `lhs > rhs`. The block arguments whose nan check alone
+/// makes `cond` hold are added to `nanChecked`, if it is not null.
+static LogicalResult collectCmpSelectKinds(
+    Value cond, Block &block, bool lhsPicked,
+    llvm::SmallDenseMap<int64_t, arith::AtomicRMWKind> &kinds,
+    llvm::SmallDenseSet<int64_t> *nanChecked) {
+  int64_t numOperands = block.getNumArguments() / 2;
+  Operation *condOp = cond.getDefiningOp();
+  if (!condOp || condOp->getBlock() != &block)
+    return failure();
+  if (isa<arith::OrIOp, arith::AndIOp>(condOp)) {
+    if (isa<arith::AndIOp>(condOp))
+      nanChecked = nullptr;
+    return success(
+        succeeded(collectCmpSelectKinds(condOp->getOperand(0), block,
+                                        lhsPicked, kinds, nanChecked)) &&
+        succeeded(collectCmpSelectKinds(condOp->getOperand(1), block,
+                                        lhsPicked, kinds, nanChecked)));
+  }
+  if (!isa<arith::CmpFOp, arith::CmpIOp>(condOp))
+    return failure();
+
+  auto lhsArg = condOp->getOperand(0).dyn_cast<BlockArgument>();
+  auto rhsArg = condOp->getOperand(1).dyn_cast<BlockArgument>();
+  if (!lhsArg || !rhsArg || lhsArg.getOwner() != &block ||
+      rhsArg.getOwner() != &block)
+    return failure();
+  // Nan checks never hold on an identity.
+  if (lhsArg == rhsArg) {
+    auto cmpFOp = dyn_cast<arith::CmpFOp>(condOp);
+    if (!cmpFOp || (cmpFOp.getPredicate() != arith::CmpFPredicate::UNE &&
+                    cmpFOp.getPredicate() != arith::CmpFPredicate::UNO))
+      return failure();
+    if (nanChecked)
+      nanChecked->insert(lhsArg.getArgNumber());
+    return success();
+  }
+  int64_t lhsIdx = lhsArg.getArgNumber();
+  int64_t rhsIdx = rhsArg.getArgNumber();
+  if (lhsIdx + numOperands != rhsIdx && rhsIdx + numOperands != lhsIdx)
+    return failure();
+
+  bool greater, isSigned = true, isFloat = isa<arith::CmpFOp>(condOp);
+  if (auto cmpFOp = dyn_cast<arith::CmpFOp>(condOp)) {
+    switch (cmpFOp.getPredicate()) {
+    case arith::CmpFPredicate::OGT:
+    case arith::CmpFPredicate::OGE:
+    case arith::CmpFPredicate::UGT:
+    case arith::CmpFPredicate::UGE:
+      greater = true;
+      break;
+    case arith::CmpFPredicate::OLT:
+    case arith::CmpFPredicate::OLE:
+    case arith::CmpFPredicate::ULT:
+    case arith::CmpFPredicate::ULE:
+      greater = false;
+      break;
+    case arith::CmpFPredicate::OEQ:
+    case arith::CmpFPredicate::UEQ:
+      // Tie checks, the tie is broken by another comparison.
+      return success();
+    default:
+      return failure();
+    }
+  } else {
+    switch (cast<arith::CmpIOp>(condOp).getPredicate()) {
+    case arith::CmpIPredicate::sgt:
+    case arith::CmpIPredicate::sge:
+      greater = true;
+      break;
+    case arith::CmpIPredicate::slt:
+    case arith::CmpIPredicate::sle:
+      greater = false;
+      break;
+    case arith::CmpIPredicate::ugt:
+    case arith::CmpIPredicate::uge:
+      greater = true;
+      isSigned = false;
+      break;
+    case arith::CmpIPredicate::ult:
+    case arith::CmpIPredicate::ule:
+      greater = false;
+      isSigned = false;
+      break;
+    case arith::CmpIPredicate::eq:
+      return success();
+    default:
+      return failure();
+    }
+  }
+
+  bool largerWins = greater ^ (lhsIdx >= numOperands) ^ !lhsPicked;
+  arith::AtomicRMWKind kind;
+  if (isFloat)
+    kind = largerWins ? arith::AtomicRMWKind::maximumf
+                      : arith::AtomicRMWKind::minimumf;
+  else if (isSigned)
+    kind = largerWins ? arith::AtomicRMWKind::maxs : arith::AtomicRMWKind::mins;
+  else
+    kind = largerWins ? arith::AtomicRMWKind::maxu : arith::AtomicRMWKind::minu;
+  int64_t operandIdx = std::min(lhsIdx, rhsIdx);
+  auto it = kinds.try_emplace(operandIdx, kind).first;
+  return success(it->second == kind);
+}
+
+/// Get the neutral elements of the combiner of `op`, one per result. Each
+/// result has to be either a single payload op on its own operands, such as
+/// `(sum, sumsq)`, or a select between its own operands whose condition
+/// compares it, such as argmax with index tie-break.
+///
+/// The lhs of the combiner is the element of the input and the rhs the
+/// accumulator. A float compared in a select is only filled with its
+/// identity if a nan lhs is picked, otherwise a row of nans would never beat
+/// the identity and would yield the identity of the selected index.
+static std::optional<SmallVector<TypedAttr>>
+getReduceNeutralElements(triton::ReduceOp op) {
+  Block &block = op.getCombineOp().front();
+  int64_t numOperands = op.getNumResults();
+  if (block.getNumArguments() != 2 * numOperands)
+    return std::nullopt;
+  Operation *terminator = block.getTerminator();
+  auto isOperandPair = [&](Value lhs, Value rhs, int64_t idx) {
+    return (lhs == block.getArgument(idx) &&
+            rhs == block.getArgument(idx + numOperands)) ||
+           (rhs == block.getArgument(idx) &&
+            lhs == block.getArgument(idx + numOperands));
+  };
+
+  SmallVector<TypedAttr> neutralElements;
+  llvm::SmallDenseMap<int64_t, arith::AtomicRMWKind> kinds;
+  llvm::SmallDenseSet<int64_t> nanChecked;
+  SmallVector<int64_t> selectIndices;
+  bool allLhsPicked = true;
+  for (int64_t i = 0; i < numOperands; ++i) {
+    Operation *payloadOp = terminator->getOperand(i).getDefiningOp();
+    if (!payloadOp || payloadOp->getBlock() != &block ||
+        payloadOp->getNumResults() != 1)
+      return std::nullopt;
+    if (auto selectOp = dyn_cast<arith::SelectOp>(payloadOp)) {
+      if (!isOperandPair(selectOp.getTrueValue(), selectOp.getFalseValue(),
+                         i))
+        return std::nullopt;
+      bool lhsPicked = selectOp.getTrueValue() == block.getArgument(i);
+      allLhsPicked &= lhsPicked;
+      if (failed(collectCmpSelectKinds(selectOp.getCondition(), block,
+                                       lhsPicked, kinds, &nanChecked)))
+        return std::nullopt;
+      selectIndices.push_back(i);
+      neutralElements.push_back(nullptr);
+      continue;
+    }
+    if (payloadOp->getNumOperands() != 2 ||
+        !isOperandPair(payloadOp->getOperand(0), payloadOp->getOperand(1), i))
+      return std::nullopt;
+    std::optional<TypedAttr> neutralElement = getNeutralElement(payloadOp);
+    if (!neutralElement.has_value())
+      return std::nullopt;
+    neutralElements.push_back(*neutralElement);
+  }
+
+  // A selected operand which is never compared would leak the identity on a
+  // tie, e.g. the index of argmax without tie-break.
+  OpBuilder b(op.getContext());
+  for (int64_t i : selectIndices) {
+    auto it = kinds.find(i);
+    if (it == kinds.end())
+      return std::nullopt;
+    bool isFloat = it->second == arith::AtomicRMWKind::maximumf ||
+                   it->second == arith::AtomicRMWKind::minimumf;
+    if (isFloat && (!allLhsPicked || !nanChecked.contains(i)))
+      return std::nullopt;
+    neutralElements[i] = getIdentityValueAttr(
+        it->second, block.getArgument(i).getType(), b, op.getLoc());
+  }
+  return neutralElements;
+}
+
+/// Whether `order` swaps the two innermost dims of a 2-d or 3-d tensor, which
+/// a matmul can read transposed.
+static bool isMatmulTranspose(ArrayRef<int32_t> order) {
+  if (order.size() == 2)
+    return order[0] == 1 && order[1] == 0;
+  return order.size() == 3 && order[0] == 0 && order[1] == 2 && order[2] == 1;
+}
+
+/// Get the operand of a dot before it is widened to the accumulator type and
+/// before it is transposed, setting `transposed` in the latter case.
+///
+/// The matmul casts its operands to the accumulator type in its region, and
+/// reads a transposed operand through its indexing map. Folding them avoids
+/// materializing a widened or transposed copy of the operand, e.g. the i8
+/// operands of a quantized kernel, or `k` in `tl.dot(q, tl.trans(k))`.
+static Value getDotOperand(ConversionPatternRewriter &rewriter, Value operand,
+                           Value convertedOperand, bool &transposed) {
+  transposed = false;
+  bool widened = false;
+  Value source = operand;
+  while (Operation *defOp = source.getDefiningOp()) {
+    if (!widened && isa<arith::ExtFOp, arith::ExtSIOp>(defOp)) {
+      widened = true;
+      source = defOp->getOperand(0);
+      continue;
+    }
+    auto transOp = dyn_cast<triton::TransOp>(defOp);
+    if (transposed || !transOp || !isMatmulTranspose(transOp.getOrder()))
+      break;
+    transposed = true;
+    source = transOp.getSrc();
+  }
+  if (source == operand)
+    return convertedOperand;
+  Value remapped = rewriter.getRemappedValue(source);
+  if (!remapped) {
+    transposed = false;
+    return convertedOperand;
+  }
+  return remapped;
+}
+
+/// Create `acc += lhs * rhs` with a `linalg.generic`, reading `lhs` and `rhs`
+/// transposed. This is the case no named matmul covers.
+static Operation *createTransposedMatmul(OpBuilder &builder, Location loc,
+                                         Value lhs, Value rhs, Value acc) {
+  MLIRContext *ctx = builder.getContext();
+  int64_t rank = acc.getType().cast<ShapedType>().getRank();
+  // Dims are (batch..., m, n, k).
+  SmallVector<AffineExpr> batchDims;
+  for (int64_t i = 0; i < rank - 2; ++i)
+    batchDims.push_back(getAffineDimExpr(i, ctx));
+  AffineExpr m = getAffineDimExpr(rank - 2, ctx);
+  AffineExpr n = getAffineDimExpr(rank - 1, ctx);
+  AffineExpr k = getAffineDimExpr(rank, ctx);
+  auto getMap = [&](AffineExpr d0, AffineExpr d1) {
+    SmallVector<AffineExpr> exprs(batchDims);
+    exprs.append({d0, d1});
+    return AffineMap::get(rank + 1, 0, exprs, ctx);
+  };
+  SmallVector<AffineMap> indexingMaps = {getMap(k, m), getMap(n, k),
+                                         getMap(m, n)};
+  SmallVector<utils::IteratorType> iteratorTypes(rank,
+                                                 utils::IteratorType::parallel);
+  iteratorTypes.push_back(utils::IteratorType::reduction);
+  Type accElemTy = getElementTypeOrSelf(acc);
+  return builder.create<linalg::GenericOp>(
+      loc, TypeRange{acc.getType()}, ValueRange{lhs, rhs}, ValueRange{acc},
+      indexingMaps, iteratorTypes,
+      [&](OpBuilder &b, Location loc, ValueRange args) {
+        Value lhsElem = convertScalarToDtype(b, loc, args[0], accElemTy,
+                                             /*isUnsignedCast=*/false);
+        Value rhsElem = convertScalarToDtype(b, loc, args[1], accElemTy,
+                                             /*isUnsignedCast=*/false);
+        Value ret;
+        if (accElemTy.isa<FloatType>()) {
+          ret = b.create<arith::MulFOp>(loc, lhsElem, rhsElem);
+          ret = b.create<arith::AddFOp>(loc, args[2], ret);
+        } else {
+          ret = b.create<arith::MulIOp>(loc, lhsElem, rhsElem);
+          ret = b.create<arith::AddIOp>(loc, args[2], ret);
+        }
+        b.create<linalg::YieldOp>(loc, ret);
+      });
+}
+
+template <typename OpTy>
+static Operation *createNamedMatmul(OpBuilder &b, Location loc, Value lhs,
+                                    Value rhs, Value acc) {
+  return b.create<OpTy>(loc, TypeRange{acc.getType()}, ValueRange{lhs, rhs},
+                        acc);
+}
+
+/// Create `acc += lhs * rhs` with a matmul, batched if the operands are 3-d,
+/// reading the operands marked as transposed through the indexing maps.
+static Value createMatmul(OpBuilder &b, Location loc, Value lhs, Value rhs,
+                          Value acc, bool allowTf32, bool lhsTransposed,
+                          bool rhsTransposed) {
+  bool batched = acc.getType().cast<ShapedType>().getRank() == 3;
+  Operation *matmulOp;
+  if (lhsTransposed && rhsTransposed) {
+    matmulOp = createTransposedMatmul(b, loc, lhs, rhs, acc);
+  } else if (lhsTransposed) {
+    matmulOp =
+        batched
+            ? createNamedMatmul<linalg::BatchMatmulTransposeAOp>(b, loc, lhs,
+                                                                 rhs, acc)
+            : createNamedMatmul<linalg::MatmulTransposeAOp>(b, loc, lhs, rhs,
+                                                            acc);
+  } else if (rhsTransposed) {
+    matmulOp =
+        batched
+            ? createNamedMatmul<linalg::BatchMatmulTransposeBOp>(b, loc, lhs,
+                                                                 rhs, acc)
+            : createNamedMatmul<linalg::MatmulTransposeBOp>(b, loc, lhs, rhs,
+                                                            acc);
+  } else {
+    matmulOp =
+        batched
+            ? createNamedMatmul<linalg::BatchMatmulOp>(b, loc, lhs, rhs, acc)
+            : createNamedMatmul<linalg::MatmulOp>(b, loc, lhs, rhs, acc);
+  }
+  if (allowTf32)
+    matmulOp->setAttr(getAttrAllowTF32(), b.getUnitAttr());
+  return matmulOp->getResult(0);
+}
+
+/// Split the f32 `value` into its tf32 part `big` and the remainder `small`,
+/// with `value == big + small` exactly.
+static std::pair<Value, Value> splitTF32(OpBuilder &builder, Location loc,
+                                         Value value) {
+  auto type = value.getType().cast<RankedTensorType>();
+  Value bigInit = builder.create<tensor::EmptyOp>(loc, type.getShape(),
+                                                  type.getElementType());
+  auto bigOp = builder.create<linalg::MapOp>(
+      loc, ValueRange{value}, bigInit,
+      [&](OpBuilder &b, Location loc, ValueRange args) {
+        // Clear the 13 low bits of the f32 mantissa, which tf32 drops.
+        Value bits = b.create<arith::BitcastOp>(loc, b.getI32Type(), args[0]);
+        Value mask = b.create<arith::ConstantIntOp>(loc, ~int64_t(0x1fff),
+                                                    b.getI32Type());
+        bits = b.create<arith::AndIOp>(loc, bits, mask);
+        Value ret = b.create<arith::BitcastOp>(loc, b.getF32Type(), bits);
+        b.create<linalg::YieldOp>(loc, ret);
+      });
+  Value big = bigOp->getResult(0);
+  Value smallInit = builder.create<tensor::EmptyOp>(loc, type.getShape(),
+                                                    type.getElementType());
+  auto smallOp = builder.create<linalg::MapOp>(
+      loc, ValueRange{value, big}, smallInit,
+      [&](OpBuilder &b, Location loc, ValueRange args) {
+        Value ret = b.create<arith::SubFOp>(loc, args[0], args[1]);
+        b.create<linalg::YieldOp>(loc, ret);
+      });
+  Value small = smallOp->getResult(0);
+  return {big, small};
+}
+
 namespace {
 
 /// Convert an `triton.broadcast` operation to `linalg.broadcast/linalg.fill`
@@ -481,25 +834,54 @@ struct TritonMakeRangePattern
   }
 };
 
+/// Convert `tt.dot` to `linalg.matmul`, or `linalg.batch_matmul` for 3-d
+/// operands.
+///
+/// - Operands widened by `arith.extf` or `arith.extsi` are used before the
+///   widening, so that fp16/bf16 with f32 accumulation and i8 with i32
+///   accumulation lower to a mixed precision matmul casting in its region.
+/// - Operands transposed by `tt.trans` are used before the transpose, with
+///   `linalg.matmul_transpose_a/b`, or a `linalg.generic` reading both
+///   operands transposed.
+/// - TF32 sets `__allow_tf32__` on the matmul.
+/// - TF32x3 of f32 operands is emulated by splitting each operand `x` into
+///   its tf32 part `x_big` and the remainder `x_small`, and accumulating
+///   `a_small * b_big`, `a_big * b_small` and `a_big * b_big` with three tf32
+///   matmuls, the smallest terms first.
 struct TritonDotPattern : public OpConversionPattern<triton::DotOp> {
   using OpConversionPattern<triton::DotOp>::OpConversionPattern;
 
   LogicalResult
   matchAndRewrite(triton::DotOp op, OpAdaptor adaptor,
                   ConversionPatternRewriter &rewriter) const override {
-    Value input = adaptor.getA();
-    Value filter = adaptor.getB();
-    Value bias = adaptor.getC();
-    auto matmulOp = rewriter.replaceOpWithNewOp<linalg::MatmulOp>(
-        op, TypeRange{op.getType()}, ValueRange{input, filter}, bias);
+    Location loc = op.getLoc();
+    bool lhsTransposed, rhsTransposed;
+    Value lhs =
+        getDotOperand(rewriter, op.getA(), adaptor.getA(), lhsTransposed);
+    Value rhs =
+        getDotOperand(rewriter, op.getB(), adaptor.getB(), rhsTransposed);
+    Value acc = adaptor.getC();
+    auto createDotMatmul = [&](Value a, Value b, Value c, bool allowTf32) {
+      return createMatmul(rewriter, loc, a, b, c, allowTf32, lhsTransposed,
+                          rhsTransposed);
+    };
 
     auto inputPrecision = op.getInputPrecision();
-    if (inputPrecision == triton::InputPrecision::TF32x3)
-      return op->emitError("Unsupport tf32x3 precision mode");
+    bool isF32 = getElementTypeOrSelf(lhs).isF32() &&
+                 getElementTypeOrSelf(rhs).isF32();
+    if (inputPrecision != triton::InputPrecision::TF32x3 || !isF32) {
+      // Operands narrower than f32, e.g. widened from f16, are exact in tf32.
+      bool allowTf32 = inputPrecision == triton::InputPrecision::TF32;
+      rewriter.replaceOp(op, createDotMatmul(lhs, rhs, acc, allowTf32));
+      return success();
+    }
 
-    bool allowTf32 = (inputPrecision == triton::InputPrecision::TF32);
-    if (allowTf32)
-      matmulOp->setAttr(getAttrAllowTF32(), UnitAttr::get(op->getContext()));
+    auto [lhsBig, lhsSmall] = splitTF32(rewriter, loc, lhs);
+    auto [rhsBig, rhsSmall] = splitTF32(rewriter, loc, rhs);
+    acc = createDotMatmul(lhsSmall, rhsBig, acc, /*allowTf32=*/true);
+    acc = createDotMatmul(lhsBig, rhsSmall, acc, /*allowTf32=*/true);
+    acc = createDotMatmul(lhsBig, rhsBig, acc, /*allowTf32=*/true);
+    rewriter.replaceOp(op, acc);
     return success();
   }
 };
@@ -537,6 +919,30 @@ struct TritonBitcastPattern : public OpConversionPattern<triton::BitcastOp> {
   }
 };
 
+/// Lower an elementwise extern call on tensors to a libdevice_call, which
+/// the linalg_ext transforms bind to an implementation.
+struct TritonExternElementwisePattern
+    : public OpConversionPattern<triton::ExternElementwiseOp> {
+  using OpConversionPattern<triton::ExternElementwiseOp>::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(triton::ExternElementwiseOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto resultTy = op.getType().dyn_cast<RankedTensorType>();
+    if (!resultTy || resultTy.getElementType().isa<triton::PointerType>())
+      return failure();
+    Value init = rewriter.create<tensor::EmptyOp>(
+        op.getLoc(), resultTy.getShape(), resultTy.getElementType());
+    auto callOp =
+        rewriter.replaceOpWithNewOp<triton::linalg_ext::LibdeviceCallOp>(
+            op, adaptor.getSrcs(), init, op.getSymbol());
+    callOp.setLibname(op.getLibname());
+    callOp.setLibpath(op.getLibpath());
+    callOp.setPure(op.getPure());
+    return success();
+  }
+};
+
 struct TritonReducePattern : public OpConversionPattern<triton::ReduceOp> {
   using OpConversionPattern<triton::ReduceOp>::OpConversionPattern;
 
@@ -570,64 +976,49 @@ struct TritonReducePattern : public OpConversionPattern<triton::ReduceOp> {
           return RankedTensorType::get(resultShape, t.getElementType());
         });
 
-    llvm::SmallVector<Value> initVals;
-    // As we need to analysis the body of reduce op to get the init value,
-    // currently we only support single paylod op. Otherwise, We use a portion
-    // of the input as the initial value for the output.
-    do {
-      if (op.getNumResults() == 1) {
-        Operation *payloadOp =
-            linalg_ext::findPayloadOp(&op.getCombineOp().front());
-        if (!payloadOp)
-          break;
-        std::optional<TypedAttr> fillValAttr =
-            triton::getNeutralElement(payloadOp);
-        // When the requirements are not met, go to the later general
-        // implementation.
-        if (!fillValAttr.has_value())
-          break;
-        Value fillVal =
-            rewriter.create<arith::ConstantOp>(loc, fillValAttr.value());
-        // Create empty vectors as init values.
-        for (TensorType t : convertedResultTensorTypes) {
-          auto initOp = rewriter.create<tensor::EmptyOp>(loc, t.getShape(),
-                                                         t.getElementType());
-          auto fillOp =
-              rewriter.create<linalg::FillOp>(loc, fillVal, initOp.getResult());
-          initVals.push_back(fillOp.getResult(0));
-        }
-
-        // Create a linalg.reduce on the same input and move the combine region
-        // there. (ReduceReturnOpConversion will take care of the terminator.)
-        auto reduceOp = rewriter.create<linalg::ReduceOp>(
-            loc, /*resultTypes=*/SmallVector<Type>(convertedResultTensorTypes),
-            /*inputs=*/adaptor.getOperands(), /*inits=*/initVals,
-            /*dimensions=*/ArrayRef<int64_t>{op.getAxis()});
-        rewriter.inlineRegionBefore(op.getCombineOp(), reduceOp.getCombiner(),
-                                    reduceOp.getCombiner().end());
-
-        // If the result on tt.reduce are tensors with rank > 0, we are done.
-        if (!resultShape.empty()) {
-          rewriter.replaceOp(op, reduceOp.getResults());
-          return success();
-        }
-
-        // Otherwise, the result has to be a scalar, so we need to extract the
-        // scalar from the 0-ranked result tensor.
-        SmallVector<Value> results;
+    // If the results are scalar, we need to extract the scalar from the
+    // 0-ranked result tensor.
+    auto getFinalResults = [&](ValueRange results) -> SmallVector<Value> {
+      if (!resultShape.empty())
+        return results;
+      SmallVector<Value> extractResults;
+      for (auto [tensor, type] :
+           llvm::zip(results, convertedResultTensorTypes)) {
         Value scalar = rewriter.create<tensor::ExtractOp>(
-            loc,
-            SmallVector<Type>(convertedResultTensorTypes)
-                .begin()
-                ->dyn_cast<RankedTensorType>()
-                .getElementType(),
-            reduceOp->getResults()[0], /*indices=*/ValueRange{});
-        results.push_back(scalar);
-        rewriter.replaceOp(op, results);
-
-        return success();
+            loc, type.getElementType(), tensor, /*indices=*/ValueRange{});
+        extractResults.push_back(scalar);
+      }
+      return extractResults;
+    };
+
+    llvm::SmallVector<Value> initVals;
+    // As we need to analysis the body of reduce op to get the init values,
+    // only combiners whose results are all recognized, such as a single
+    // payload op or argmax, are filled with neutral elements. Otherwise, We
+    // use a portion of the input as the initial value for the output.
+    if (auto neutralElements = getReduceNeutralElements(op)) {
+      // Create empty vectors filled with neutral elements as init values.
+      for (auto [t, neutralElement] :
+           llvm::zip(convertedResultTensorTypes, *neutralElements)) {
+        Value fillVal = rewriter.create<arith::ConstantOp>(loc, neutralElement);
+        auto initOp = rewriter.create<tensor::EmptyOp>(loc, t.getShape(),
+                                                       t.getElementType());
+        auto fillOp =
+            rewriter.create<linalg::FillOp>(loc, fillVal, initOp.getResult());
+        initVals.push_back(fillOp.getResult(0));
       }
-    } while (false);
+
+      // Create a linalg.reduce on the same input and move the combine region
+      // there. (ReduceReturnOpConversion will take care of the terminator.)
+      auto reduceOp = rewriter.create<linalg::ReduceOp>(
+          loc, /*resultTypes=*/SmallVector<Type>(convertedResultTensorTypes),
+          /*inputs=*/adaptor.getOperands(), /*inits=*/initVals,
+          /*dimensions=*/ArrayRef<int64_t>{op.getAxis()});
+      rewriter.inlineRegionBefore(op.getCombineOp(), reduceOp.getCombiner(),
+                                  reduceOp.getCombiner().end());
+      rewriter.replaceOp(op, getFinalResults(reduceOp.getResults()));
+      return success();
+    }
 
     llvm::SmallVector<Value> inputVals;
     // To lowering to linalg.reduce, we use the first slice of the reduction
@@ -683,21 +1074,6 @@ struct TritonReducePattern : public OpConversionPattern<triton::ReduceOp> {
       }
     }
 
-    // If the results are scalar, we need to extract the scalar from the
-    // 0-ranked result tensor.
-    auto getFinalResults = [&](ValueRange results) -> SmallVector<Value> {
-      if (!resultShape.empty())
-        return results;
-      SmallVector<Value> extractResults;
-      for (auto [tensor, type] :
-           llvm::zip(results, convertedResultTensorTypes)) {
-        Value scalar = rewriter.create<tensor::ExtractOp>(
-            loc, type.getElementType(), tensor, /*indices=*/ValueRange{});
-        extractResults.push_back(scalar);
-      }
-      return extractResults;
-    };
-
     // If the the size of reduce axis is 1, we just replace the init operands by
     // input operands.
     if (inputVals.empty()) {
@@ -1125,7 +1501,8 @@ struct TritonScanPattern : public OpConversionPattern<triton::ScanOp> {
 
       // 1. Slice the remaining elements of input operands.
       {
-        Value slice = sliceRemaining(rewriter, loc, inputVal, op.getAxis());
+        Value slice = sliceRemaining(rewriter, loc, inputVal, op.getAxis(),
+                                     op.getReverse());
         // Create output tensor
         auto sliceShape = slice.getType().cast<ShapedType>().getShape();
         Value empty = rewriter.create<tensor::EmptyOp>(
@@ -1134,10 +1511,11 @@ struct TritonScanPattern : public OpConversionPattern<triton::ScanOp> {
         initVals.push_back(empty);
       }
 
-      // 2. Slice the first elements of input operands, and use them as init
-      //    operands' init value.
+      // 2. Slice the first elements of input operands, or the last ones for a
+      //    reverse scan, and use them as init operands' init value.
       {
-        Value slice = sliceFirst(rewriter, loc, inputVal, op.getAxis());
+        Value slice = sliceFirst(rewriter, loc, inputVal, op.getAxis(),
+                                 op.getReverse());
         // Create the reshape of slice tensor.
         SmallVector<Value> reshapeSizes;
         SmallVector<int64_t> reshapeShape;
@@ -1167,7 +1545,8 @@ struct TritonScanPattern : public OpConversionPattern<triton::ScanOp> {
     auto scanOp = rewriter.create<linalg_ext::ScanOp>(
         loc, /*resultTypes=*/SmallVector<Type>(resultTypes),
         /*inputs=*/inputVals, /*inits=*/initVals,
-        /*dimensions=*/ArrayRef<int64_t>{op.getAxis()});
+        /*dimensions=*/ArrayRef<int64_t>{op.getAxis()},
+        /*reverse=*/op.getReverse());
     auto &block = op->getRegion(0).front();
     block.addArgument(block.getArgumentTypes()[0], loc);
     rewriter.replaceAllUsesWith(block.getArgument(1), block.getArgument(2));
@@ -1186,7 +1565,8 @@ struct TritonScanPattern : public OpConversionPattern<triton::ScanOp> {
 
     // Retrieve insert offsets of result tensor.
     SmallVector<OpFoldResult> insertOffsets(rank, rewriter.getIndexAttr(0));
-    insertOffsets[op.getAxis()] = rewriter.getIndexAttr(1);
+    if (!op.getReverse())
+      insertOffsets[op.getAxis()] = rewriter.getIndexAttr(1);
 
     // Retrieve insert strides of result tensor.
     SmallVector<OpFoldResult> insertStrides(rank, rewriter.getIndexAttr(1));
@@ -1225,12 +1605,12 @@ populateTritonToLinalgPatterns(RewritePatternSet &patterns,
   patterns
       .add<TritonBroadcastPattern, TritonSplatPattern, TritonExpandDimPattern,
            TritonAddPtrPattern, TritonMakeRangePattern, TritonDotPattern,
-           TritonBitcastPattern, TritonReducePattern, TritonReduceReturnPattern,
-           TritonPtrToIntPattern,
-           TritonIntToPtrPattern, TritonTransPattern, TritonReturnOpConversion,
-           TritonCallOpPattern, TritonFuncOpPattern, TritonViewPattern,
-           TritonPrintPattern, TritonAssertOpPattern, TritonScanPattern,
-           TritonScanReturnPattern>(converter, context);
+           TritonBitcastPattern, TritonExternElementwisePattern,
+           TritonReducePattern, TritonReduceReturnPattern,
+           TritonPtrToIntPattern, TritonIntToPtrPattern, TritonTransPattern,
+           TritonReturnOpConversion, TritonCallOpPattern, TritonFuncOpPattern,
+           TritonViewPattern, TritonPrintPattern, TritonAssertOpPattern,
+           TritonScanPattern, TritonScanReturnPattern>(converter, context);
 }
 
 static void populateArithConversionPatterns(RewritePatternSet &patterns) {
@@ -1239,16 +1619,35 @@ static void populateArithConversionPatterns(RewritePatternSet &patterns) {
 }
 
 namespace {
+/// Fold the casts inserted by convert-triton-func-to-func, which bridge the
+/// converted function arguments back to triton pointers, e.g.
+///
+/// ```mlir
+///   %0 = builtin.unrealized_conversion_cast %arg0 : i64 to !tt.ptr<f32>
+/// ```
+class TritonArgCastPattern
+    : public OpConversionPattern<UnrealizedConversionCastOp> {
+public:
+  using OpConversionPattern<UnrealizedConversionCastOp>::OpConversionPattern;
 
-struct TritonToLinalgPass : public TritonToLinalgPassBase<TritonToLinalgPass> {
-  void runOnOperation() override;
+  LogicalResult
+  matchAndRewrite(UnrealizedConversionCastOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (op->getNumOperands() != 1 || op->getNumResults() != 1)
+      return failure();
+    Type convertedType =
+        getTypeConverter()->convertType(op->getResult(0).getType());
+    if (!convertedType || convertedType != adaptor.getInputs()[0].getType())
+      return failure();
+    rewriter.replaceOp(op, adaptor.getInputs());
+    return success();
+  }
 };
 } // namespace
 
-void TritonToLinalgPass::runOnOperation() {
-  MLIRContext *context = &getContext();
-  TritonLinalgTypeConverter converter;
-  ConversionTarget target(*context);
+/// Set up the legality shared by the module and function level conversions.
+static void configureTritonToLinalgTarget(ConversionTarget &target,
+                                          TritonLinalgTypeConverter &converter) {
   target.addLegalDialect<BuiltinDialect, func::FuncDialect>();
   target.addIllegalDialect<triton::TritonDialect, gpu::GPUDialect>();
   // Mark MakeTensorOp and AdvanceOp as legal op, it will be erased by cse.
@@ -1275,33 +1674,154 @@ void TritonToLinalgPass::runOnOperation() {
     return !resType.isa<ShapedType>() && converter.isLegal(op);
     ;
   });
-  target.addLegalOp<triton::GetProgramIdOp, triton::GetNumProgramsOp,
-                    triton::ExternElementwiseOp>();
-
-  auto solver = std::make_unique<mlir::DataFlowSolver>();
-  solver->load<mlir::dataflow::DeadCodeAnalysis>();
-  solver->load<mlir::dataflow::SparseConstantPropagation>();
-  solver->load<AxisInfoAnalysisExt>();
-  if (failed(solver->initializeAndRun(getOperation())))
+  target.addLegalOp<triton::GetProgramIdOp, triton::GetNumProgramsOp>();
+  // The extern calls on tensors of values are lowered to libdevice_call.
+  target.addDynamicallyLegalOp<triton::ExternElementwiseOp>([](Operation *op) {
+    auto resultTy = op->getResultTypes().front().dyn_cast<RankedTensorType>();
+    return !resultTy || resultTy.getElementType().isa<triton::PointerType>();
+  });
+}
+
+namespace {
+
+/// The conversion of the Triton dialect into the Linalg dialect shared by
+/// convert-triton-to-linalg and convert-triton-to-linalg-func, which also
+/// accounts the memory access lowerings in the pass statistics.
+template <typename DerivedT, template <typename> class BaseT>
+struct TritonToLinalgPassImpl : public BaseT<DerivedT> {
+protected:
+  LogicalResult convert(TritonLinalgTypeConverter &converter,
+                        ConversionTarget &target, RewritePatternSet &patterns);
+};
+
+struct TritonToLinalgPass
+    : public TritonToLinalgPassImpl<TritonToLinalgPass,
+                                    TritonToLinalgPassBase> {
+  void runOnOperation() override;
+};
+
+struct TritonFuncToFuncPass
+    : public TritonFuncToFuncPassBase<TritonFuncToFuncPass> {
+  void runOnOperation() override;
+};
+
+struct TritonToLinalgFuncPass
+    : public TritonToLinalgPassImpl<TritonToLinalgFuncPass,
+                                    TritonToLinalgFuncPassBase> {
+  void runOnOperation() override;
+};
+} // namespace
+
+template <typename DerivedT, template <typename> class BaseT>
+LogicalResult TritonToLinalgPassImpl<DerivedT, BaseT>::convert(
+    TritonLinalgTypeConverter &converter, ConversionTarget &target,
+    RewritePatternSet &patterns) {
+  // Reuse the axis info computed by a previous pass if it is still valid.
+  auto &axisInfo = this->template getAnalysis<AxisInfoSolverAnalysis>();
+  if (failed(axisInfo.getStatus()))
+    return failure();
+
+  LoweringStatistics statistics;
+  populateAllTritonToLinalgPattern(patterns, converter, target,
+                                   axisInfo.getSolver(), &statistics);
+  if (failed(applyPartialConversion(this->getOperation(), target,
+                                    std::move(patterns))))
+    return failure();
+
+  // Only account the lowerings once the conversion is committed.
+  this->numContiguous +=
+      statistics.getNumLowerings(MemAccessLowering::Contiguous);
+  this->numScalar += statistics.getNumLowerings(MemAccessLowering::Scalar);
+  this->numScattered +=
+      statistics.getNumLowerings(MemAccessLowering::Scattered);
+  this->numTensorPointer +=
+      statistics.getNumLowerings(MemAccessLowering::TensorPointer);
+  this->numContiguousMissed += statistics.getNumMissed();
+  if (this->emitRemarks)
+    statistics.emitRemarks();
+  return success();
+}
+
+void TritonToLinalgPass::runOnOperation() {
+  MLIRContext *context = &getContext();
+  TritonLinalgTypeConverter converter;
+  ConversionTarget target(*context);
+  configureTritonToLinalgTarget(target, converter);
+
+  RewritePatternSet patterns(context);
+  if (failed(convert(converter, target, patterns)))
     return signalPassFailure();
+}
+
+void TritonFuncToFuncPass::runOnOperation() {
+  MLIRContext *context = &getContext();
+  ModuleOp module = getOperation();
+  TritonLinalgTypeConverter converter;
 
-  // Rewrite patterns.
+  // TritonFuncOpPattern drops the argument attributes, keep the axis info
+  // hints for the function level conversion.
+  llvm::StringMap<ArrayAttr> argAttrs;
+  for (auto func : module.getOps<triton::FuncOp>()) {
+    if (ArrayAttr attrs = func.getAllArgAttrs())
+      argAttrs[func.getName()] = attrs;
+  }
+
+  ConversionTarget target(*context);
+  target.addIllegalOp<triton::FuncOp, triton::CallOp, triton::ReturnOp>();
+  target.markUnknownOpDynamicallyLegal([](Operation *) { return true; });
   RewritePatternSet patterns(context);
-  populateAllTritonToLinalgPattern(patterns, converter, target, *solver);
+  patterns.add<TritonReturnOpConversion, TritonCallOpPattern,
+               TritonFuncOpPattern>(converter, context);
+  if (failed(applyPartialConversion(module, target, std::move(patterns))))
+    return signalPassFailure();
+
+  for (auto func : module.getOps<func::FuncOp>()) {
+    auto it = argAttrs.find(func.getName());
+    if (it != argAttrs.end())
+      func.setAllArgAttrs(it->second);
+  }
+}
+
+void TritonToLinalgFuncPass::runOnOperation() {
+  MLIRContext *context = &getContext();
+  func::FuncOp func = getOperation();
+  TritonLinalgTypeConverter converter;
+  ConversionTarget target(*context);
+  configureTritonToLinalgTarget(target, converter);
+  target.addDynamicallyLegalOp<UnrealizedConversionCastOp>(
+      [&](Operation *op) { return converter.isLegal(op->getResultTypes()); });
 
-  if (failed(
-          applyPartialConversion(getOperation(), target, std::move(patterns))))
+  // Each function gets its own axis info solver in `convert`, so functions
+  // are solved in parallel.
+  RewritePatternSet patterns(context);
+  patterns.add<TritonArgCastPattern>(converter, context);
+  if (failed(convert(converter, target, patterns)))
     return signalPassFailure();
+
+  // The axis info hints are consumed, drop them as convert-triton-to-linalg
+  // does.
+  for (unsigned i = 0, e = func.getNumArguments(); i < e; ++i) {
+    for (StringRef hint : {"tt.divisibility", "tt.contiguity", "tt.constancy"})
+      func.removeArgAttr(i, hint);
+  }
 }
 
 std::unique_ptr<mlir::Pass> mlir::triton::createTritonToLinalgPass() {
   return std::make_unique<TritonToLinalgPass>();
 }
 
-void mlir::triton::populateAllTritonToLinalgPattern(RewritePatternSet &patterns,
-                                                    TritonLinalgTypeConverter &converter,
-                                                    ConversionTarget &target,
-                                                    mlir::DataFlowSolver &solver) {
+std::unique_ptr<mlir::Pass> mlir::triton::createTritonFuncToFuncPass() {
+  return std::make_unique<TritonFuncToFuncPass>();
+}
+
+std::unique_ptr<mlir::Pass> mlir::triton::createTritonToLinalgFuncPass() {
+  return std::make_unique<TritonToLinalgFuncPass>();
+}
+
+void mlir::triton::populateAllTritonToLinalgPattern(
+    RewritePatternSet &patterns, TritonLinalgTypeConverter &converter,
+    ConversionTarget &target, mlir::DataFlowSolver &solver,
+    LoweringStatistics *statistics) {
   auto *context = patterns.getContext();
   scf::populateSCFStructuralTypeConversionsAndLegality(converter, patterns,
                                                        target);
@@ -1313,8 +1833,11 @@ void mlir::triton::populateAllTritonToLinalgPattern(RewritePatternSet &patterns,
   populateArithConversionPatterns(patterns);
   populateMathToLinalgPatterns(patterns);
 
-  populateTritonLoadStoreToLinalgPatterns(patterns, converter, solver);
-  populateTritonAtomicCASToLinalgPatterns(patterns, converter, solver);
-  populateTritonAtomicRmwToLinalgPatterns(patterns, converter, solver);
+  populateTritonLoadStoreToLinalgPatterns(patterns, converter, solver,
+                                          statistics);
+  populateTritonAtomicCASToLinalgPatterns(patterns, converter, solver,
+                                          statistics);
+  populateTritonAtomicRmwToLinalgPatterns(patterns, converter, solver,
+                                          statistics);
 
 }
@@ -9,6 +9,7 @@
 #include "triton-linalg/Conversion/TritonToLinalg/Utils.h"
 #include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtOps.h"
 #include "triton-linalg/Dialect/Utils/ArithUtils.h"
+#include "triton-linalg/Dialect/Utils/Conventions.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Arith/Utils/Utils.h"
 #include "mlir/Dialect/Linalg/IR/LinalgInterfaces.h"
@@ -123,3 +124,36 @@ StringAttr mlir::triton::getCacheModeAttr(MLIRContext *context,
     return nullptr;
   }
 }
+
+EvictModeAttr mlir::triton::getEvictModeAttr(MLIRContext *context,
+                                              triton::EvictionPolicy policy) {
+  switch (policy) {
+  case triton::EvictionPolicy::EVICT_FIRST:
+    return EvictModeAttr::get(context, EvictMode::evict_first);
+  case triton::EvictionPolicy::EVICT_LAST:
+    return EvictModeAttr::get(context, EvictMode::evict_last);
+  default:
+    return nullptr;
+  }
+}
+
+MemoryHints mlir::triton::getMemoryHints(triton::LoadOp op) {
+  return {getCacheModeAttr(op.getContext(), op.getCache()),
+          getEvictModeAttr(op.getContext(), op.getEvict()),
+          op.getIsVolatile()};
+}
+
+MemoryHints mlir::triton::getMemoryHints(triton::StoreOp op) {
+  return {getCacheModeAttr(op.getContext(), op.getCache()),
+          getEvictModeAttr(op.getContext(), op.getEvict()),
+          /*isVolatile=*/false};
+}
+
+void mlir::triton::setMemoryHints(Operation *op, const MemoryHints &hints) {
+  if (hints.cacheMode)
+    op->setAttr(getCacheModeAttrKey(), hints.cacheMode);
+  if (hints.evictMode)
+    op->setAttr(getEvictModeAttrKey(), hints.evictMode);
+  if (hints.isVolatile)
+    op->setAttr(getIsVolatileAttrKey(), UnitAttr::get(op->getContext()));
+}
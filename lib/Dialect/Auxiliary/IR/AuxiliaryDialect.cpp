@@ -12,6 +12,7 @@
 #include <tuple>
 
 #include "triton-linalg/Dialect/Auxiliary/IR/AuxiliaryDialect.h"
+#include "triton-linalg/Dialect/Utils/Conventions.h"
 #include "llvm/ADT/ilist_iterator.h"
 
 #include "mlir/Dialect/LLVMIR/LLVMDialect.h" // IWYU pragma: keep
@@ -281,16 +282,8 @@ LogicalResult ViewOp::verify() {
              << " in dim = " << en.index();
   }
 
-  // Check cache mode legality.
-  auto cacheMode = getCacheMode();
-  if (cacheMode.has_value()) {
-    llvm::SmallVector<std::string, 2> modes{"cmnormal", "cmtransient"};
-    if (llvm::find(modes, cacheMode.value().str()) == modes.end()) {
-      return emitError("expected legal cache mode but found ")
-             << cacheMode.value();
-    }
-  }
-  return success();
+  // Check cache mode and evict mode legality.
+  return verifyMemoryHints(getOperation());
 }
 
 //===----------------------------------------------------------------------===//
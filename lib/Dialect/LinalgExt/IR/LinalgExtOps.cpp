@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtOps.h"
+#include "triton-linalg/Dialect/Utils/Conventions.h"
 #include "triton-linalg/Dialect/Utils/MemRefUtils.h"
 #include "mlir/AsmParser/AsmParser.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
@@ -1052,6 +1053,8 @@ void ScatterOp::build(
 
 LogicalResult ScatterOp::verify() {
   Operation *op = getOperation();
+  if (failed(verifyMemoryHints(op)))
+    return failure();
   if (getNumDpsInputs() != 2 && getNumDpsInputs() != 3) {
     return op->emitOpError("expected two or three input operands");
   }
@@ -1342,6 +1345,8 @@ void GatherOp::build(
 
 LogicalResult GatherOp::verify() {
   Operation *op = getOperation();
+  if (failed(verifyMemoryHints(op)))
+    return failure();
   if (getNumDpsInputs() != 2 && getNumDpsInputs() != 3) {
     return op->emitOpError("expected two or three input operands");
   }
@@ -1477,6 +1482,8 @@ void GatherAtomicRMWOp::build(OpBuilder &builder, OperationState &result,
 
 LogicalResult GatherAtomicRMWOp::verify() {
   Operation *op = getOperation();
+  if (failed(verifyMemoryHints(op)))
+    return failure();
   if (getNumDpsInputs() != 2 && getNumDpsInputs() != 3) {
     return op->emitOpError("expected two or three input operands");
   }
@@ -1490,9 +1497,55 @@ LogicalResult GatherAtomicRMWOp::verify() {
   return success();
 }
 
+//===----------------------------------------------------------------------===//
+// Implementation of AtomicRMWOp
+//===----------------------------------------------------------------------===//
+LogicalResult AtomicRMWOp::verify() {
+  Operation *op = getOperation();
+  if (failed(verifyMemoryHints(op)))
+    return failure();
+  if (getNumDpsInputs() != 2)
+    return op->emitOpError("expected two input operands");
+  auto inputType = getInputType();
+  auto valType = getValType();
+  auto initType = getInitType();
+  if (failed(verifyCompatibleShape(inputType, initType)) ||
+      failed(verifyCompatibleShape(valType, initType))) {
+    return op->emitOpError(
+        "expected input, val and init to have compatible shapes");
+  }
+  if (inputType.getElementType() != initType.getElementType() ||
+      valType.getElementType() != initType.getElementType()) {
+    return op->emitOpError(
+        "expected input, val and init to have the same element type");
+  }
+  return success();
+}
+
+LogicalResult AtomicRMWOp::fold(FoldAdaptor, SmallVectorImpl<OpFoldResult> &) {
+  return foldMemRefCast(*this);
+}
+
+void AtomicRMWOp::getEffects(
+    SmallVectorImpl<SideEffects::EffectInstance<MemoryEffects::Effect>>
+        &effects) {
+  if (!hasPureBufferSemantics()) {
+    effects.emplace_back(MemoryEffects::Read::get(), input(),
+                         SideEffects::DefaultResource::get());
+    effects.emplace_back(MemoryEffects::Write::get(), input(),
+                         SideEffects::DefaultResource::get());
+  }
+  getGenericEffectsImpl(effects, getOperation()->getResults(), getDpsInputs(),
+                        getDpsInits());
+}
+
 //===----------------------------------------------------------------------===//
 // Implementation of AtomicCASOp
 //===----------------------------------------------------------------------===//
+LogicalResult AtomicCASOp::verify() {
+  return verifyMemoryHints(getOperation());
+}
+
 LogicalResult AtomicCASOp::fold(FoldAdaptor, SmallVectorImpl<OpFoldResult> &) {
   return foldMemRefCast(*this);
 }
@@ -1513,6 +1566,10 @@ void AtomicCASOp::getEffects(
 //===----------------------------------------------------------------------===//
 // Implementation of GatherAtomicCASOp
 //===----------------------------------------------------------------------===//
+LogicalResult GatherAtomicCASOp::verify() {
+  return verifyMemoryHints(getOperation());
+}
+
 LogicalResult GatherAtomicCASOp::fold(FoldAdaptor,
                                       SmallVectorImpl<OpFoldResult> &) {
   return foldMemRefCast(*this);
@@ -0,0 +1,293 @@
+//===- CombineAtomicRMW.cpp - Combine atomics of equal indices --*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <optional>
+#include <stdint.h>
+#include <utility>
+
+#include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtOps.h"
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
+#include "mlir/Dialect/Utils/StructuredOpsUtils.h"
+#include "mlir/IR/AffineMap.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Location.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/Value.h"
+#include "mlir/IR/ValueRange.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+/// Get the arith kind of the associative and commutative atomic types, which
+/// can be combined before the atomic.
+static std::optional<arith::AtomicRMWKind>
+getCombinableKind(linalg_ext::AtomicType type) {
+  switch (type) {
+  case linalg_ext::AtomicType::addf:
+    return arith::AtomicRMWKind::addf;
+  case linalg_ext::AtomicType::addi:
+    return arith::AtomicRMWKind::addi;
+  case linalg_ext::AtomicType::andi:
+    return arith::AtomicRMWKind::andi;
+  case linalg_ext::AtomicType::ori:
+    return arith::AtomicRMWKind::ori;
+  case linalg_ext::AtomicType::maximumf:
+    return arith::AtomicRMWKind::maximumf;
+  case linalg_ext::AtomicType::maxs:
+    return arith::AtomicRMWKind::maxs;
+  case linalg_ext::AtomicType::maxu:
+    return arith::AtomicRMWKind::maxu;
+  case linalg_ext::AtomicType::minimumf:
+    return arith::AtomicRMWKind::minimumf;
+  case linalg_ext::AtomicType::mins:
+    return arith::AtomicRMWKind::mins;
+  case linalg_ext::AtomicType::minu:
+    return arith::AtomicRMWKind::minu;
+  default:
+    return std::nullopt;
+  }
+}
+
+/// Create a tensor of `shape` filled with `value`.
+static Value createFilledTensor(OpBuilder &b, Location loc,
+                                ArrayRef<int64_t> shape, TypedAttr value) {
+  Value fillVal = b.create<arith::ConstantOp>(loc, value);
+  Value empty = b.create<tensor::EmptyOp>(loc, shape, value.getType());
+  return b.create<linalg::FillOp>(loc, fillVal, empty).getResult(0);
+}
+
+namespace {
+/// Rewrite a linalg_ext.gather_atomic_rmw marked with `combine_indices` to
+/// issue one atomic per distinct index, with the combination of the values
+/// of all the batches of that index.
+///
+/// For every batch i, among the masked batches of the same index:
+///   first[i] = the first batch;
+///   excl[i]  = the combination of the values of the batches before i;
+///   total[i] = the combination of the values of all the batches.
+/// The first batch of every index issues the atomic with `total`, and batch
+/// i returns `old[first[i]] op excl[i]`, which is what it reads if the
+/// batches are applied in order.
+///
+/// For n batches of w elements, the first batches take O(n^2) compares and
+/// the combination O(n^2 * w) combining ops. Atomics of more than
+/// `maxBatchSize` batches are not rewritten.
+struct CombineAtomicRMWPattern
+    : public OpRewritePattern<linalg_ext::GatherAtomicRMWOp> {
+  CombineAtomicRMWPattern(MLIRContext *context, int64_t maxBatchSize)
+      : OpRewritePattern<linalg_ext::GatherAtomicRMWOp>(context),
+        maxBatchSize(maxBatchSize) {}
+
+  LogicalResult matchAndRewrite(linalg_ext::GatherAtomicRMWOp op,
+                                PatternRewriter &rewriter) const override {
+    std::optional<arith::AtomicRMWKind> kind =
+        getCombinableKind(op.getAtomicType());
+    if (!op.getCombineIndices() || !kind || !op.hasPureTensorSemantics() ||
+        op.getIndexDepth() != 1)
+      return failure();
+    ShapedType inputTy = op.getInputType();
+    if (!inputTy.hasStaticShape())
+      return failure();
+    int64_t batch = inputTy.getDimSize(0);
+    if (batch > maxBatchSize)
+      return failure();
+    int64_t rank = inputTy.getRank();
+    Location loc = op.getLoc();
+    Type elementTy = inputTy.getElementType();
+    Type i8Ty = rewriter.getI8Type();
+
+    Value indice = rewriter.create<tensor::CollapseShapeOp>(
+        loc, op.indice(), SmallVector<ReassociationIndices>{{0, 1}});
+    Value mask = op.mask();
+    if (!mask) {
+      mask = rewriter.create<arith::ConstantOp>(
+          loc, DenseElementsAttr::get(RankedTensorType::get(batch, i8Ty),
+                                      rewriter.getI8IntegerAttr(1)));
+    }
+
+    // Whether the batches i and j are masked and have the same index.
+    auto isSameIndex = [](OpBuilder &b, Location loc, Value xi, Value xj,
+                          Value mi, Value mj) -> Value {
+      Value zero = b.create<arith::ConstantOp>(loc, b.getI8IntegerAttr(0));
+      Value maskI =
+          b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::ne, mi, zero);
+      Value maskJ =
+          b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::ne, mj, zero);
+      Value same =
+          b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq, xi, xj);
+      return b.create<arith::AndIOp>(
+          loc, b.create<arith::AndIOp>(loc, maskI, maskJ), same);
+    };
+
+    // Compute the first batch of the same index of every batch.
+    AffineMap iMap = AffineMap::get(2, 0, rewriter.getAffineDimExpr(0));
+    AffineMap jMap = AffineMap::get(2, 0, rewriter.getAffineDimExpr(1));
+    Value firstInit = createFilledTensor(
+        rewriter, loc, ArrayRef<int64_t>{batch}, rewriter.getIndexAttr(batch));
+    Value first =
+        rewriter
+            .create<linalg::GenericOp>(
+                loc, firstInit.getType(),
+                ValueRange{indice, indice, mask, mask}, firstInit,
+                ArrayRef<AffineMap>{iMap, jMap, iMap, jMap, iMap},
+                ArrayRef<utils::IteratorType>{utils::IteratorType::parallel,
+                                              utils::IteratorType::reduction},
+                [&](OpBuilder &b, Location loc, ValueRange args) {
+                  Value j = b.create<linalg::IndexOp>(loc, 1);
+                  Value same =
+                      isSameIndex(b, loc, args[0], args[1], args[2], args[3]);
+                  Value min = b.create<arith::MinSIOp>(loc, args[4], j);
+                  b.create<linalg::YieldOp>(
+                      loc, b.create<arith::SelectOp>(loc, same, min, args[4])
+                               .getResult());
+                })
+            .getResult(0);
+
+    // Combine the values of the same index, over (i, j, window...).
+    SmallVector<AffineExpr> windowExprs;
+    for (int64_t dim = 1; dim < rank; ++dim)
+      windowExprs.push_back(rewriter.getAffineDimExpr(dim + 1));
+    auto getPairMap = [&](int64_t batchDim, bool withWindow) {
+      SmallVector<AffineExpr> exprs{rewriter.getAffineDimExpr(batchDim)};
+      if (withWindow)
+        exprs.append(windowExprs);
+      return AffineMap::get(rank + 1, 0, exprs, rewriter.getContext());
+    };
+    SmallVector<utils::IteratorType> combineIterTypes(
+        rank + 1, utils::IteratorType::parallel);
+    combineIterTypes[1] = utils::IteratorType::reduction;
+    TypedAttr identity =
+        arith::getIdentityValueAttr(*kind, elementTy, rewriter, loc);
+    Value exclInit =
+        createFilledTensor(rewriter, loc, inputTy.getShape(), identity);
+    Value totalInit =
+        createFilledTensor(rewriter, loc, inputTy.getShape(), identity);
+    auto combineOp = rewriter.create<linalg::GenericOp>(
+        loc, TypeRange{exclInit.getType(), totalInit.getType()},
+        ValueRange{indice, indice, mask, mask, op.input()},
+        ValueRange{exclInit, totalInit},
+        ArrayRef<AffineMap>{getPairMap(0, false), getPairMap(1, false),
+                            getPairMap(0, false), getPairMap(1, false),
+                            getPairMap(1, true), getPairMap(0, true),
+                            getPairMap(0, true)},
+        combineIterTypes, [&](OpBuilder &b, Location loc, ValueRange args) {
+          Value i = b.create<linalg::IndexOp>(loc, 0);
+          Value j = b.create<linalg::IndexOp>(loc, 1);
+          Value same = isSameIndex(b, loc, args[0], args[1], args[2], args[3]);
+          Value before = b.create<arith::AndIOp>(
+              loc, same,
+              b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::ult, j, i));
+          Value in = args[4], excl = args[5], total = args[6];
+          Value newExcl = b.create<arith::SelectOp>(
+              loc, before, arith::getReductionOp(*kind, b, loc, excl, in),
+              excl);
+          Value newTotal = b.create<arith::SelectOp>(
+              loc, same, arith::getReductionOp(*kind, b, loc, total, in),
+              total);
+          b.create<linalg::YieldOp>(loc, ValueRange{newExcl, newTotal});
+        });
+    Value excl = combineOp.getResult(0);
+    Value total = combineOp.getResult(1);
+
+    // Only the first batch of every index issues the atomic.
+    Value newMaskInit = rewriter.create<tensor::EmptyOp>(
+        loc, ArrayRef<int64_t>{batch}, i8Ty);
+    AffineMap idMap = rewriter.getMultiDimIdentityMap(1);
+    Value newMask =
+        rewriter
+            .create<linalg::GenericOp>(
+                loc, newMaskInit.getType(), ValueRange{mask, first},
+                newMaskInit, ArrayRef<AffineMap>{idMap, idMap, idMap},
+                ArrayRef<utils::IteratorType>{utils::IteratorType::parallel},
+                [&](OpBuilder &b, Location loc, ValueRange args) {
+                  Value i = b.create<linalg::IndexOp>(loc, 0);
+                  Value isFirst = b.create<arith::CmpIOp>(
+                      loc, arith::CmpIPredicate::eq, args[1], i);
+                  Value newMask = b.create<arith::SelectOp>(
+                      loc, isFirst, args[0],
+                      b.create<arith::ConstantOp>(loc, b.getI8IntegerAttr(0)));
+                  b.create<linalg::YieldOp>(loc, newMask);
+                })
+            .getResult(0);
+
+    ShapedType windowTy = op.window().getType().cast<ShapedType>();
+    Value newWindow = rewriter.create<tensor::EmptyOp>(
+        loc, windowTy.getShape(), windowTy.getElementType());
+    auto atomicOp = rewriter.create<linalg_ext::GatherAtomicRMWOp>(
+        loc, ValueRange{total, op.indice(), newMask},
+        ValueRange{op.src(), newWindow}, op.getAtomicType());
+    atomicOp.setCacheModeAttr(op.getCacheModeAttr());
+    atomicOp.setEvictModeAttr(op.getEvictModeAttr());
+    atomicOp.setIsVolatile(op.getIsVolatile());
+    Value old = atomicOp.getResult()[1];
+
+    // Every batch reads the value left by the batches before it.
+    AffineMap windowMap = rewriter.getMultiDimIdentityMap(rank);
+    Value resultInit = rewriter.create<tensor::EmptyOp>(
+        loc, windowTy.getShape(), windowTy.getElementType());
+    Value result =
+        rewriter
+            .create<linalg::GenericOp>(
+                loc, windowTy, ValueRange{op.window(), excl}, resultInit,
+                ArrayRef<AffineMap>{windowMap, windowMap, windowMap},
+                SmallVector<utils::IteratorType>(rank,
+                                                 utils::IteratorType::parallel),
+                [&](OpBuilder &b, Location loc, ValueRange args) {
+                  SmallVector<Value> indices;
+                  for (int64_t dim = 0; dim < rank; ++dim)
+                    indices.push_back(b.create<linalg::IndexOp>(loc, dim));
+                  Value m = b.create<arith::CmpIOp>(
+                      loc, arith::CmpIPredicate::ne,
+                      b.create<tensor::ExtractOp>(loc, mask, indices[0]),
+                      b.create<arith::ConstantOp>(loc, b.getI8IntegerAttr(0)));
+                  // Masked off batches have no first batch, read in bounds
+                  // anyway.
+                  Value f = b.create<tensor::ExtractOp>(loc, first, indices[0]);
+                  indices[0] =
+                      b.create<arith::SelectOp>(loc, m, f, indices[0]);
+                  Value v = arith::getReductionOp(
+                      *kind, b, loc,
+                      b.create<tensor::ExtractOp>(loc, old, indices), args[1]);
+                  Value res = b.create<arith::SelectOp>(loc, m, v, args[0]);
+                  b.create<linalg::YieldOp>(loc, res);
+                })
+            .getResult(0);
+    rewriter.replaceOp(op, ValueRange{atomicOp.getResult()[0], result});
+    return success();
+  }
+
+private:
+  int64_t maxBatchSize;
+};
+
+struct CombineAtomicRMWPass
+    : public linalg_ext::CombineAtomicRMWBase<CombineAtomicRMWPass> {
+  CombineAtomicRMWPass() = default;
+  CombineAtomicRMWPass(const CombineAtomicRMWPass &) = default;
+
+  void runOnOperation() override {
+    Operation *op = getOperation();
+    RewritePatternSet patterns(op->getContext());
+    patterns.add<CombineAtomicRMWPattern>(patterns.getContext(), maxBatchSize);
+    if (failed(applyPatternsAndFoldGreedily(op, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::linalg_ext::createCombineAtomicRMWPass() {
+  return std::make_unique<CombineAtomicRMWPass>();
+}
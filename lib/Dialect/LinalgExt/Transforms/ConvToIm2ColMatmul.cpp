@@ -0,0 +1,235 @@
+//===- ConvToIm2ColMatmul.cpp - Tiled im2col lowering of conv ---*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <assert.h>
+#include <memory>
+#include <stdint.h>
+#include <utility>
+
+#include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtOps.h"
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Location.h"
+#include "mlir/IR/OpDefinition.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/TypeUtilities.h"
+#include "mlir/IR/Value.h"
+#include "mlir/IR/ValueRange.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+/// Get the largest divisor of `size` which is not greater than `limit`.
+static int64_t getTileSize(int64_t size, int64_t limit) {
+  for (int64_t tile = std::min(size, limit); tile > 1; --tile) {
+    if (size % tile == 0)
+      return tile;
+  }
+  return 1;
+}
+
+/// Extract the slice of `source` of `sizes` at `offsets`, with unit strides.
+static Value extractSlice(OpBuilder &b, Location loc, Value source,
+                          ArrayRef<OpFoldResult> offsets,
+                          ArrayRef<int64_t> sizes) {
+  SmallVector<OpFoldResult> strides(sizes.size(), b.getIndexAttr(1));
+  return b.create<tensor::ExtractSliceOp>(
+      loc, source, offsets, getAsIndexOpFoldResult(b.getContext(), sizes),
+      strides);
+}
+
+namespace {
+/// Lower a batch convolution to a loop over tiles of output rows, unfolding
+/// only the input rows read by a tile with im2col, and computing the tile
+/// with a batch matmul.
+///
+/// Example, with a tile of 2 rows:
+///
+/// ```mlir
+///   %res = linalg_ext.batch_conv_2d_nhwc_fhwc
+///       ins(%input, %filter : tensor<2x1x6x6x4xf32>, tensor<2x8x3x3x4xf32>)
+///       outs(%init : tensor<2x1x4x4x8xf32>) -> tensor<2x1x4x4x8xf32>
+/// ```
+///
+/// is converted to:
+///
+/// ```mlir
+///   %filter_mat = tensor.collapse_shape %filter [[0], [1], [2, 3, 4]]
+///       : tensor<2x8x3x3x4xf32> into tensor<2x8x36xf32>
+///   %res = scf.for %oh = %c0 to %c4 step %c2 iter_args(%acc = %init)
+///       -> (tensor<2x1x4x4x8xf32>) {
+///     %rows = tensor.extract_slice %input[0, 0, %oh, 0, 0] [2, 1, 4, 6, 4]
+///         [1, 1, 1, 1, 1] : tensor<2x1x6x6x4xf32> to tensor<2x1x4x6x4xf32>
+///     %rows_4d = tensor.collapse_shape %rows [[0, 1], [2], [3], [4]]
+///         : tensor<2x1x4x6x4xf32> into tensor<2x4x6x4xf32>
+///     %patches = linalg_ext.im2col ins(%rows_4d : tensor<2x4x6x4xf32>)
+///         outs(%empty : tensor<2x2x4x3x3x4xf32>) -> tensor<2x2x4x3x3x4xf32>
+///     ... reshaped to tensor<2x8x36xf32>
+///     %tile = tensor.extract_slice %acc[0, 0, %oh, 0, 0] [2, 1, 2, 4, 8]
+///         [1, 1, 1, 1, 1] : tensor<2x1x4x4x8xf32> to tensor<2x1x2x4x8xf32>
+///     ... reshaped to tensor<2x8x8xf32>
+///     %mm = linalg.batch_matmul_transpose_b
+///         ins(%patches_mat, %filter_mat
+///             : tensor<2x8x36xf32>, tensor<2x8x36xf32>)
+///         outs(%tile_mat : tensor<2x8x8xf32>) -> tensor<2x8x8xf32>
+///     ... reshaped to tensor<2x1x2x4x8xf32> and inserted into %acc
+///   }
+/// ```
+struct ConvToIm2ColMatmulPattern
+    : public OpRewritePattern<linalg_ext::BatchConv2DNhwcFhwcOp> {
+  ConvToIm2ColMatmulPattern(MLIRContext *context, int64_t tileRows)
+      : OpRewritePattern<linalg_ext::BatchConv2DNhwcFhwcOp>(context),
+        tileRows(tileRows) {}
+
+  LogicalResult matchAndRewrite(linalg_ext::BatchConv2DNhwcFhwcOp op,
+                                PatternRewriter &rewriter) const override {
+    if (tileRows < 1 || !op.hasPureTensorSemantics())
+      return failure();
+    if (op.getNumDpsInputs() != 2 || op.getNumDpsInits() != 1)
+      return failure();
+    Value input = op.getDpsInputOperand(0)->get();
+    Value filter = op.getDpsInputOperand(1)->get();
+    Value init = op.getDpsInitOperand(0)->get();
+    auto inputTy = input.getType().cast<RankedTensorType>();
+    auto filterTy = filter.getType().cast<RankedTensorType>();
+    auto initTy = init.getType().cast<RankedTensorType>();
+    if (!inputTy.hasStaticShape() || !filterTy.hasStaticShape() ||
+        !initTy.hasStaticShape())
+      return failure();
+    // im2col has no dilation.
+    if (llvm::any_of(op.getDilations().getValues<int64_t>(),
+                     [](int64_t dilation) { return dilation != 1; }))
+      return failure();
+
+    auto strides = llvm::to_vector(op.getStrides().getValues<int64_t>());
+    ArrayRef<int64_t> inputShape = inputTy.getShape();
+    ArrayRef<int64_t> filterShape = filterTy.getShape();
+    ArrayRef<int64_t> initShape = initTy.getShape();
+    int64_t batch = inputShape[0], num = inputShape[1];
+    int64_t width = inputShape[3], channels = inputShape[4];
+    int64_t outFeatures = filterShape[1];
+    int64_t kernelH = filterShape[2], kernelW = filterShape[3];
+    int64_t outH = initShape[2], outW = initShape[3];
+    int64_t tileH = getTileSize(outH, tileRows);
+    int64_t tileRowsIn = (tileH - 1) * strides[0] + kernelH;
+    int64_t reduction = kernelH * kernelW * channels;
+    int64_t tileM = num * tileH * outW;
+
+    Location loc = op.getLoc();
+    Type inputElemTy = inputTy.getElementType();
+    // The filter is used as the transposed right hand side of the matmul, so
+    // that it only needs a reshape.
+    Value filterMat = rewriter.create<tensor::CollapseShapeOp>(
+        loc, filter, ArrayRef<ReassociationIndices>{{0}, {1}, {2, 3, 4}});
+
+    Value lb = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value ub = rewriter.create<arith::ConstantIndexOp>(loc, outH);
+    Value step = rewriter.create<arith::ConstantIndexOp>(loc, tileH);
+    auto forOp = rewriter.create<scf::ForOp>(
+        loc, lb, ub, step, ValueRange{init},
+        [&](OpBuilder &b, Location loc, Value iv, ValueRange iterArgs) {
+          Value inputRow = iv;
+          if (strides[0] != 1) {
+            inputRow = b.create<arith::MulIOp>(
+                loc, iv, b.create<arith::ConstantIndexOp>(loc, strides[0]));
+          }
+          OpFoldResult zero = b.getIndexAttr(0);
+
+          // 1. Unfold the input rows read by the tile.
+          Value rows = extractSlice(
+              b, loc, input, {zero, zero, inputRow, zero, zero},
+              {batch, num, tileRowsIn, width, channels});
+          rows = b.create<tensor::CollapseShapeOp>(
+              loc, rows,
+              ArrayRef<ReassociationIndices>{{0, 1}, {2}, {3}, {4}});
+          Value patchesInit = b.create<tensor::EmptyOp>(
+              loc,
+              ArrayRef<int64_t>{batch * num, tileH, outW, kernelH, kernelW,
+                                channels},
+              inputElemTy);
+          Value patches =
+              b.create<linalg_ext::Im2ColOp>(
+                   loc, TypeRange{patchesInit.getType()}, ValueRange{rows},
+                   ValueRange{patchesInit}, op.getStrides())
+                  .getResult(0);
+          patches = b.create<tensor::ExpandShapeOp>(
+              loc,
+              RankedTensorType::get({batch, num, tileH, outW, kernelH,
+                                     kernelW, channels},
+                                    inputElemTy),
+              patches,
+              ArrayRef<ReassociationIndices>{
+                  {0, 1}, {2}, {3}, {4}, {5}, {6}});
+          patches = b.create<tensor::CollapseShapeOp>(
+              loc, patches,
+              ArrayRef<ReassociationIndices>{{0}, {1, 2, 3}, {4, 5, 6}});
+          assert(patches.getType().cast<RankedTensorType>().getShape() ==
+                     ArrayRef<int64_t>({batch, tileM, reduction}) &&
+                 "unexpected shape of the patches");
+
+          // 2. Accumulate the tile with a batch matmul.
+          SmallVector<OpFoldResult> tileOffsets = {zero, zero, iv, zero,
+                                                   zero};
+          SmallVector<int64_t> tileShape = {batch, num, tileH, outW,
+                                            outFeatures};
+          Value tile =
+              extractSlice(b, loc, iterArgs[0], tileOffsets, tileShape);
+          Value tileMat = b.create<tensor::CollapseShapeOp>(
+              loc, tile, ArrayRef<ReassociationIndices>{{0}, {1, 2, 3}, {4}});
+          Value result =
+              b.create<linalg::BatchMatmulTransposeBOp>(
+                   loc, TypeRange{tileMat.getType()},
+                   ValueRange{patches, filterMat}, ValueRange{tileMat})
+                  .getResult(0);
+          result = b.create<tensor::ExpandShapeOp>(
+              loc, tile.getType(), result,
+              ArrayRef<ReassociationIndices>{{0}, {1, 2, 3}, {4}});
+          SmallVector<OpFoldResult> unitStrides(tileShape.size(),
+                                                b.getIndexAttr(1));
+          Value updated = b.create<tensor::InsertSliceOp>(
+              loc, result, iterArgs[0], tileOffsets,
+              getAsIndexOpFoldResult(b.getContext(), tileShape),
+              unitStrides);
+          b.create<scf::YieldOp>(loc, updated);
+        });
+    rewriter.replaceOp(op, forOp.getResults());
+    return success();
+  }
+
+private:
+  int64_t tileRows;
+};
+
+struct ConvToIm2ColMatmulPass
+    : public linalg_ext::ConvToIm2ColMatmulBase<ConvToIm2ColMatmulPass> {
+  ConvToIm2ColMatmulPass() = default;
+  ConvToIm2ColMatmulPass(const ConvToIm2ColMatmulPass &) = default;
+
+  void runOnOperation() override {
+    Operation *op = getOperation();
+    RewritePatternSet patterns(op->getContext());
+    patterns.add<ConvToIm2ColMatmulPattern>(patterns.getContext(), tileRows);
+    if (failed(applyPatternsAndFoldGreedily(op, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::linalg_ext::createConvToIm2ColMatmulPass() {
+  return std::make_unique<ConvToIm2ColMatmulPass>();
+}
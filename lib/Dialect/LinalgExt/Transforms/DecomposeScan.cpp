@@ -0,0 +1,308 @@
+//===- DecomposeScan.cpp - Blocked parallel prefix for scan -----*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <stdint.h>
+#include <utility>
+
+#include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtOps.h"
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/Dialect/Utils/StructuredOpsUtils.h"
+#include "mlir/IR/AffineMap.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Location.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/TypeUtilities.h"
+#include "mlir/IR/Value.h"
+#include "mlir/IR/ValueRange.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+/// Get the reassociation which splits `dim` of a tensor of `rank` into two
+/// dims.
+static SmallVector<ReassociationIndices> getTileReassociation(int64_t rank,
+                                                              int64_t dim) {
+  SmallVector<ReassociationIndices> reassociation;
+  for (int64_t i = 0; i < rank; ++i) {
+    if (i < dim)
+      reassociation.push_back({i});
+    else if (i == dim)
+      reassociation.push_back({i, i + 1});
+    else
+      reassociation.push_back({i + 1});
+  }
+  return reassociation;
+}
+
+/// Extract [offset, offset + size) along `dim` of `value`. The dim is dropped
+/// from the result if `dropDim` is set, in which case `size` must be 1.
+static Value extractAlongDim(OpBuilder &b, Location loc, Value value,
+                             int64_t dim, int64_t offset, int64_t size,
+                             bool dropDim = false) {
+  auto valueTy = value.getType().cast<RankedTensorType>();
+  int64_t rank = valueTy.getRank();
+  SmallVector<OpFoldResult> offsets(rank, b.getIndexAttr(0));
+  SmallVector<OpFoldResult> sizes =
+      getAsIndexOpFoldResult(b.getContext(), valueTy.getShape());
+  SmallVector<OpFoldResult> strides(rank, b.getIndexAttr(1));
+  offsets[dim] = b.getIndexAttr(offset);
+  sizes[dim] = b.getIndexAttr(size);
+  SmallVector<int64_t> shape(valueTy.getShape());
+  if (dropDim)
+    shape.erase(shape.begin() + dim);
+  else
+    shape[dim] = size;
+  return b.create<tensor::ExtractSliceOp>(
+      loc, RankedTensorType::get(shape, valueTy.getElementType()), value,
+      offsets, sizes, strides);
+}
+
+/// Insert `source` into `dest` at `offset` along `dim`. `source` either has
+/// the rank of `dest` or is `dest` with `dim` dropped.
+static Value insertAlongDim(OpBuilder &b, Location loc, Value source,
+                            Value dest, int64_t dim, int64_t offset) {
+  auto sourceTy = source.getType().cast<RankedTensorType>();
+  auto destTy = dest.getType().cast<RankedTensorType>();
+  int64_t rank = destTy.getRank();
+  SmallVector<OpFoldResult> offsets(rank, b.getIndexAttr(0));
+  SmallVector<OpFoldResult> sizes =
+      getAsIndexOpFoldResult(b.getContext(), destTy.getShape());
+  SmallVector<OpFoldResult> strides(rank, b.getIndexAttr(1));
+  offsets[dim] = b.getIndexAttr(offset);
+  sizes[dim] = b.getIndexAttr(
+      sourceTy.getRank() == rank ? sourceTy.getDimSize(dim) : 1);
+  return b.create<tensor::InsertSliceOp>(loc, source, dest, offsets, sizes,
+                                         strides);
+}
+
+/// Create a scan along `dim` with the combiner and the direction of `op`.
+static linalg_ext::ScanOp createScanLike(OpBuilder &b, linalg_ext::ScanOp op,
+                                         ValueRange inputs, ValueRange outputs,
+                                         ValueRange inits, int64_t dim) {
+  SmallVector<Value> dpsInits(outputs);
+  dpsInits.append(inits.begin(), inits.end());
+  SmallVector<Type> resultTypes(ValueRange(dpsInits).getTypes());
+  auto scanOp = b.create<linalg_ext::ScanOp>(
+      op.getLoc(), resultTypes, inputs, dpsInits, ArrayRef<int64_t>{dim},
+      op.getReverse());
+  b.cloneRegionBefore(op.getCombiner(), scanOp.getCombiner(),
+                      scanOp.getCombiner().end());
+  return scanOp;
+}
+
+namespace {
+/// Decompose a scan into a blocked parallel prefix. The scan dim of size N
+/// is split into N / T blocks of T elements, then:
+///
+/// 1. every block is scanned locally, with its first element as init;
+/// 2. the totals of the blocks are scanned with the init of the scan, which
+///    gives the carry of every block and the final carry of the scan;
+/// 3. every element is combined with the carry of the block before it, in a
+///    parallel linalg.generic.
+///
+/// For a reverse scan, the blocks are scanned from their last element and
+/// the carry of a block comes from the block after it.
+///
+/// Example, with T = 4:
+/// ```mlir
+///   %0:2 = linalg_ext.scan ins(%input : tensor<16xf32>)
+///       outs(%output, %init : tensor<16xf32>, tensor<f32>) dimensions = [0]
+/// ```
+///
+/// transformed into:
+///
+/// ```mlir
+///   %tiled = tensor.expand_shape %input [[0, 1]]
+///       : tensor<16xf32> into tensor<4x4xf32>
+///   %head = tensor.extract_slice %tiled[0, 0] [4, 1] [1, 1]
+///       : tensor<4x4xf32> to tensor<4xf32>
+///   %rest = tensor.extract_slice %tiled[0, 1] [4, 3] [1, 1]
+///       : tensor<4x4xf32> to tensor<4x3xf32>
+///   %local:2 = linalg_ext.scan ins(%rest : tensor<4x3xf32>)
+///       outs(%0, %head : tensor<4x3xf32>, tensor<4xf32>) dimensions = [1]
+///   %carry:2 = linalg_ext.scan ins(%local#1 : tensor<4xf32>)
+///       outs(%1, %init : tensor<4xf32>, tensor<f32>) dimensions = [0]
+///   // Shift the carries by one block, the first block gets %init.
+///   ...
+///   %fixed = linalg.generic ins(%local_block, %block_carry
+///       : tensor<4x4xf32>, tensor<4xf32>) outs(%2 : tensor<4x4xf32>)
+///   %res = tensor.collapse_shape %fixed [[0, 1]]
+///       : tensor<4x4xf32> into tensor<16xf32>
+/// ```
+struct DecomposeScanPattern : public OpRewritePattern<linalg_ext::ScanOp> {
+  DecomposeScanPattern(MLIRContext *context, int64_t tileSize)
+      : OpRewritePattern<linalg_ext::ScanOp>(context), tileSize(tileSize) {}
+
+  LogicalResult matchAndRewrite(linalg_ext::ScanOp op,
+                                PatternRewriter &rewriter) const override {
+    if (!op.hasPureTensorSemantics())
+      return failure();
+    ShapedType inputTy = op.getOperandType();
+    if (!inputTy.hasStaticShape())
+      return failure();
+    int64_t dim = op.getDimensions()[0];
+    int64_t size = inputTy.getDimSize(dim);
+    if (tileSize < 2 || size % tileSize != 0 || size / tileSize < 2)
+      return failure();
+
+    SmallVector<Value> inputs = op.inputs();
+    SmallVector<Value> outputs = op.outputs();
+    SmallVector<Value> inits = op.inits();
+    if (inputs.size() != outputs.size())
+      return failure();
+    // The first element of every block is used as the init of its local
+    // scan.
+    for (auto [input, output] : llvm::zip(inputs, outputs)) {
+      if (getElementTypeOrSelf(input.getType()) !=
+          getElementTypeOrSelf(output.getType()))
+        return failure();
+    }
+
+    Location loc = op.getLoc();
+    int64_t rank = inputTy.getRank();
+    int64_t numTiles = size / tileSize;
+    int64_t numOperands = inputs.size();
+    bool reverse = op.getReverse();
+    SmallVector<int64_t> tiledShape(inputTy.getShape());
+    tiledShape[dim] = tileSize;
+    tiledShape.insert(tiledShape.begin() + dim, numTiles);
+    SmallVector<int64_t> blockShape(inputTy.getShape());
+    blockShape[dim] = numTiles;
+    auto reassociation = getTileReassociation(rank, dim);
+    // Position of the element which starts the scan, in a block and among
+    // the blocks.
+    int64_t headOffset = reverse ? tileSize - 1 : 0;
+    int64_t restOffset = reverse ? 0 : 1;
+    int64_t firstTile = reverse ? numTiles - 1 : 0;
+
+    // 1. Scan every block locally.
+    SmallVector<Value> heads, rests, restOutputs;
+    for (Value input : inputs) {
+      Type elementTy = getElementTypeOrSelf(input.getType());
+      Value tiled = rewriter.create<tensor::ExpandShapeOp>(
+          loc, RankedTensorType::get(tiledShape, elementTy), input,
+          reassociation);
+      heads.push_back(extractAlongDim(rewriter, loc, tiled, dim + 1,
+                                      headOffset, 1, /*dropDim=*/true));
+      Value rest = extractAlongDim(rewriter, loc, tiled, dim + 1, restOffset,
+                                   tileSize - 1);
+      rests.push_back(rest);
+      restOutputs.push_back(rewriter.create<tensor::EmptyOp>(
+          loc, rest.getType().cast<RankedTensorType>().getShape(), elementTy));
+    }
+    auto localScan =
+        createScanLike(rewriter, op, rests, restOutputs, heads, dim + 1);
+
+    // 2. Scan the totals of the blocks.
+    SmallVector<Value> totals(localScan.getResults().drop_front(numOperands));
+    SmallVector<Value> carryOutputs;
+    for (Value total : totals) {
+      carryOutputs.push_back(rewriter.create<tensor::EmptyOp>(
+          loc, blockShape, getElementTypeOrSelf(total.getType())));
+    }
+    auto carryScan =
+        createScanLike(rewriter, op, totals, carryOutputs, inits, dim);
+
+    // Rebuild the local results and shift the carries by one block, so that
+    // every block gets the carry of the blocks before it.
+    SmallVector<Value> fixupInputs, fixupInits;
+    for (int64_t i = 0; i < numOperands; ++i) {
+      Type elementTy = getElementTypeOrSelf(inputs[i].getType());
+      Value local =
+          rewriter.create<tensor::EmptyOp>(loc, tiledShape, elementTy);
+      local = insertAlongDim(rewriter, loc, heads[i], local, dim + 1,
+                             headOffset);
+      local = insertAlongDim(rewriter, loc, localScan.getResult(i), local,
+                             dim + 1, restOffset);
+      fixupInputs.push_back(local);
+      fixupInits.push_back(
+          rewriter.create<tensor::EmptyOp>(loc, tiledShape, elementTy));
+    }
+    for (int64_t i = 0; i < numOperands; ++i) {
+      Value carry = rewriter.create<tensor::EmptyOp>(
+          loc, blockShape, getElementTypeOrSelf(inits[i].getType()));
+      carry = insertAlongDim(rewriter, loc, inits[i], carry, dim, firstTile);
+      Value shifted =
+          extractAlongDim(rewriter, loc, carryScan.getResult(i), dim,
+                          reverse ? 1 : 0, numTiles - 1);
+      carry = insertAlongDim(rewriter, loc, shifted, carry, dim,
+                             reverse ? 0 : 1);
+      fixupInputs.push_back(carry);
+    }
+
+    // 3. Combine every element with the carry of its block.
+    AffineMap identityMap = rewriter.getMultiDimIdentityMap(rank + 1);
+    AffineMap carryMap = identityMap.dropResult(dim + 1);
+    SmallVector<AffineMap> indexingMaps(numOperands, identityMap);
+    indexingMaps.append(numOperands, carryMap);
+    indexingMaps.append(numOperands, identityMap);
+    SmallVector<utils::IteratorType> iteratorTypes(
+        rank + 1, utils::IteratorType::parallel);
+    Block &combiner = op.getCombiner().front();
+    auto fixupOp = rewriter.create<linalg::GenericOp>(
+        loc, ValueRange(fixupInits).getTypes(), fixupInputs, fixupInits,
+        indexingMaps, iteratorTypes,
+        [&](OpBuilder &b, Location loc, ValueRange args) {
+          IRMapping mapping;
+          for (int64_t i = 0; i < numOperands; ++i) {
+            mapping.map(combiner.getArgument(i), args[i]);
+            mapping.map(combiner.getArgument(numOperands + i),
+                        args[numOperands + i]);
+            mapping.map(combiner.getArgument(2 * numOperands + i),
+                        args[numOperands + i]);
+          }
+          for (auto &combinerOp : combiner.without_terminator())
+            b.clone(combinerOp, mapping);
+          auto yieldValues = llvm::to_vector(llvm::map_range(
+              combiner.getTerminator()->getOperands().take_front(numOperands),
+              [&](Value v) { return mapping.lookupOrDefault(v); }));
+          b.create<linalg::YieldOp>(loc, yieldValues);
+        });
+
+    SmallVector<Value> results;
+    for (Value fixed : fixupOp.getResults()) {
+      results.push_back(rewriter.create<tensor::CollapseShapeOp>(
+          loc, fixed, reassociation));
+    }
+    results.append(carryScan.getResults().begin() + numOperands,
+                   carryScan.getResults().end());
+    rewriter.replaceOp(op, results);
+    return success();
+  }
+
+private:
+  int64_t tileSize;
+};
+
+struct DecomposeScanPass
+    : public linalg_ext::DecomposeScanBase<DecomposeScanPass> {
+  DecomposeScanPass() = default;
+  DecomposeScanPass(const DecomposeScanPass &) = default;
+
+  void runOnOperation() override {
+    Operation *op = getOperation();
+    RewritePatternSet patterns(op->getContext());
+    patterns.add<DecomposeScanPattern>(patterns.getContext(), tileSize);
+    if (failed(applyPatternsAndFoldGreedily(op, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::linalg_ext::createDecomposeScanPass() {
+  return std::make_unique<DecomposeScanPass>();
+}
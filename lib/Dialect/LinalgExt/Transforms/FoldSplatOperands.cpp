@@ -0,0 +1,137 @@
+//===- FoldSplatOperands.cpp - Capture splat operands -----------*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+//
+// A splat constant or a tt.splat is lowered to a linalg.fill of a full size
+// tensor, which its elementwise consumers read element by element. This file
+// captures the filled value in the payload of such consumers instead, so that
+// the splat tensor is neither materialized nor loaded.
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <utility>
+
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/Value.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+/// Get the value filled into the tensor `value` if it is the result of a
+/// linalg.fill of a value of its element type, or null otherwise.
+static Value getSplatValue(Value value) {
+  auto fillOp = value.getDefiningOp<linalg::FillOp>();
+  if (!fillOp || !fillOp.hasPureTensorSemantics())
+    return nullptr;
+  Value scalar = fillOp.value();
+  if (scalar.getType() != getElementTypeOrSelf(value.getType()))
+    return nullptr;
+  return scalar;
+}
+
+namespace {
+/// Drop the splat inputs of a linalg.map, and use the filled values in its
+/// mapper. One input is kept if all of them are splats.
+struct FoldSplatMapInputsPattern : public OpRewritePattern<linalg::MapOp> {
+  using OpRewritePattern<linalg::MapOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(linalg::MapOp op,
+                                PatternRewriter &rewriter) const override {
+    if (!op.hasPureTensorSemantics())
+      return failure();
+    Block &mapper = op.getMapper().front();
+    SmallVector<Value> inputs;
+    SmallVector<BlockArgument> keptArgs;
+    IRMapping mapping;
+    for (auto [input, arg] : llvm::zip(op.getInputs(), mapper.getArguments())) {
+      if (Value scalar = getSplatValue(input)) {
+        mapping.map(arg, scalar);
+        continue;
+      }
+      inputs.push_back(input);
+      keptArgs.push_back(arg);
+    }
+    if (inputs.size() == op.getInputs().size())
+      return failure();
+    if (inputs.empty()) {
+      inputs.push_back(op.getInputs().front());
+      keptArgs.push_back(mapper.getArgument(0));
+      mapping.erase(mapper.getArgument(0));
+    }
+
+    auto mapOp = rewriter.create<linalg::MapOp>(
+        op.getLoc(), inputs, op.getInit(),
+        [&](OpBuilder &b, Location loc, ValueRange args) {
+          for (auto [arg, newArg] : llvm::zip(keptArgs, args))
+            mapping.map(arg, newArg);
+          for (Operation &payloadOp : mapper.without_terminator())
+            b.clone(payloadOp, mapping);
+          Operation *yield = mapper.getTerminator();
+          SmallVector<Value> results = llvm::map_to_vector(
+              yield->getOperands(),
+              [&](Value value) { return mapping.lookupOrDefault(value); });
+          b.create<linalg::YieldOp>(loc, results);
+        },
+        linalg::getPrunedAttributeList(op));
+    rewriter.replaceOp(op, mapOp->getResults());
+    return success();
+  }
+};
+
+/// Use the filled values of the splat inputs of a linalg.generic in its
+/// payload. The inputs which become unused are then dropped by the
+/// canonicalization patterns of linalg.generic.
+struct FoldSplatGenericInputsPattern
+    : public OpRewritePattern<linalg::GenericOp> {
+  using OpRewritePattern<linalg::GenericOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(linalg::GenericOp op,
+                                PatternRewriter &rewriter) const override {
+    if (!op.hasPureTensorSemantics())
+      return failure();
+    bool changed = false;
+    for (OpOperand *input : op.getDpsInputOperands()) {
+      BlockArgument arg = op.getMatchingBlockArgument(input);
+      Value scalar = getSplatValue(input->get());
+      if (!scalar || arg.use_empty())
+        continue;
+      rewriter.modifyOpInPlace(op, [&]() { arg.replaceAllUsesWith(scalar); });
+      changed = true;
+    }
+    return success(changed);
+  }
+};
+
+struct FoldSplatOperandsPass
+    : public linalg_ext::FoldSplatOperandsBase<FoldSplatOperandsPass> {
+  FoldSplatOperandsPass() = default;
+  FoldSplatOperandsPass(const FoldSplatOperandsPass &) = default;
+
+  void runOnOperation() override {
+    MLIRContext *context = &getContext();
+    RewritePatternSet patterns(context);
+    patterns.add<FoldSplatMapInputsPattern, FoldSplatGenericInputsPattern>(
+        context);
+    linalg::GenericOp::getCanonicalizationPatterns(patterns, context);
+    if (failed(applyPatternsAndFoldGreedily(getOperation(),
+                                            std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::linalg_ext::createFoldSplatOperandsPass() {
+  return std::make_unique<FoldSplatOperandsPass>();
+}
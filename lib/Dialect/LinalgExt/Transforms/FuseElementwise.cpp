@@ -0,0 +1,161 @@
+//===- FuseElementwise.cpp - Fuse elementwise linalg ops --------*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+//
+// The arith and math ops on tensors are lowered to a linalg.map each, and the
+// splats and broadcasts to linalg.fill and linalg.broadcast, each of which
+// materializes a full size tensor. This file generalizes such ops feeding
+// each other, and fuses the producers into their consumers with the upstream
+// elementwise fusion, guarded by the cost of evaluating a multi-use producer
+// over the iteration space of its consumer.
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <stdint.h>
+#include <utility>
+
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/IR/Dominance.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/Value.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+/// Whether `op` is an elementwise op on tensors whose results can be fused
+/// into their consumers.
+static bool isFusibleProducer(linalg::LinalgOp op) {
+  if (!op.hasPureTensorSemantics())
+    return false;
+  if (isa<linalg::MapOp, linalg::FillOp, linalg::BroadcastOp>(op))
+    return true;
+  return isa<linalg::GenericOp>(op) &&
+         op.getNumLoops() == op.getNumParallelLoops();
+}
+
+/// Whether `op` is an op on tensors the elementwise producers of which can be
+/// fused into.
+static bool isFusibleConsumer(linalg::LinalgOp op) {
+  return op.hasPureTensorSemantics() &&
+         isa<linalg::MapOp, linalg::BroadcastOp, linalg::GenericOp>(op);
+}
+
+/// Whether the producer of the input `operand` is worth fusing into its
+/// consumer.
+static bool shouldFuse(OpOperand *operand, int64_t maxRecomputedOps) {
+  auto producer = operand->get().getDefiningOp<linalg::LinalgOp>();
+  auto consumer = dyn_cast<linalg::LinalgOp>(operand->getOwner());
+  if (!producer || !consumer || !isFusibleProducer(producer) ||
+      !isFusibleConsumer(consumer) || !consumer.isDpsInput(operand))
+    return false;
+  // Fusing the single use of a producer removes its result.
+  if (operand->get().hasOneUse())
+    return true;
+  // Otherwise the fused op also yields the result of the producer for its
+  // other uses, and evaluates its payload over the iterations of the
+  // consumer, which may broadcast it.
+  int64_t numPayloadOps = producer.getBlock()->getOperations().size() - 1;
+  return numPayloadOps <= maxRecomputedOps;
+}
+
+namespace {
+/// Fuse the elementwise producers of a linalg.generic into it, as the
+/// upstream `FuseElementwiseOps` pattern does, but only the producers passing
+/// `shouldFuse`. The other uses of a producer which the fused op dominates
+/// are redirected to the result the fused op yields for them, and the
+/// producer is erased once it has no use left, so that its payload is not
+/// computed twice. The uses before the consumer keep reading the producer.
+struct FuseElementwiseProducerPattern
+    : public OpRewritePattern<linalg::GenericOp> {
+  FuseElementwiseProducerPattern(MLIRContext *context,
+                                 int64_t maxRecomputedOps)
+      : OpRewritePattern<linalg::GenericOp>(context),
+        maxRecomputedOps(maxRecomputedOps) {}
+
+  LogicalResult matchAndRewrite(linalg::GenericOp op,
+                                PatternRewriter &rewriter) const override {
+    for (OpOperand &operand : op->getOpOperands()) {
+      if (!shouldFuse(&operand, maxRecomputedOps) ||
+          !linalg::areElementwiseOpsFusable(&operand))
+        continue;
+      Operation *producer = operand.get().getDefiningOp();
+      FailureOr<linalg::ElementwiseOpFusionResult> fusionResult =
+          linalg::fuseElementwiseOps(rewriter, &operand);
+      if (failed(fusionResult))
+        continue;
+      // The fused op still reads the producer if the consumer reads it
+      // through several operands, and it is created at the consumer, so it
+      // does not dominate the uses of the producer before the consumer.
+      Operation *fusedOp = fusionResult->fusedOp;
+      DominanceInfo dominanceInfo;
+      for (auto [origVal, replacement] : fusionResult->replacements) {
+        rewriter.replaceUsesWithIf(origVal, replacement, [&](OpOperand &use) {
+          return dominanceInfo.properlyDominates(fusedOp, use.getOwner());
+        });
+      }
+      rewriter.eraseOp(op);
+      if (producer->use_empty())
+        rewriter.eraseOp(producer);
+      return success();
+    }
+    return failure();
+  }
+
+private:
+  int64_t maxRecomputedOps;
+};
+
+struct FuseElementwisePass
+    : public linalg_ext::FuseElementwiseBase<FuseElementwisePass> {
+  FuseElementwisePass() = default;
+  FuseElementwisePass(const FuseElementwisePass &) = default;
+
+  void runOnOperation() override {
+    Operation *op = getOperation();
+    // The upstream fusion works on linalg.generic ops, so generalize the
+    // named ops which are fused with a neighbour. The others are kept named.
+    SmallVector<linalg::LinalgOp> namedOps;
+    op->walk([&](linalg::LinalgOp linalgOp) {
+      if (!isa<linalg::MapOp, linalg::FillOp, linalg::BroadcastOp>(linalgOp) ||
+          !linalgOp.hasPureTensorSemantics())
+        return;
+      bool fusedWithProducer =
+          llvm::any_of(linalgOp->getOpOperands(), [&](OpOperand &operand) {
+            return shouldFuse(&operand, maxRecomputedOps);
+          });
+      bool fusedWithConsumer = llvm::any_of(
+          linalgOp->getResult(0).getUses(), [&](OpOperand &use) {
+            return shouldFuse(&use, maxRecomputedOps);
+          });
+      if (fusedWithProducer || fusedWithConsumer)
+        namedOps.push_back(linalgOp);
+    });
+    IRRewriter rewriter(op->getContext());
+    for (linalg::LinalgOp namedOp : namedOps) {
+      rewriter.setInsertionPoint(namedOp);
+      if (failed(linalg::generalizeNamedOp(rewriter, namedOp)))
+        return signalPassFailure();
+    }
+
+    RewritePatternSet patterns(op->getContext());
+    patterns.add<FuseElementwiseProducerPattern>(patterns.getContext(),
+                                                 maxRecomputedOps);
+    if (failed(applyPatternsAndFoldGreedily(op, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::linalg_ext::createFuseElementwisePass() {
+  return std::make_unique<FuseElementwisePass>();
+}
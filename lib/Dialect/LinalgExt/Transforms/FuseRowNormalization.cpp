@@ -0,0 +1,405 @@
+//===- FuseRowNormalization.cpp - Fuse softmax and layernorm ----*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+//
+// Softmax and layernorm lowered from triton are chains of linalg.reduce,
+// linalg.broadcast and linalg.map ops on the same rows, each of which
+// materializes a full size tensor. This file rewrites such chains into a
+// row statistics linalg.generic, which reads the rows once, followed by a
+// row-wise normalization linalg.generic.
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <optional>
+#include <stdint.h>
+#include <utility>
+
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
+#include "triton-linalg/Dialect/LinalgExt/Utils/Utils.h"
+#include "triton-linalg/Dialect/Utils/ArithUtils.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Math/IR/Math.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/StructuredOpsUtils.h"
+#include "mlir/IR/AffineMap.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Location.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/TypeUtilities.h"
+#include "mlir/IR/Value.h"
+#include "mlir/IR/ValueRange.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/APFloat.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+/// Get `value` if it is defined by a linalg.map whose payload is a single
+/// op of `OpTys`.
+template <typename... OpTys> static linalg::MapOp matchMap(Value value) {
+  auto mapOp = value ? value.getDefiningOp<linalg::MapOp>() : nullptr;
+  if (!mapOp)
+    return nullptr;
+  Operation *payloadOp =
+      linalg_ext::findPayloadOp(&mapOp.getMapper().front());
+  return isa_and_nonnull<OpTys...>(payloadOp) ? mapOp : nullptr;
+}
+
+/// Get the linalg.reduce defining `value` if it reduces `input` along `dim`
+/// with a single op of `OpTys`, starting from the neutral element of the op.
+template <typename... OpTys>
+static linalg::ReduceOp matchReduce(Value value, Value input, int64_t dim) {
+  auto reduceOp = value ? value.getDefiningOp<linalg::ReduceOp>() : nullptr;
+  if (!reduceOp || reduceOp.getInputs().size() != 1 ||
+      reduceOp.getInputs()[0] != input ||
+      reduceOp.getDimensions() != ArrayRef<int64_t>{dim})
+    return nullptr;
+  Operation *payloadOp =
+      linalg_ext::findPayloadOp(&reduceOp.getCombiner().front());
+  if (!isa_and_nonnull<OpTys...>(payloadOp))
+    return nullptr;
+  auto fillOp = reduceOp.getInits()[0].getDefiningOp<linalg::FillOp>();
+  std::optional<TypedAttr> neutralElement = getNeutralElement(payloadOp);
+  TypedAttr fillVal;
+  if (!fillOp || !neutralElement.has_value() ||
+      !matchPattern(fillOp.getInputs()[0], m_Constant(&fillVal)) ||
+      fillVal != *neutralElement)
+    return nullptr;
+  return reduceOp;
+}
+
+/// Get the source of `value` if it is a broadcast along `dim`, looking
+/// through the reshapes of expand_dims followed by the collapse of
+/// broadcast which round trip the shape of the source.
+static Value getBroadcastSource(Value value, int64_t dim) {
+  auto broadcastOp = value.getDefiningOp<linalg::BroadcastOp>();
+  if (!broadcastOp || broadcastOp.getDimensions() != ArrayRef<int64_t>{dim})
+    return nullptr;
+  Value source = broadcastOp.getInput();
+  if (auto collapseOp = source.getDefiningOp<tensor::CollapseShapeOp>()) {
+    auto expandOp = collapseOp.getSrc().getDefiningOp<tensor::ExpandShapeOp>();
+    if (expandOp && expandOp.getSrc().getType() == source.getType())
+      return expandOp.getSrc();
+  }
+  return source;
+}
+
+/// Check whether `value` is filled with the size of `input` along `dim`.
+static bool isFilledWithDimSize(Value value, Value input, int64_t dim) {
+  auto fillOp = value.getDefiningOp<linalg::FillOp>();
+  FloatAttr fillVal;
+  if (!fillOp || !matchPattern(fillOp.getInputs()[0], m_Constant(&fillVal)))
+    return false;
+  int64_t size = input.getType().cast<ShapedType>().getDimSize(dim);
+  return !ShapedType::isDynamic(size) &&
+         fillVal.getValueAsDouble() == static_cast<double>(size);
+}
+
+/// Create a tensor of `type` filled with `value`.
+static Value createFilledTensor(OpBuilder &b, Location loc,
+                                RankedTensorType type, double value) {
+  Value fillVal = b.create<arith::ConstantOp>(
+      loc, b.getFloatAttr(type.getElementType(), value));
+  Value empty =
+      b.create<tensor::EmptyOp>(loc, type.getShape(), type.getElementType());
+  return b.create<linalg::FillOp>(loc, fillVal, empty).getResult(0);
+}
+
+/// Get the indexing maps and iterator types of a row-wise linalg.generic
+/// over a tensor of `rank`, whose `numRowOperands` operands after the first
+/// one are rows, i.e. do not have `dim`.
+static void
+getRowWiseLoopInfo(OpBuilder &b, int64_t rank, int64_t dim,
+                   int64_t numRowOperands, bool reduceDim,
+                   SmallVectorImpl<AffineMap> &indexingMaps,
+                   SmallVectorImpl<utils::IteratorType> &iterTypes) {
+  AffineMap identityMap = b.getMultiDimIdentityMap(rank);
+  indexingMaps.push_back(identityMap);
+  indexingMaps.append(numRowOperands, identityMap.dropResult(dim));
+  iterTypes.assign(rank, utils::IteratorType::parallel);
+  if (reduceDim)
+    iterTypes[dim] = utils::IteratorType::reduction;
+  else
+    indexingMaps.push_back(identityMap);
+}
+
+namespace {
+/// Fuse a softmax into an online softmax.
+///
+/// Example:
+/// ```mlir
+///   %max = linalg.reduce { arith.maximumf } ins(%x) outs(%neg_inf)
+///       dimensions = [1]
+///   %0 = linalg.broadcast ins(%max) outs(%empty) dimensions = [1]
+///   %1 = linalg.map { arith.subf } ins(%x, %0)
+///   %2 = linalg.map { math.exp } ins(%1)
+///   %sum = linalg.reduce { arith.addf } ins(%2) outs(%zero) dimensions = [1]
+///   %3 = linalg.broadcast ins(%sum) outs(%empty) dimensions = [1]
+///   %4 = linalg.map { arith.divf } ins(%2, %3)
+/// ```
+///
+/// transformed into:
+///
+/// ```mlir
+///   // m' = max(m, x), s' = s * exp(m - m') + exp(x - m')
+///   %stats:2 = linalg.generic ins(%x) outs(%neg_inf, %zero)
+///   // exp(x - m) / s
+///   %4 = linalg.generic ins(%x, %stats#0, %stats#1) outs(%empty)
+/// ```
+struct FuseSoftmaxPattern : public OpRewritePattern<linalg::MapOp> {
+  using OpRewritePattern<linalg::MapOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(linalg::MapOp op,
+                                PatternRewriter &rewriter) const override {
+    if (!matchMap<arith::DivFOp>(op->getResult(0)))
+      return failure();
+    auto expOp = matchMap<math::ExpOp>(op.getInputs()[0]);
+    if (!expOp)
+      return failure();
+    auto subOp = matchMap<arith::SubFOp>(expOp.getInputs()[0]);
+    if (!subOp)
+      return failure();
+    auto maxBroadcastOp =
+        subOp.getInputs()[1].getDefiningOp<linalg::BroadcastOp>();
+    if (!maxBroadcastOp || maxBroadcastOp.getDimensions().size() != 1)
+      return failure();
+    int64_t dim = maxBroadcastOp.getDimensions()[0];
+    Value x = subOp.getInputs()[0];
+    auto maxOp = matchReduce<arith::MaximumFOp, arith::MaxNumFOp>(
+        getBroadcastSource(maxBroadcastOp.getResult()[0], dim), x, dim);
+    if (!maxOp)
+      return failure();
+    auto sumOp = matchReduce<arith::AddFOp>(
+        getBroadcastSource(op.getInputs()[1], dim), expOp.getResult()[0], dim);
+    if (!sumOp)
+      return failure();
+
+    Location loc = op.getLoc();
+    int64_t rank = x.getType().cast<ShapedType>().getRank();
+    Type elementTy = getElementTypeOrSelf(x.getType());
+    Operation *maxPayloadOp =
+        linalg_ext::findPayloadOp(&maxOp.getCombiner().front());
+    Value maxInit = maxOp.getInits()[0];
+    Value sumInit = sumOp.getInits()[0];
+
+    // Compute the max and the sum of exp(x - max) of every row in one pass.
+    SmallVector<AffineMap> indexingMaps;
+    SmallVector<utils::IteratorType> iterTypes;
+    getRowWiseLoopInfo(rewriter, rank, dim, /*numRowOperands=*/2,
+                       /*reduceDim=*/true, indexingMaps, iterTypes);
+    auto statsOp = rewriter.create<linalg::GenericOp>(
+        loc, TypeRange{maxInit.getType(), sumInit.getType()}, ValueRange{x},
+        ValueRange{maxInit, sumInit}, indexingMaps, iterTypes,
+        [&](OpBuilder &b, Location loc, ValueRange args) {
+          Value in = args[0], max = args[1], sum = args[2];
+          Value newMax = b.create(loc, maxPayloadOp->getName().getIdentifier(),
+                                  ValueRange{max, in}, elementTy)
+                             ->getResult(0);
+          // exp(a - b) with a == b gives 1, even if both are -inf.
+          Value one =
+              b.create<arith::ConstantOp>(loc, b.getFloatAttr(elementTy, 1.0));
+          auto expDiff = [&](Value lhs, Value rhs) -> Value {
+            Value same = b.create<arith::CmpFOp>(loc, arith::CmpFPredicate::OEQ,
+                                                 lhs, rhs);
+            Value exp = b.create<math::ExpOp>(
+                loc, b.create<arith::SubFOp>(loc, lhs, rhs));
+            return b.create<arith::SelectOp>(loc, same, one, exp);
+          };
+          Value newSum = b.create<arith::AddFOp>(
+              loc, b.create<arith::MulFOp>(loc, sum, expDiff(max, newMax)),
+              expDiff(in, newMax));
+          b.create<linalg::YieldOp>(loc, ValueRange{newMax, newSum});
+        });
+
+    // Normalize every element with the statistics of its row.
+    indexingMaps.clear();
+    getRowWiseLoopInfo(rewriter, rank, dim, /*numRowOperands=*/2,
+                       /*reduceDim=*/false, indexingMaps, iterTypes);
+    rewriter.replaceOpWithNewOp<linalg::GenericOp>(
+        op, op.getInit().getType(),
+        ValueRange{x, statsOp.getResult(0), statsOp.getResult(1)},
+        op.getInit(), indexingMaps, iterTypes,
+        [&](OpBuilder &b, Location loc, ValueRange args) {
+          Value exp = b.create<math::ExpOp>(
+              loc, b.create<arith::SubFOp>(loc, args[0], args[1]));
+          b.create<linalg::YieldOp>(
+              loc, b.create<arith::DivFOp>(loc, exp, args[2]).getResult());
+        });
+    return success();
+  }
+};
+
+/// Fuse the mean and the variance of a layernorm into a single pass with
+/// the Welford algorithm, and the normalization into a row-wise generic.
+///
+/// Example:
+/// ```mlir
+///   %0 = linalg.reduce { arith.addf } ins(%x) outs(%zero) dimensions = [1]
+///   %mean = linalg.map { arith.divf } ins(%0, %n)
+///   %1 = linalg.broadcast ins(%mean) outs(%empty) dimensions = [1]
+///   %xc = linalg.map { arith.subf } ins(%x, %1)
+///   %2 = linalg.map { arith.mulf } ins(%xc, %xc)
+///   %3 = linalg.reduce { arith.addf } ins(%2) outs(%zero) dimensions = [1]
+///   %var = linalg.map { arith.divf } ins(%3, %n)
+///   %rstd = ... %var ...
+///   %4 = linalg.broadcast ins(%rstd) outs(%empty) dimensions = [1]
+///   %y = linalg.map { arith.mulf } ins(%xc, %4)
+/// ```
+///
+/// transformed into:
+///
+/// ```mlir
+///   // n' = n + 1, mean' = mean + (x - mean) / n',
+///   // m2' = m2 + (x - mean) * (x - mean')
+///   %stats:3 = linalg.generic ins(%x) outs(%zero, %zero, %zero)
+///   %var = linalg.map { arith.divf } ins(%stats#1, %n)
+///   %rstd = ... %var ...
+///   // (x - mean) * rstd
+///   %y = linalg.generic ins(%x, %stats#0, %rstd) outs(%empty)
+/// ```
+struct FuseLayerNormPattern : public OpRewritePattern<linalg::MapOp> {
+  using OpRewritePattern<linalg::MapOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(linalg::MapOp op,
+                                PatternRewriter &rewriter) const override {
+    if (!matchMap<arith::MulFOp>(op->getResult(0)))
+      return failure();
+    auto centerOp = matchMap<arith::SubFOp>(op.getInputs()[0]);
+    if (!centerOp)
+      return failure();
+    auto meanBroadcastOp =
+        centerOp.getInputs()[1].getDefiningOp<linalg::BroadcastOp>();
+    if (!meanBroadcastOp || meanBroadcastOp.getDimensions().size() != 1)
+      return failure();
+    int64_t dim = meanBroadcastOp.getDimensions()[0];
+    Value x = centerOp.getInputs()[0];
+    Value rstd = getBroadcastSource(op.getInputs()[1], dim);
+    if (!rstd || !x.getType().cast<ShapedType>().hasStaticShape())
+      return failure();
+
+    // mean = sum(x) / n.
+    auto meanOp = matchMap<arith::DivFOp>(
+        getBroadcastSource(meanBroadcastOp.getResult()[0], dim));
+    if (!meanOp || !isFilledWithDimSize(meanOp.getInputs()[1], x, dim))
+      return failure();
+    auto meanSumOp = matchReduce<arith::AddFOp>(meanOp.getInputs()[0], x, dim);
+    if (!meanSumOp)
+      return failure();
+
+    // var = sum(xc * xc) / n.
+    Value center = centerOp.getResult()[0];
+    linalg::MapOp varOp;
+    for (Operation *user : center.getUsers()) {
+      if (user->getNumResults() != 1)
+        continue;
+      auto squareOp = matchMap<arith::MulFOp>(user->getResult(0));
+      if (!squareOp || squareOp.getInputs()[0] != center ||
+          squareOp.getInputs()[1] != center)
+        continue;
+      for (Operation *squareUser : squareOp->getUsers()) {
+        if (squareUser->getNumResults() != 1 ||
+            !matchReduce<arith::AddFOp>(squareUser->getResult(0),
+                                        squareOp.getResult()[0], dim))
+          continue;
+        for (Operation *sumUser : squareUser->getUsers()) {
+          if (sumUser->getNumResults() != 1)
+            continue;
+          auto divOp = matchMap<arith::DivFOp>(sumUser->getResult(0));
+          if (divOp && divOp.getInputs()[0] == squareUser->getResult(0) &&
+              isFilledWithDimSize(divOp.getInputs()[1], x, dim))
+            varOp = divOp;
+        }
+      }
+    }
+    if (!varOp)
+      return failure();
+
+    Location loc = op.getLoc();
+    int64_t rank = x.getType().cast<ShapedType>().getRank();
+    Type elementTy = getElementTypeOrSelf(x.getType());
+    auto rowTy = meanOp.getInit().getType().cast<RankedTensorType>();
+
+    // Compute the mean and the sum of squared differences of every row in
+    // one pass, before the first use of the row sums. The number of elements
+    // accumulated so far is carried along, so that the combiner does not
+    // depend on the iteration order nor on the tiling of the reduction.
+    SmallVector<AffineMap> indexingMaps;
+    SmallVector<utils::IteratorType> iterTypes;
+    getRowWiseLoopInfo(rewriter, rank, dim, /*numRowOperands=*/3,
+                       /*reduceDim=*/true, indexingMaps, iterTypes);
+    linalg::GenericOp statsOp;
+    {
+      OpBuilder::InsertionGuard guard(rewriter);
+      rewriter.setInsertionPoint(meanSumOp);
+      Value meanInit = createFilledTensor(rewriter, loc, rowTy, 0.0);
+      Value m2Init = createFilledTensor(rewriter, loc, rowTy, 0.0);
+      Value countInit = createFilledTensor(rewriter, loc, rowTy, 0.0);
+      statsOp = rewriter.create<linalg::GenericOp>(
+          loc, TypeRange{rowTy, rowTy, rowTy}, ValueRange{x},
+          ValueRange{meanInit, m2Init, countInit}, indexingMaps, iterTypes,
+          [&](OpBuilder &b, Location loc, ValueRange args) {
+            Value in = args[0], mean = args[1], m2 = args[2], count = args[3];
+            Value one = b.create<arith::ConstantOp>(
+                loc, b.getFloatAttr(elementTy, 1.0));
+            Value newCount = b.create<arith::AddFOp>(loc, count, one);
+            Value delta = b.create<arith::SubFOp>(loc, in, mean);
+            Value newMean = b.create<arith::AddFOp>(
+                loc, mean, b.create<arith::DivFOp>(loc, delta, newCount));
+            Value newM2 = b.create<arith::AddFOp>(
+                loc, m2,
+                b.create<arith::MulFOp>(
+                    loc, delta, b.create<arith::SubFOp>(loc, in, newMean)));
+            b.create<linalg::YieldOp>(loc,
+                                      ValueRange{newMean, newM2, newCount});
+          });
+    }
+    rewriter.replaceAllUsesWith(meanOp.getResult()[0], statsOp.getResult(0));
+    rewriter.modifyOpInPlace(
+        varOp, [&] { varOp->setOperand(0, statsOp.getResult(1)); });
+
+    // Normalize every element with the statistics of its row.
+    indexingMaps.clear();
+    getRowWiseLoopInfo(rewriter, rank, dim, /*numRowOperands=*/2,
+                       /*reduceDim=*/false, indexingMaps, iterTypes);
+    rewriter.replaceOpWithNewOp<linalg::GenericOp>(
+        op, op.getInit().getType(),
+        ValueRange{x, statsOp.getResult(0), rstd}, op.getInit(), indexingMaps,
+        iterTypes, [&](OpBuilder &b, Location loc, ValueRange args) {
+          Value center = b.create<arith::SubFOp>(loc, args[0], args[1]);
+          b.create<linalg::YieldOp>(
+              loc, b.create<arith::MulFOp>(loc, center, args[2]).getResult());
+        });
+    return success();
+  }
+};
+
+struct FuseRowNormalizationPass
+    : public linalg_ext::FuseRowNormalizationBase<FuseRowNormalizationPass> {
+  FuseRowNormalizationPass() = default;
+  FuseRowNormalizationPass(const FuseRowNormalizationPass &) = default;
+
+  void runOnOperation() override {
+    Operation *op = getOperation();
+    RewritePatternSet patterns(op->getContext());
+    patterns.add<FuseSoftmaxPattern, FuseLayerNormPattern>(
+        patterns.getContext());
+    if (failed(applyPatternsAndFoldGreedily(op, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+} // namespace
+
+std::unique_ptr<Pass>
+mlir::triton::linalg_ext::createFuseRowNormalizationPass() {
+  return std::make_unique<FuseRowNormalizationPass>();
+}
@@ -11,6 +11,7 @@
 #include <tuple>
 
 #include "triton-linalg/Dialect/LinalgExt/Transforms/TilingInterfaceImpl.h"
+#include "triton-linalg/Dialect/Utils/Conventions.h"
 #include "triton-linalg/Dialect/Utils/ShapeUtils.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Arith/Utils/Utils.h"
@@ -113,8 +114,8 @@ static Value padTiledIndice(OpBuilder &builder, Location loc, Value input,
 }
 
 /// Construct memref.atomic_rmw/memref.generic_atomic_rmw based on
-/// triton::linalg_ext::AtomicType.
-static LogicalResult
+/// triton::linalg_ext::AtomicType, and return the original value.
+static FailureOr<Value>
 createMemrefAtomicRMW(OpBuilder &b, Location loc, Value value, Value memref,
                       ValueRange indices, triton::linalg_ext::AtomicType type) {
   OpBuilder::InsertionGuard guard(b);
@@ -156,7 +157,7 @@ createMemrefAtomicRMW(OpBuilder &b, Location loc, Value value, Value memref,
     Block *blk = &genericAtomicRMWOp.body().front();
     b.setInsertionPointToStart(blk);
     b.create<memref::AtomicYieldOp>(loc, value);
-    return success();
+    return genericAtomicRMWOp.getResult();
   }
   case triton::linalg_ext::AtomicType::xori: {
     auto genericAtomicRMWOp =
@@ -165,14 +166,15 @@ createMemrefAtomicRMW(OpBuilder &b, Location loc, Value value, Value memref,
     b.setInsertionPointToStart(blk);
     Value res = b.create<arith::XOrIOp>(loc, blk->getArgument(0), value);
     b.create<memref::AtomicYieldOp>(loc, res);
-    return success();
+    return genericAtomicRMWOp.getResult();
   }
   default:
     llvm_unreachable("Invalid AtomicRMWType");
   }
-  b.create<memref::AtomicRMWOp>(loc, value.getType(), kind, value, memref,
-                                indices);
-  return success();
+  return b
+      .create<memref::AtomicRMWOp>(loc, value.getType(), kind, value, memref,
+                                   indices)
+      .getResult();
 }
 
 /// Tile window and return sliced inputs:window, indices, mask.
@@ -368,6 +370,7 @@ struct LinalgExtOpTilingInterface<triton::linalg_ext::ScatterOp>
     // Clone body region from origin op.
     IRMapping map;
     concreteOp.getRegion().cloneInto(&targetRegion, map);
+    copyMemoryHints(op, tiledScatterOp);
     return TilingResult{{tiledScatterOp},
                         SmallVector<Value>(tiledScatterOp->getResults())};
   }
@@ -539,6 +542,7 @@ struct LinalgExtOpTilingInterface<triton::linalg_ext::GatherOp>
     // Clone body region from origin op.
     IRMapping map;
     concreteOp.getRegion().cloneInto(&targetRegion, map);
+    copyMemoryHints(op, tiledGatherOp);
     return TilingResult{{tiledGatherOp},
                         SmallVector<Value>(tiledGatherOp->getResults())};
   }
@@ -676,6 +680,7 @@ struct LinalgExtOpTilingInterface<triton::linalg_ext::AtomicCASOp>
     Operation *tiledOp = b.create<triton::linalg_ext::AtomicCASOp>(
         loc, initSlice.getType(), ValueRange({inputSlice, cmpSlice, valSlice}),
         initSlice);
+    copyMemoryHints(op, tiledOp);
     return TilingResult{{tiledOp}, SmallVector<Value>(tiledOp->getResults())};
   }
 
@@ -741,6 +746,109 @@ struct LinalgExtOpTilingInterface<triton::linalg_ext::AtomicCASOp>
   }
 };
 
+template <>
+struct LinalgExtOpTilingInterface<triton::linalg_ext::AtomicRMWOp>
+    : public TilingInterface::ExternalModel<
+          LinalgExtOpTilingInterface<triton::linalg_ext::AtomicRMWOp>,
+          triton::linalg_ext::AtomicRMWOp> {
+  SmallVector<Value> getDestinationOperands(Operation *op, OpBuilder &b) const {
+    return llvm::cast<DestinationStyleOpInterface>(op).getDpsInits();
+  }
+
+  SmallVector<utils::IteratorType> getLoopIteratorTypes(Operation *op) const {
+    triton::linalg_ext::AtomicRMWOp atomicRMWOp =
+        cast<triton::linalg_ext::AtomicRMWOp>(op);
+    SmallVector<utils::IteratorType> loops(atomicRMWOp.getInitType().getRank(),
+                                           utils::IteratorType::parallel);
+    return loops;
+  }
+
+  // Tile init then update.
+  SmallVector<Range> getIterationDomain(Operation *op, OpBuilder &b) const {
+    triton::linalg_ext::AtomicRMWOp atomicRMWOp =
+        cast<triton::linalg_ext::AtomicRMWOp>(op);
+    Location loc = op->getLoc();
+    OpFoldResult zero = b.getIndexAttr(0);
+    OpFoldResult one = b.getIndexAttr(1);
+    SmallVector<Range> ranges;
+    for (auto dim :
+         llvm::seq<int64_t>(0, atomicRMWOp.getInitType().getRank())) {
+      OpFoldResult ub = getDim(b, loc, atomicRMWOp.getInit(), dim);
+      ranges.emplace_back(Range{zero, ub, one});
+    }
+    return ranges;
+  }
+
+  // Every tile is a contiguous slice of input, so that it can be updated by
+  // vector atomics.
+  FailureOr<TilingResult>
+  getTiledImplementation(Operation *op, OpBuilder &b,
+                         ArrayRef<OpFoldResult> offsets,
+                         ArrayRef<OpFoldResult> sizes) const {
+    triton::linalg_ext::AtomicRMWOp atomicRMWOp =
+        cast<triton::linalg_ext::AtomicRMWOp>(op);
+    Location loc = atomicRMWOp.getLoc();
+    int64_t rank = atomicRMWOp.getInitType().getRank();
+
+    SmallVector<OpFoldResult> inputOffsets(offsets.begin(), offsets.end());
+    SmallVector<OpFoldResult> inputSizes(sizes.begin(), sizes.end());
+    auto oneAttr = b.getI64IntegerAttr(1);
+    SmallVector<OpFoldResult> strides(rank, oneAttr);
+    Value inputSlice = getSimpliedSlice(b, loc, atomicRMWOp.input(),
+                                        inputOffsets, inputSizes, strides);
+    Value valSlice = getSimpliedSlice(b, loc, atomicRMWOp.val(), inputOffsets,
+                                      inputSizes, strides);
+    Value initSlice = getSimpliedSlice(b, loc, atomicRMWOp.getInit(),
+                                       inputOffsets, inputSizes, strides);
+    assert(inputSlice && valSlice && initSlice &&
+           "failed to get slices of atomic_rmw");
+    Operation *tiledOp = b.create<triton::linalg_ext::AtomicRMWOp>(
+        loc, initSlice.getType(), ValueRange({inputSlice, valSlice}),
+        initSlice, atomicRMWOp.getAtomicType());
+    copyMemoryHints(op, tiledOp);
+    return TilingResult{{tiledOp}, SmallVector<Value>(tiledOp->getResults())};
+  }
+
+  LogicalResult
+  getResultTilePosition(Operation *op, OpBuilder &b, unsigned resultNumber,
+                        ArrayRef<OpFoldResult> offsets,
+                        ArrayRef<OpFoldResult> sizes,
+                        SmallVector<OpFoldResult> &resultOffsets,
+                        SmallVector<OpFoldResult> &resultSizes) const {
+    resultOffsets.assign(offsets.begin(), offsets.end());
+    resultSizes.assign(sizes.begin(), sizes.end());
+    return success();
+  }
+
+  FailureOr<TilingResult>
+  generateResultTileValue(Operation *op, OpBuilder &b, unsigned resultNumber,
+                          ArrayRef<OpFoldResult> offsets,
+                          ArrayRef<OpFoldResult> sizes) const {
+    auto tilingInterfaceOp = cast<TilingInterface>(op);
+    FailureOr<TilingResult> tilingResult =
+        tilingInterfaceOp.getTiledImplementation(b, offsets, sizes);
+    if (failed(tilingResult) || tilingResult->tiledOps.size() != 1)
+      return op->emitOpError("failed to generate tiled implementation");
+
+    return tilingResult;
+  }
+
+  LogicalResult generateScalarImplementation(Operation *op, OpBuilder &b,
+                                             Location loc,
+                                             ValueRange ivs) const {
+    triton::linalg_ext::AtomicRMWOp atomicRMWOp =
+        cast<triton::linalg_ext::AtomicRMWOp>(op);
+    OpBuilder::InsertionGuard guard(b);
+    Value val = b.create<memref::LoadOp>(loc, atomicRMWOp.val(), ivs);
+    FailureOr<Value> origin = createMemrefAtomicRMW(
+        b, loc, val, atomicRMWOp.input(), ivs, atomicRMWOp.getAtomicType());
+    if (failed(origin))
+      return failure();
+    b.create<memref::StoreOp>(loc, *origin, atomicRMWOp.getInit(), ivs);
+    return success();
+  }
+};
+
 template <>
 struct LinalgExtOpTilingInterface<triton::linalg_ext::GatherAtomicCASOp>
     : public TilingInterface::ExternalModel<
@@ -802,6 +910,7 @@ struct LinalgExtOpTilingInterface<triton::linalg_ext::GatherAtomicCASOp>
         ValueRange(
             {gatherAtomicCASOp.input(), cmpSlice, valSlice, indiceSlice}),
         initSlice);
+    copyMemoryHints(op, tiledOp);
     return TilingResult{{tiledOp}, SmallVector<Value>(tiledOp->getResults())};
   }
 
@@ -1002,6 +1111,7 @@ struct LinalgExtOpTilingInterface<triton::linalg_ext::GatherAtomicRMWOp>
     triton::linalg_ext::GatherAtomicRMWOp tiledAtomicRMWOp =
         b.create<triton::linalg_ext::GatherAtomicRMWOp>(
             loc, tiledInputs, tiledInits, atomicRMWOp.getAtomicType());
+    copyMemoryHints(op, tiledAtomicRMWOp);
 
     return TilingResult{{tiledAtomicRMWOp},
                         SmallVector<Value>(tiledAtomicRMWOp->getResults())};
@@ -1571,6 +1681,7 @@ struct LinalgExtOpTilingInterface<triton::linalg_ext::LibdeviceCallOp>
         loc, libdeviceCallOp.getInit(), inputOffsets, inputSizes, strides);
     Operation *tiledOp = b.create<triton::linalg_ext::LibdeviceCallOp>(
         loc, ValueRange(inputsSlice), initSlice, libdeviceCallOp.getSymbol());
+    tiledOp->setAttrs(libdeviceCallOp->getAttrDictionary());
     return TilingResult{{tiledOp}, SmallVector<Value>(tiledOp->getResults())};
   }
 
@@ -1755,6 +1866,13 @@ struct LinalgExtOpTilingInterface<triton::linalg_ext::ScanOp>
     int64_t scanDim = concreteOp.getDimensions()[0];
     auto cond = b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq,
                                         indices[scanDim], zero);
+    // The loops always run forward, visit the elements from the last one to
+    // the first one for a reverse scan.
+    if (concreteOp.getReverse()) {
+      Value last = b.create<arith::SubIOp>(
+          loc, getDimValue(b, loc, concreteOp.inputs()[0], scanDim), one);
+      indices[scanDim] = b.create<arith::SubIOp>(loc, last, indices[scanDim]);
+    }
     SmallVector<Value> accIndices;
     for (int i = 0; i < indices.size(); i++) {
       if (i != scanDim)
@@ -1771,14 +1889,16 @@ struct LinalgExtOpTilingInterface<triton::linalg_ext::ScanOp>
           b.create<scf::YieldOp>(loc);
         },
         [&](OpBuilder &b, Location loc) {
-          SmallVector<Value> indices(ivs.begin(), ivs.end());
-          Value iv = indices[scanDim];
+          SmallVector<Value> prevIndices(indices);
+          Value iv = prevIndices[scanDim];
           scanBlkArgs.push_back(
               b.create<memref::LoadOp>(loc, concreteOp.inputs()[0], indices));
-          Value ivMinusOne = b.create<arith::SubIOp>(loc, iv, one);
-          indices[scanDim] = ivMinusOne;
-          Value ov =
-              b.create<memref::LoadOp>(loc, concreteOp.outputs()[0], indices);
+          prevIndices[scanDim] =
+              concreteOp.getReverse()
+                  ? b.create<arith::AddIOp>(loc, iv, one).getResult()
+                  : b.create<arith::SubIOp>(loc, iv, one).getResult();
+          Value ov = b.create<memref::LoadOp>(loc, concreteOp.outputs()[0],
+                                              prevIndices);
           scanBlkArgs.push_back(ov);
           scanBlkArgs.push_back(ov);
         });
@@ -1821,6 +1941,7 @@ void mlir::triton::linalg_ext::registerExtOpTilingInterfaceExternalModels(
         registerOne<triton::linalg_ext::ScatterOp>(ctx);
         registerOne<triton::linalg_ext::GatherOp>(ctx);
         registerOne<triton::linalg_ext::GatherAtomicRMWOp>(ctx);
+        registerOne<triton::linalg_ext::AtomicRMWOp>(ctx);
         registerOne<triton::linalg_ext::AtomicCASOp>(ctx);
         registerOne<triton::linalg_ext::GatherAtomicCASOp>(ctx);
         registerOne<triton::linalg_ext::PadOp>(ctx);
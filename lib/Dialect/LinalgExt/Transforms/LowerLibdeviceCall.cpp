@@ -0,0 +1,359 @@
+//===- LowerLibdeviceCall.cpp - Lower libdevice calls -----------*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+//
+// A tt.extern_elementwise is lowered to a linalg_ext.libdevice_call, which only
+// carries the name of the libdevice symbol computing an element. This file
+// binds the symbols to a CPU implementation, read from a registry so that new
+// symbols need no recompilation: either an op applied to every element by a
+// linalg.map, optionally expanded to its polynomial approximation, or a
+// vector library function called on a vector of elements at a time.
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <optional>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtOps.h"
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Math/Transforms/Passes.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Location.h"
+#include "mlir/IR/OpDefinition.h"
+#include "mlir/IR/OperationSupport.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/IR/Value.h"
+#include "mlir/IR/Verifier.h"
+#include "mlir/Rewrite/FrozenRewritePatternSet.h"
+#include "mlir/Support/FileUtilities.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+namespace {
+/// The CPU implementation of a libdevice symbol, which is exactly one of an
+/// op applied to every element and a vector library function.
+struct LibdeviceEntry {
+  std::string symbol;
+  /// The name of the op computing an element, e.g. `math.tanh`.
+  std::string op;
+  /// Whether `op` is expanded to its polynomial approximation.
+  bool approximate = false;
+  /// The name of the vector library function computing `width` elements.
+  std::string vector;
+  int64_t width = 0;
+};
+
+bool fromJSON(const llvm::json::Value &value, LibdeviceEntry &entry,
+              llvm::json::Path path) {
+  llvm::json::ObjectMapper mapper(value, path);
+  return mapper && mapper.map("symbol", entry.symbol) &&
+         mapper.mapOptional("op", entry.op) &&
+         mapper.mapOptional("approximate", entry.approximate) &&
+         mapper.mapOptional("vector", entry.vector) &&
+         mapper.mapOptional("width", entry.width);
+}
+} // namespace
+
+/// The libdevice symbols equivalent to an op, known without a registry.
+static constexpr std::pair<StringLiteral, StringLiteral> kDefaultOps[] = {
+    {"__nv_expf", "math.exp"},
+    {"__nv_exp", "math.exp"},
+    {"__nv_exp2f", "math.exp2"},
+    {"__nv_expm1f", "math.expm1"},
+    {"__nv_logf", "math.log"},
+    {"__nv_log", "math.log"},
+    {"__nv_log2f", "math.log2"},
+    {"__nv_log1pf", "math.log1p"},
+    {"__nv_sqrtf", "math.sqrt"},
+    {"__nv_sqrt", "math.sqrt"},
+    {"__nv_rsqrtf", "math.rsqrt"},
+    {"__nv_sinf", "math.sin"},
+    {"__nv_cosf", "math.cos"},
+    {"__nv_tanf", "math.tan"},
+    {"__nv_tanhf", "math.tanh"},
+    {"__nv_tanh", "math.tanh"},
+    {"__nv_erff", "math.erf"},
+    {"__nv_atanf", "math.atan"},
+    {"__nv_atan2f", "math.atan2"},
+    {"__nv_powf", "math.powf"},
+    {"__nv_fabsf", "math.absf"},
+    {"__nv_floorf", "math.floor"},
+    {"__nv_ceilf", "math.ceil"},
+    {"__nv_truncf", "math.trunc"},
+    {"__nv_roundf", "math.round"},
+    {"__nv_fmaf", "math.fma"},
+    {"__nv_fmaxf", "arith.maxnumf"},
+    {"__nv_fminf", "arith.minnumf"}};
+
+/// Add the entries of the JSON registry file `path` to `entries`, replacing
+/// the entries of the same symbols.
+static LogicalResult loadRegistry(StringRef path, MLIRContext *context,
+                                  llvm::StringMap<LibdeviceEntry> &entries) {
+  Location loc = FileLineColLoc::get(context, path, 0, 0);
+  std::string errorMessage;
+  std::unique_ptr<llvm::MemoryBuffer> file =
+      openInputFile(path, &errorMessage);
+  if (!file)
+    return emitError(loc) << errorMessage;
+  llvm::Expected<std::vector<LibdeviceEntry>> parsed =
+      llvm::json::parse<std::vector<LibdeviceEntry>>(file->getBuffer());
+  if (!parsed) {
+    return emitError(loc) << "invalid libdevice registry: "
+                          << llvm::toString(parsed.takeError());
+  }
+  for (LibdeviceEntry &entry : *parsed) {
+    if (entry.op.empty() == entry.vector.empty()) {
+      return emitError(loc) << "libdevice symbol '" << entry.symbol
+                            << "' needs exactly one of 'op' and 'vector'";
+    }
+    if (!entry.vector.empty() && entry.width <= 0) {
+      return emitError(loc) << "libdevice symbol '" << entry.symbol
+                            << "' needs a positive vector 'width'";
+    }
+    if (!entry.op.empty() &&
+        !RegisteredOperationName::lookup(entry.op, context)) {
+      return emitError(loc) << "unknown op '" << entry.op
+                            << "' for libdevice symbol '" << entry.symbol
+                            << "'";
+    }
+    std::string symbol = entry.symbol;
+    entries[symbol] = std::move(entry);
+  }
+  return success();
+}
+
+/// Get the number of operands of the op `name`, if it is fixed and small.
+static std::optional<int64_t> getFixedNumOperands(OperationName name) {
+  if (name.hasTrait<OpTrait::ZeroOperands>())
+    return 0;
+  if (name.hasTrait<OpTrait::OneOperand>())
+    return 1;
+  if (name.hasTrait<OpTrait::NOperands<2>::Impl>())
+    return 2;
+  if (name.hasTrait<OpTrait::NOperands<3>::Impl>())
+    return 3;
+  return std::nullopt;
+}
+
+/// Check that the op named `opName` is registered, takes one operand per
+/// input of `op` and has one result, so that it computes an element of `op`.
+static LogicalResult checkElementOp(linalg_ext::LibdeviceCallOp op,
+                                    StringRef opName) {
+  std::optional<RegisteredOperationName> name =
+      RegisteredOperationName::lookup(opName, op.getContext());
+  if (!name) {
+    return op.emitError() << "unknown op '" << opName
+                          << "' for libdevice symbol '" << op.getSymbol()
+                          << "'";
+  }
+  std::optional<int64_t> numOperands = getFixedNumOperands(*name);
+  int64_t numInputs = op.getInputs().size();
+  if (!numOperands || *numOperands != numInputs ||
+      !name->hasTrait<OpTrait::OneResult>()) {
+    return op.emitError() << "op '" << opName << "' does not compute the "
+                          << "elements of libdevice symbol '"
+                          << op.getSymbol() << "' from " << numInputs
+                          << " operands";
+  }
+  return success();
+}
+
+/// Lower `op` to a linalg.map applying the op named `opName` to its elements,
+/// which captures the scalar inputs. Return null if `op` has no tensor input.
+static linalg::MapOp lowerToMap(OpBuilder &b, linalg_ext::LibdeviceCallOp op,
+                                StringRef opName) {
+  SmallVector<Value> inputs = llvm::to_vector(
+      llvm::make_filter_range(op.getInputs(), [](Value input) {
+        return isa<ShapedType>(input.getType());
+      }));
+  if (inputs.empty())
+    return nullptr;
+  Type elementType = op.getInitType().getElementType();
+  return b.create<linalg::MapOp>(
+      op.getLoc(), inputs, op.getInit(),
+      [&](OpBuilder &b, Location loc, ValueRange args) {
+        SmallVector<Value> operands;
+        auto arg = args.begin();
+        for (Value input : op.getInputs())
+          operands.push_back(isa<ShapedType>(input.getType()) ? *arg++ : input);
+        OperationState state(loc, opName, operands, elementType);
+        Operation *payloadOp = b.create(state);
+        b.create<linalg::YieldOp>(loc, payloadOp->getResults());
+      });
+}
+
+/// Get the declaration of the function `name` of `type` in the module of
+/// `symbolTable`, declaring it if needed. Return null if `name` is another
+/// symbol.
+static func::FuncOp getOrDeclareFunc(SymbolTable &symbolTable, Location loc,
+                                     StringRef name, FunctionType type) {
+  if (Operation *symbol = symbolTable.lookup(name)) {
+    auto func = dyn_cast<func::FuncOp>(symbol);
+    return func && func.getFunctionType() == type ? func : nullptr;
+  }
+  auto func = func::FuncOp::create(loc, name, type);
+  func.setPrivate();
+  auto module = cast<ModuleOp>(symbolTable.getOp());
+  symbolTable.insert(func, module.getBody()->begin());
+  return func;
+}
+
+/// Lower `op` to a loop nest calling `func` on the vectors of `width`
+/// elements of the innermost dimension. The tails of the rows are read and
+/// written by masked transfers.
+static Value lowerToVectorCalls(OpBuilder &b, linalg_ext::LibdeviceCallOp op,
+                                func::FuncOp func, int64_t width) {
+  Location loc = op.getLoc();
+  Value init = op.getInit();
+  int64_t rank = op.getInitType().getRank();
+  Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  SmallVector<Value> lbs(rank, zero);
+  SmallVector<Value> steps(rank, one);
+  steps.back() = b.create<arith::ConstantIndexOp>(loc, width);
+  SmallVector<Value> ubs =
+      llvm::map_to_vector(llvm::seq<int64_t>(0, rank), [&](int64_t dim) {
+        return b.createOrFold<tensor::DimOp>(loc, init, dim);
+      });
+
+  scf::LoopNest loopNest = scf::buildLoopNest(
+      b, loc, lbs, ubs, steps, init,
+      [&](OpBuilder &b, Location loc, ValueRange ivs,
+          ValueRange iterArgs) -> scf::ValueVector {
+        SmallVector<Value> operands;
+        for (auto [input, type] :
+             llvm::zip(op.getInputs(), func.getArgumentTypes())) {
+          auto vectorType = cast<VectorType>(type);
+          if (!isa<ShapedType>(input.getType())) {
+            operands.push_back(
+                b.create<vector::BroadcastOp>(loc, vectorType, input));
+            continue;
+          }
+          Value padding = b.create<arith::ConstantOp>(
+              loc, b.getZeroAttr(vectorType.getElementType()));
+          operands.push_back(b.create<vector::TransferReadOp>(
+              loc, vectorType, input, ivs, padding));
+        }
+        Value result = b.create<func::CallOp>(loc, func, operands).getResult(0);
+        Value updated =
+            b.create<vector::TransferWriteOp>(loc, result, iterArgs.front(),
+                                              ivs)
+                .getResult();
+        return {updated};
+      });
+  return loopNest.results.front();
+}
+
+namespace {
+struct LowerLibdeviceCallPass
+    : public linalg_ext::LowerLibdeviceCallBase<LowerLibdeviceCallPass> {
+  LowerLibdeviceCallPass() = default;
+  LowerLibdeviceCallPass(const LowerLibdeviceCallPass &) = default;
+
+  LogicalResult initialize(MLIRContext *context) override {
+    for (auto [symbol, opName] : kDefaultOps) {
+      LibdeviceEntry &entry = entries[symbol];
+      entry.symbol = symbol.str();
+      entry.op = opName.str();
+    }
+    if (!registry.empty() && failed(loadRegistry(registry, context, entries)))
+      return failure();
+    RewritePatternSet patterns(context);
+    populateMathPolynomialApproximationPatterns(patterns);
+    approximations = FrozenRewritePatternSet(std::move(patterns));
+    return success();
+  }
+
+  void runOnOperation() override {
+    ModuleOp module = getOperation();
+    SymbolTable symbolTable(module);
+    SmallVector<linalg_ext::LibdeviceCallOp> calls;
+    module.walk([&](linalg_ext::LibdeviceCallOp op) {
+      if (op.hasPureTensorSemantics() && entries.count(op.getSymbol()))
+        calls.push_back(op);
+    });
+
+    IRRewriter rewriter(&getContext());
+    SmallVector<Operation *> approximatedOps;
+    for (linalg_ext::LibdeviceCallOp op : calls) {
+      const LibdeviceEntry &entry = entries.find(op.getSymbol())->second;
+      rewriter.setInsertionPoint(op);
+      if (!entry.op.empty()) {
+        if (failed(checkElementOp(op, entry.op)))
+          return signalPassFailure();
+        linalg::MapOp mapOp = lowerToMap(rewriter, op, entry.op);
+        if (!mapOp)
+          continue;
+        // E.g. the element types the op accepts are only known to its
+        // verifier.
+        if (failed(verify(&mapOp.getMapper().front().front()))) {
+          op.emitError() << "op '" << entry.op
+                         << "' does not compute the elements of libdevice "
+                         << "symbol '" << op.getSymbol() << "'";
+          return signalPassFailure();
+        }
+        if (entry.approximate)
+          approximatedOps.push_back(&mapOp.getMapper().front().front());
+        rewriter.replaceOp(op, mapOp->getResults());
+        continue;
+      }
+
+      if (op.getInitType().getRank() == 0)
+        continue;
+      auto toVectorType = [&](Type type) -> Type {
+        return VectorType::get({entry.width}, getElementTypeOrSelf(type));
+      };
+      SmallVector<Type> inputTypes =
+          llvm::map_to_vector(op.getInputs().getTypes(), toVectorType);
+      Type resultType = toVectorType(op.getInitType());
+      FunctionType funcType = rewriter.getFunctionType(inputTypes, resultType);
+      func::FuncOp func =
+          getOrDeclareFunc(symbolTable, op.getLoc(), entry.vector, funcType);
+      if (!func) {
+        op.emitError() << "'" << entry.vector
+                       << "' is already a symbol of another type";
+        return signalPassFailure();
+      }
+      Value result = lowerToVectorCalls(rewriter, op, func, entry.width);
+      rewriter.replaceOp(op, result);
+    }
+
+    if (!approximatedOps.empty() &&
+        failed(applyOpPatternsAndFold(approximatedOps, approximations)))
+      return signalPassFailure();
+  }
+
+private:
+  llvm::StringMap<LibdeviceEntry> entries;
+  FrozenRewritePatternSet approximations;
+};
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::linalg_ext::createLowerLibdeviceCallPass() {
+  return std::make_unique<LowerLibdeviceCallPass>();
+}
@@ -0,0 +1,163 @@
+//===- ReuseTensorInits.cpp - Reuse dead tensors as inits -------*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+//
+// Every op converted to linalg gets a new tensor.empty init, which one-shot
+// bufferization allocates unless it can tie the init to another buffer. This
+// file ties the inits of the ops which do not read them to the tensors dead
+// after the op, so that the peak of scratch memory of a kernel is bounded by
+// the tensors live at once rather than by the number of ops.
+//
+//===----------------------------------------------------------------------===//
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/AffineMap.h"
+#include "mlir/IR/Block.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/IR/Value.h"
+#include "mlir/Interfaces/DestinationStyleOpInterface.h"
+#include "mlir/Support/LLVM.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+/// Whether the buffer of `value` is allocated for it, i.e. `value` is a
+/// `tensor.empty`, or the result of a destination style op tied to such an
+/// init.
+static bool isOwnedTensor(Value value) {
+  while (auto result = dyn_cast<OpResult>(value)) {
+    Operation *op = result.getOwner();
+    if (isa<tensor::EmptyOp>(op))
+      return true;
+    auto dpsOp = dyn_cast<DestinationStyleOpInterface>(op);
+    if (!dpsOp)
+      return false;
+    value = dpsOp.getTiedOpOperand(result)->get();
+  }
+  return false;
+}
+
+/// Get the last op of `block` using `value`, or the ancestor in `block` of the
+/// last use nested in a region.
+static Operation *getLastUser(Value value, Block *block) {
+  Operation *lastUser = nullptr;
+  for (Operation *user : value.getUsers()) {
+    Operation *ancestor = block->findAncestorOpInBlock(*user);
+    if (!ancestor)
+      return nullptr;
+    if (!lastUser || lastUser->isBeforeInBlock(ancestor))
+      lastUser = ancestor;
+  }
+  return lastUser;
+}
+
+/// Whether the buffer of `value` is free after `op` of `block`, i.e. `value`
+/// is an owned tensor of `block` whose last use is `op`, and which is only
+/// read as the input of destination style ops, so that none of its users
+/// ties its buffer to a result.
+static bool isDeadAfter(Value value, Operation *op, Block *block) {
+  if (value.getParentBlock() != block || !isOwnedTensor(value))
+    return false;
+  bool onlyInputs = llvm::all_of(value.getUses(), [](OpOperand &use) {
+    auto dpsOp = dyn_cast<DestinationStyleOpInterface>(use.getOwner());
+    return dpsOp && dpsOp.isDpsInput(&use);
+  });
+  return onlyInputs && getLastUser(value, block) == op;
+}
+
+/// Whether `init` of `op` may be replaced by any tensor of its type, i.e. it
+/// is a new tensor and `op` does not read it.
+static bool isWriteOnlyInit(linalg::LinalgOp op, OpOperand *init) {
+  return init->get().getDefiningOp<tensor::EmptyOp>() &&
+         !op.payloadUsesValueFromOperand(init);
+}
+
+/// Replace the write-only inits of `op` by tensors dead after it, preferably
+/// its inputs read as the init is written, or else by the last tensors which
+/// died in `deadTensors`. Return the reused tensors.
+static SmallVector<Value> reuseDeadTensors(linalg::LinalgOp op,
+                                           SmallVectorImpl<Value> &deadTensors,
+                                           Block *block) {
+  SmallVector<Value> reused;
+  if (!op.hasPureTensorSemantics())
+    return reused;
+  for (OpOperand &init : op.getDpsInitsMutable()) {
+    if (!isWriteOnlyInit(op, &init))
+      continue;
+    Type type = init.get().getType();
+    AffineMap initMap = op.getMatchingIndexingMap(&init);
+    Value candidate;
+    for (OpOperand *input : op.getDpsInputOperands()) {
+      Value value = input->get();
+      if (value.getType() == type &&
+          op.getMatchingIndexingMap(input) == initMap &&
+          !llvm::is_contained(reused, value) &&
+          isDeadAfter(value, op, block)) {
+        candidate = value;
+        break;
+      }
+    }
+    if (!candidate) {
+      auto it = llvm::find_if(llvm::reverse(deadTensors), [&](Value value) {
+        return value.getType() == type;
+      });
+      if (it == deadTensors.rend())
+        continue;
+      candidate = *it;
+      deadTensors.erase(std::next(it).base());
+    }
+    init.set(candidate);
+    reused.push_back(candidate);
+  }
+  return reused;
+}
+
+/// Reuse the tensors dying in `block` as the write-only inits of the linalg
+/// ops after them.
+static void reuseDeadTensors(Block *block) {
+  // The tensors dead after the ops visited so far, the last dead first.
+  SmallVector<Value> deadTensors;
+  for (Operation &op : *block) {
+    SmallVector<Value> reused;
+    if (auto linalgOp = dyn_cast<linalg::LinalgOp>(&op))
+      reused = reuseDeadTensors(linalgOp, deadTensors, block);
+    for (Value operand : op.getOperands()) {
+      if (isa<RankedTensorType>(operand.getType()) &&
+          !llvm::is_contained(reused, operand) &&
+          !llvm::is_contained(deadTensors, operand) &&
+          isDeadAfter(operand, &op, block))
+        deadTensors.push_back(operand);
+    }
+  }
+}
+
+namespace {
+struct ReuseTensorInitsPass
+    : public linalg_ext::ReuseTensorInitsBase<ReuseTensorInitsPass> {
+  ReuseTensorInitsPass() = default;
+  ReuseTensorInitsPass(const ReuseTensorInitsPass &) = default;
+
+  void runOnOperation() override {
+    getOperation()->walk([](Block *block) { reuseDeadTensors(block); });
+    // Erase the inits which are all replaced.
+    getOperation()->walk([](tensor::EmptyOp emptyOp) {
+      if (emptyOp->use_empty())
+        emptyOp->erase();
+    });
+  }
+};
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::linalg_ext::createReuseTensorInitsPass() {
+  return std::make_unique<ReuseTensorInitsPass>();
+}
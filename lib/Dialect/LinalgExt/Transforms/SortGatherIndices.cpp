@@ -0,0 +1,278 @@
+//===- SortGatherIndices.cpp - Sorted and deduplicated gather ---*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <stdint.h>
+#include <utility>
+
+#include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtOps.h"
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
+#include "mlir/Dialect/Utils/StructuredOpsUtils.h"
+#include "mlir/IR/AffineMap.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Location.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/Value.h"
+#include "mlir/IR/ValueRange.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+/// Check whether the region of `op` only copies the input to the window.
+static bool isCopyRegion(linalg_ext::GatherOp op) {
+  Block &block = op.getRegion().front();
+  if (!llvm::hasSingleElement(block))
+    return false;
+  auto yieldOp = dyn_cast<linalg_ext::ExtYieldOp>(block.getTerminator());
+  return yieldOp && yieldOp->getNumOperands() == 1 &&
+         yieldOp->getOperand(0) == block.getArgument(0);
+}
+
+/// Create a 1-d tensor of `size` elements filled with `value`.
+static Value createFilledTensor(OpBuilder &b, Location loc, int64_t size,
+                                TypedAttr value) {
+  Value fillVal = b.create<arith::ConstantOp>(loc, value);
+  Value empty = b.create<tensor::EmptyOp>(loc, ArrayRef<int64_t>{size},
+                                         value.getType());
+  return b.create<linalg::FillOp>(loc, fillVal, empty).getResult(0);
+}
+
+namespace {
+/// Rewrite a linalg_ext.gather marked with `sort_indices`, whose batch is
+/// 1-d, to load its batches in index order and every repeated index once.
+///
+/// For every batch i, with the masked off batches ordered last:
+///   rank[i]  = position of i in the batches stably sorted by index bucket;
+///   first[i] = first batch loading the same index as i.
+/// The sorted gather loads the batch perm[r] (rank[perm[r]] == r) at r, if
+/// it is the first one of its index, and the window of batch i is then read
+/// back from position rank[first[i]].
+///
+/// The ranks and first batches take O(n^2) compares of the n batches, the
+/// permutation is then scattered from the ranks in O(n). Gathers of more
+/// than `maxBatchSize` batches are not rewritten.
+struct SortGatherIndicesPattern
+    : public OpRewritePattern<linalg_ext::GatherOp> {
+  SortGatherIndicesPattern(MLIRContext *context, int64_t bucketSize,
+                           int64_t maxBatchSize)
+      : OpRewritePattern<linalg_ext::GatherOp>(context),
+        bucketSize(bucketSize), maxBatchSize(maxBatchSize) {}
+
+  LogicalResult matchAndRewrite(linalg_ext::GatherOp op,
+                                PatternRewriter &rewriter) const override {
+    if (!op.getSortIndices() || !op.hasPureTensorSemantics() ||
+        op.getBatchDimNum() != 1 || op.getIndexDepth() != 1 ||
+        !isCopyRegion(op))
+      return failure();
+    ShapedType initTy = op.getInitType();
+    if (!initTy.hasStaticShape())
+      return failure();
+    int64_t batch = initTy.getDimSize(0);
+    if (batch > maxBatchSize)
+      return failure();
+    Location loc = op.getLoc();
+    Type indexElemTy = op.getIndiceType().getElementType();
+    Type i1Ty = rewriter.getI1Type();
+    Type i64Ty = rewriter.getI64Type();
+
+    Value indice = rewriter.create<tensor::CollapseShapeOp>(
+        loc, op.indice(), SmallVector<ReassociationIndices>{{0, 1}});
+    Value mask = op.mask();
+    if (!mask) {
+      mask = rewriter.create<arith::ConstantOp>(
+          loc, DenseElementsAttr::get(RankedTensorType::get(batch, i1Ty),
+                                      rewriter.getBoolAttr(true)));
+    }
+
+    AffineMap iMap = AffineMap::get(2, 0, rewriter.getAffineDimExpr(0));
+    AffineMap jMap = AffineMap::get(2, 0, rewriter.getAffineDimExpr(1));
+    SmallVector<utils::IteratorType> pairIterTypes{
+        utils::IteratorType::parallel, utils::IteratorType::reduction};
+
+    // Compute the rank and the first batch of the same index of every batch.
+    // The ranks are i64 to be scattered as indices.
+    Value rankInit = createFilledTensor(rewriter, loc, batch,
+                                        rewriter.getI64IntegerAttr(0));
+    Value firstInit =
+        createFilledTensor(rewriter, loc, batch, rewriter.getIndexAttr(batch));
+    auto statsOp = rewriter.create<linalg::GenericOp>(
+        loc, TypeRange{rankInit.getType(), firstInit.getType()},
+        ValueRange{indice, indice, mask, mask}, ValueRange{rankInit, firstInit},
+        ArrayRef<AffineMap>{iMap, jMap, iMap, jMap, iMap, iMap}, pairIterTypes,
+        [&](OpBuilder &b, Location loc, ValueRange args) {
+          Value xi = args[0], xj = args[1], mi = args[2], mj = args[3];
+          Value i = b.create<linalg::IndexOp>(loc, 0);
+          Value j = b.create<linalg::IndexOp>(loc, 1);
+          Value ki = xi, kj = xj;
+          if (bucketSize > 1) {
+            Value bucket = b.create<arith::ConstantOp>(
+                loc, b.getIntegerAttr(indexElemTy, bucketSize));
+            ki = b.create<arith::FloorDivSIOp>(loc, xi, bucket);
+            kj = b.create<arith::FloorDivSIOp>(loc, xj, bucket);
+          }
+          // Whether j is before i in (masked off, bucket, batch) order.
+          Value lessKey =
+              b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt, kj, ki);
+          Value sameKey =
+              b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq, kj, ki);
+          Value lessPos =
+              b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::ult, j, i);
+          Value before =
+              b.create<arith::SelectOp>(loc, sameKey, lessPos, lessKey);
+          Value sameMask =
+              b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq, mj, mi);
+          before = b.create<arith::SelectOp>(loc, sameMask, before, mj);
+          Value zero = b.create<arith::ConstantIntOp>(loc, 0, i64Ty);
+          Value one = b.create<arith::ConstantIntOp>(loc, 1, i64Ty);
+          Value rank = b.create<arith::AddIOp>(
+              loc, args[4], b.create<arith::SelectOp>(loc, before, one, zero));
+          Value sameIndex =
+              b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq, xj, xi);
+          Value dup = b.create<arith::AndIOp>(
+              loc, b.create<arith::AndIOp>(loc, mi, mj), sameIndex);
+          Value first = b.create<arith::SelectOp>(
+              loc, dup, b.create<arith::MinSIOp>(loc, args[5], j), args[5]);
+          b.create<linalg::YieldOp>(loc, ValueRange{rank, first});
+        });
+    Value rank = statsOp.getResult(0);
+    Value first = statsOp.getResult(1);
+
+    // Invert the ranks, which are distinct, by scattering every batch to its
+    // rank.
+    AffineMap idMap2d = rewriter.getMultiDimIdentityMap(2);
+    Value iotaInit = rewriter.create<tensor::EmptyOp>(
+        loc, ArrayRef<int64_t>{batch, 1}, i64Ty);
+    Value iota =
+        rewriter
+            .create<linalg::GenericOp>(
+                loc, iotaInit.getType(), ValueRange{}, iotaInit,
+                ArrayRef<AffineMap>{idMap2d},
+                SmallVector<utils::IteratorType>(2,
+                                                 utils::IteratorType::parallel),
+                [&](OpBuilder &b, Location loc, ValueRange args) {
+                  Value i = b.create<linalg::IndexOp>(loc, 0);
+                  b.create<linalg::YieldOp>(
+                      loc, b.create<arith::IndexCastOp>(loc, i64Ty, i)
+                               .getResult());
+                })
+            .getResult(0);
+    Value rankIndice = rewriter.create<tensor::ExpandShapeOp>(
+        loc, RankedTensorType::get({batch, 1}, i64Ty), rank,
+        SmallVector<ReassociationIndices>{{0, 1}});
+    Value permInit =
+        rewriter.create<tensor::EmptyOp>(loc, ArrayRef<int64_t>{batch}, i64Ty);
+    Value perm = rewriter
+                     .create<linalg_ext::ScatterOp>(
+                         loc, ValueRange{iota, rankIndice}, permInit,
+                         ArrayRef<int64_t>{0}, /*rangedData=*/true,
+                         /*overlapWindow=*/false,
+                         [](OpBuilder &b, Location loc, ValueRange args) {
+                           b.create<linalg_ext::ExtYieldOp>(loc, args[0]);
+                         })
+                     ->getResult(0);
+
+    // Sort the indices, masking off the repeated ones.
+    AffineMap idMap = rewriter.getMultiDimIdentityMap(1);
+    Value sortedIndiceInit = rewriter.create<tensor::EmptyOp>(
+        loc, ArrayRef<int64_t>{batch}, indexElemTy);
+    Value sortedMaskInit =
+        rewriter.create<tensor::EmptyOp>(loc, ArrayRef<int64_t>{batch}, i1Ty);
+    auto sortOp = rewriter.create<linalg::GenericOp>(
+        loc, TypeRange{sortedIndiceInit.getType(), sortedMaskInit.getType()},
+        perm, ValueRange{sortedIndiceInit, sortedMaskInit},
+        ArrayRef<AffineMap>{idMap, idMap, idMap},
+        ArrayRef<utils::IteratorType>{utils::IteratorType::parallel},
+        [&](OpBuilder &b, Location loc, ValueRange args) {
+          Value p = b.create<arith::IndexCastOp>(loc, b.getIndexType(),
+                                                 args[0]);
+          Value x = b.create<tensor::ExtractOp>(loc, indice, p);
+          Value m = b.create<tensor::ExtractOp>(loc, mask, p);
+          Value isFirst = b.create<arith::CmpIOp>(
+              loc, arith::CmpIPredicate::eq,
+              b.create<tensor::ExtractOp>(loc, first, p), p);
+          b.create<linalg::YieldOp>(
+              loc, ValueRange{x, b.create<arith::AndIOp>(loc, m, isFirst)});
+        });
+    Value sortedIndice = rewriter.create<tensor::ExpandShapeOp>(
+        loc, op.getIndiceType(), sortOp.getResult(0),
+        SmallVector<ReassociationIndices>{{0, 1}});
+
+    // Gather in the sorted order.
+    Value sortedInit = rewriter.create<tensor::EmptyOp>(
+        loc, initTy.getShape(), initTy.getElementType());
+    auto sortedGatherOp = rewriter.create<linalg_ext::GatherOp>(
+        loc, ValueRange{op.input(), sortedIndice, sortOp.getResult(1)},
+        sortedInit, op.getDimensionMap(), op.getRangedData(),
+        [](OpBuilder &b, Location loc, ValueRange args) {
+          b.create<linalg_ext::ExtYieldOp>(loc, args[0]);
+        });
+    sortedGatherOp.setCacheModeAttr(op.getCacheModeAttr());
+    sortedGatherOp.setEvictModeAttr(op.getEvictModeAttr());
+    sortedGatherOp.setIsVolatile(op.getIsVolatile());
+    Value sortedWindow = sortedGatherOp.getResult()[0];
+
+    // Permute the windows back.
+    int64_t windowRank = initTy.getRank();
+    AffineMap windowMap = rewriter.getMultiDimIdentityMap(windowRank);
+    Value resultInit = rewriter.create<tensor::EmptyOp>(
+        loc, initTy.getShape(), initTy.getElementType());
+    rewriter.replaceOpWithNewOp<linalg::GenericOp>(
+        op, initTy, op.getInit(), resultInit,
+        ArrayRef<AffineMap>{windowMap, windowMap},
+        SmallVector<utils::IteratorType>(windowRank,
+                                         utils::IteratorType::parallel),
+        [&](OpBuilder &b, Location loc, ValueRange args) {
+          SmallVector<Value> indices;
+          for (int64_t i = 0; i < windowRank; ++i)
+            indices.push_back(b.create<linalg::IndexOp>(loc, i));
+          Value m = b.create<tensor::ExtractOp>(loc, mask, indices[0]);
+          // Masked off batches have no first batch, read in bounds anyway.
+          Value f = b.create<arith::SelectOp>(
+              loc, m, b.create<tensor::ExtractOp>(loc, first, indices[0]),
+              indices[0]);
+          indices[0] = b.create<arith::IndexCastOp>(
+              loc, b.getIndexType(),
+              b.create<tensor::ExtractOp>(loc, rank, f));
+          Value v = b.create<tensor::ExtractOp>(loc, sortedWindow, indices);
+          b.create<linalg::YieldOp>(
+              loc, b.create<arith::SelectOp>(loc, m, v, args[0]).getResult());
+        });
+    return success();
+  }
+
+private:
+  int64_t bucketSize;
+  int64_t maxBatchSize;
+};
+
+struct SortGatherIndicesPass
+    : public linalg_ext::SortGatherIndicesBase<SortGatherIndicesPass> {
+  SortGatherIndicesPass() = default;
+  SortGatherIndicesPass(const SortGatherIndicesPass &) = default;
+
+  void runOnOperation() override {
+    Operation *op = getOperation();
+    RewritePatternSet patterns(op->getContext());
+    patterns.add<SortGatherIndicesPattern>(patterns.getContext(), bucketSize,
+                                           maxBatchSize);
+    if (failed(applyPatternsAndFoldGreedily(op, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::linalg_ext::createSortGatherIndicesPass() {
+  return std::make_unique<SortGatherIndicesPass>();
+}
@@ -0,0 +1,451 @@
+//===- TuneTileSizes.cpp - Tune the tile sizes of linalg ops ----*- C++ -*-===//
+//
+// Copyright (C) [2022-2025] by Cambricon.
+//
+//===----------------------------------------------------------------------===//
+//
+// The linalg and linalg_ext ops implement TilingInterface, but nothing picks
+// their tile sizes. This file enumerates the tile sizes of every op, ranks
+// them by a cost model of the cache footprint of a tile, the traffic of all
+// the tiles and the use of the vector registers, and tiles the op with the
+// best ones. The tile sizes are persisted per op signature in a tuning
+// database, where a benchmark harness may replace them by measured ones.
+//
+//===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "triton-linalg/Dialect/LinalgExt/IR/LinalgExtInterface.h"
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/AffineMap.h"
+#include "mlir/IR/Block.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Location.h"
+#include "mlir/IR/Operation.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Interfaces/DestinationStyleOpInterface.h"
+#include "mlir/Interfaces/TilingInterface.h"
+#include "mlir/Support/FileUtilities.h"
+#include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ToolOutputFile.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+/// The fixed cost of a tile, in bytes moved, which accounts for the loop
+/// overhead and the latency of starting a tile.
+static constexpr double kTileOverheadBytes = 256.0;
+
+namespace {
+/// The tuned tile sizes of an op signature, as stored in the database.
+struct TuningEntry {
+  std::string signature;
+  std::vector<int64_t> tileSizes;
+  /// Whether `tileSizes` were measured by a benchmark, or picked by the
+  /// cost model.
+  bool measured = false;
+  /// The best candidates of the cost model, the best first.
+  std::vector<std::vector<int64_t>> candidates;
+};
+
+bool fromJSON(const llvm::json::Value &value, TuningEntry &entry,
+              llvm::json::Path path) {
+  llvm::json::ObjectMapper mapper(value, path);
+  return mapper && mapper.map("signature", entry.signature) &&
+         mapper.map("tile_sizes", entry.tileSizes) &&
+         mapper.mapOptional("measured", entry.measured) &&
+         mapper.mapOptional("candidates", entry.candidates);
+}
+
+llvm::json::Value toJSON(const TuningEntry &entry) {
+  return llvm::json::Object{{"signature", entry.signature},
+                            {"tile_sizes", entry.tileSizes},
+                            {"measured", entry.measured},
+                            {"candidates", entry.candidates}};
+}
+
+/// The static tiling problem of an op.
+struct TilingProblem {
+  /// The static bounds of the loops.
+  SmallVector<int64_t> bounds;
+  /// Whether every loop may be tiled.
+  SmallVector<bool> tileable;
+  /// The indexing maps of the shaped operands, or null if unknown, in which
+  /// case every loop is assumed to index the operand.
+  SmallVector<AffineMap> maps;
+  /// The bytes of an element of the shaped operands.
+  SmallVector<int64_t> elementBytes;
+  /// The loop indexing the innermost dimension of the init, which is
+  /// vectorized, and the number of its elements in a vector register.
+  int64_t vectorLoop = -1;
+  int64_t vectorLanes = 1;
+};
+
+/// Tile sizes along with their estimated cost.
+struct Candidate {
+  SmallVector<int64_t> tileSizes;
+  double cost;
+};
+} // namespace
+
+/// Get the bytes of an element of `type`.
+static int64_t getElementBytes(Type type) {
+  Type elementType = getElementTypeOrSelf(type);
+  if (!elementType.isIntOrFloat())
+    return 8;
+  return std::max<int64_t>(1, elementType.getIntOrFloatBitWidth() / 8);
+}
+
+/// Get the tiling problem of `op`, or nullopt if its iteration domain is not
+/// static.
+static std::optional<TilingProblem> getTilingProblem(TilingInterface op,
+                                                     int64_t vectorBits) {
+  TilingProblem problem;
+  {
+    // The iteration domain may be created as new ops, which are erased with
+    // the scratch block.
+    Block scratch;
+    OpBuilder b = OpBuilder::atBlockEnd(&scratch);
+    for (Range range : op.getIterationDomain(b)) {
+      std::optional<int64_t> offset = getConstantIntValue(range.offset);
+      std::optional<int64_t> size = getConstantIntValue(range.size);
+      std::optional<int64_t> stride = getConstantIntValue(range.stride);
+      if (offset != 0 || stride != 1 || !size || *size <= 0)
+        return std::nullopt;
+      problem.bounds.push_back(*size);
+    }
+  }
+  if (problem.bounds.empty())
+    return std::nullopt;
+
+  auto linalgOp = dyn_cast<linalg::LinalgOp>(op.getOperation());
+  // Only the parallel loops of the ops which are not structured are known to
+  // tile correctly.
+  for (utils::IteratorType iteratorType : op.getLoopIteratorTypes()) {
+    problem.tileable.push_back(linalgOp ||
+                               iteratorType == utils::IteratorType::parallel);
+  }
+
+  auto dpsOp = cast<DestinationStyleOpInterface>(op.getOperation());
+  Value init = dpsOp.getDpsInits().front();
+  problem.vectorLoop = problem.bounds.size() - 1;
+  for (OpOperand &operand : op->getOpOperands()) {
+    if (!isa<ShapedType>(operand.get().getType()))
+      continue;
+    problem.maps.push_back(linalgOp ? linalgOp.getMatchingIndexingMap(&operand)
+                                    : AffineMap());
+    problem.elementBytes.push_back(getElementBytes(operand.get().getType()));
+    if (linalgOp && operand.get() == init) {
+      AffineMap initMap = problem.maps.back();
+      AffineDimExpr innermost;
+      if (initMap.getNumResults() != 0)
+        innermost = dyn_cast<AffineDimExpr>(initMap.getResults().back());
+      problem.vectorLoop = innermost ? innermost.getPosition() : -1;
+    }
+  }
+  problem.vectorLanes =
+      std::max<int64_t>(1, vectorBits / (8 * getElementBytes(init.getType())));
+  return problem;
+}
+
+/// Get the bytes of the operands read or written by a tile of `tileSizes`.
+static int64_t getFootprint(const TilingProblem &problem,
+                            ArrayRef<int64_t> tileSizes) {
+  int64_t volume = 1;
+  for (int64_t size : tileSizes)
+    volume *= size;
+  SmallVector<int64_t> lastIndices =
+      llvm::map_to_vector(tileSizes, [](int64_t size) { return size - 1; });
+  int64_t footprint = 0;
+  for (auto [map, bytes] : llvm::zip(problem.maps, problem.elementBytes)) {
+    int64_t extent = volume;
+    // With non-negative coefficients, the extent of a result of the map is
+    // its value at the last indices of the tile plus one.
+    if (map && map.getNumSymbols() == 0) {
+      extent = 1;
+      for (int64_t lastIndex : map.compose(lastIndices))
+        extent *= lastIndex + 1;
+    }
+    footprint += extent * bytes;
+  }
+  return footprint;
+}
+
+/// Estimate the cost of tiling with `tileSizes`, the lower the better: the
+/// bytes moved into the cache by all the tiles plus the overhead of a tile,
+/// divided by the use of the vector lanes.
+static double estimateCost(const TilingProblem &problem,
+                           ArrayRef<int64_t> tileSizes) {
+  double numTiles = 1;
+  for (auto [bound, size] : llvm::zip(problem.bounds, tileSizes))
+    numTiles *= llvm::divideCeil(bound, size);
+  double utilization = 1;
+  if (problem.vectorLoop >= 0) {
+    int64_t size = tileSizes[problem.vectorLoop];
+    utilization = static_cast<double>(size) /
+                  (llvm::divideCeil(size, problem.vectorLanes) *
+                   problem.vectorLanes);
+  }
+  return numTiles * (getFootprint(problem, tileSizes) + kTileOverheadBytes) /
+         utilization;
+}
+
+/// Get the candidate sizes of a loop of `bound`, in increasing order.
+static SmallVector<int64_t> getCandidateSizes(int64_t bound, bool tileable) {
+  SmallVector<int64_t> sizes;
+  if (tileable) {
+    for (int64_t size = 1; size < bound; size *= 2)
+      sizes.push_back(size);
+  }
+  sizes.push_back(bound);
+  return sizes;
+}
+
+/// Enumerate the tile sizes of the loops from `loop` on whose footprint fits
+/// in `cacheSize`, the sizes of the previous loops being `tileSizes`, and
+/// the sizes of the next ones being their smallest candidates. At most
+/// `maxCandidates` are enumerated, which are the first ones in lexicographic
+/// order of the sizes rather than the cheapest ones.
+static void enumerateCandidates(const TilingProblem &problem,
+                                int64_t cacheSize, int64_t maxCandidates,
+                                SmallVectorImpl<int64_t> &tileSizes,
+                                unsigned loop,
+                                SmallVectorImpl<Candidate> &candidates) {
+  if (static_cast<int64_t>(candidates.size()) >= maxCandidates)
+    return;
+  if (loop == tileSizes.size()) {
+    candidates.push_back(
+        {llvm::to_vector(tileSizes), estimateCost(problem, tileSizes)});
+    return;
+  }
+  int64_t smallest = tileSizes[loop];
+  for (int64_t size :
+       getCandidateSizes(problem.bounds[loop], problem.tileable[loop])) {
+    tileSizes[loop] = size;
+    // The footprint only grows with the sizes.
+    if (getFootprint(problem, tileSizes) > cacheSize)
+      break;
+    enumerateCandidates(problem, cacheSize, maxCandidates, tileSizes, loop + 1,
+                        candidates);
+  }
+  tileSizes[loop] = smallest;
+}
+
+/// Get the candidate tile sizes of `problem`, the best first.
+static SmallVector<Candidate> rankCandidates(const TilingProblem &problem,
+                                             int64_t cacheSize,
+                                             int64_t maxCandidates) {
+  SmallVector<int64_t> tileSizes = llvm::map_to_vector(
+      llvm::zip(problem.bounds, problem.tileable), [](auto loop) {
+        auto [bound, tileable] = loop;
+        return tileable ? int64_t(1) : bound;
+      });
+  SmallVector<Candidate> candidates;
+  enumerateCandidates(problem, cacheSize, maxCandidates, tileSizes, 0,
+                      candidates);
+  // Prefer the larger tiles at equal cost.
+  auto getVolume = [](const Candidate &candidate) {
+    int64_t volume = 1;
+    for (int64_t size : candidate.tileSizes)
+      volume *= size;
+    return volume;
+  };
+  llvm::stable_sort(candidates, [&](const Candidate &a, const Candidate &b) {
+    if (a.cost != b.cost)
+      return a.cost < b.cost;
+    return getVolume(a) > getVolume(b);
+  });
+  return candidates;
+}
+
+/// Get why the stored `tileSizes` cannot tile `problem`, or an empty string if
+/// they can.
+static StringRef getTileSizesMismatch(const TilingProblem &problem,
+                                      ArrayRef<int64_t> tileSizes) {
+  if (tileSizes.size() != problem.bounds.size())
+    return "do not match its loops";
+  for (auto [bound, tileable, size] :
+       llvm::zip(problem.bounds, problem.tileable, tileSizes)) {
+    if (!tileable && size < bound)
+      return "tile a loop which cannot be tiled";
+  }
+  return "";
+}
+
+/// Get the signature of `op` keying its tile sizes in the database: its name,
+/// loop bounds, iterator types and operand element types, e.g.
+/// `linalg.matmul[128x128x128:ppr](f32,f32,f32)`.
+static std::string getSignature(TilingInterface op,
+                                const TilingProblem &problem) {
+  std::string signature;
+  llvm::raw_string_ostream os(signature);
+  os << op->getName() << "[";
+  llvm::interleave(problem.bounds, os, "x");
+  os << ":";
+  for (utils::IteratorType iteratorType : op.getLoopIteratorTypes())
+    os << (iteratorType == utils::IteratorType::parallel ? "p" : "r");
+  os << "](";
+  llvm::interleave(
+      op->getOperandTypes(), os,
+      [&](Type type) { os << getElementTypeOrSelf(type); }, ",");
+  os << ")";
+  return os.str();
+}
+
+/// Load the entries of the tuning database `path` into `entries`. A missing
+/// database is empty.
+static LogicalResult loadDatabase(StringRef path, MLIRContext *context,
+                                  llvm::StringMap<TuningEntry> &entries) {
+  auto file = llvm::MemoryBuffer::getFile(path);
+  if (!file)
+    return success();
+  Location loc = FileLineColLoc::get(context, path, 0, 0);
+  llvm::Expected<std::vector<TuningEntry>> parsed =
+      llvm::json::parse<std::vector<TuningEntry>>((*file)->getBuffer());
+  if (!parsed) {
+    return emitError(loc) << "invalid tuning database: "
+                          << llvm::toString(parsed.takeError());
+  }
+  for (TuningEntry &entry : *parsed) {
+    std::string signature = entry.signature;
+    entries[signature] = std::move(entry);
+  }
+  return success();
+}
+
+/// Write `entries` to the tuning database `path`, sorted by signature.
+static LogicalResult saveDatabase(StringRef path, MLIRContext *context,
+                                  const llvm::StringMap<TuningEntry> &entries) {
+  std::vector<const TuningEntry *> sorted;
+  for (const auto &it : entries)
+    sorted.push_back(&it.second);
+  llvm::sort(sorted, [](const TuningEntry *a, const TuningEntry *b) {
+    return a->signature < b->signature;
+  });
+  llvm::json::Array array;
+  for (const TuningEntry *entry : sorted)
+    array.push_back(toJSON(*entry));
+
+  std::string errorMessage;
+  std::unique_ptr<llvm::ToolOutputFile> output =
+      openOutputFile(path, &errorMessage);
+  if (!output) {
+    return emitError(FileLineColLoc::get(context, path, 0, 0))
+           << errorMessage;
+  }
+  output->os() << llvm::formatv("{0:2}",
+                                llvm::json::Value(std::move(array)))
+               << "\n";
+  output->keep();
+  return success();
+}
+
+namespace {
+struct TuneTileSizesPass
+    : public linalg_ext::TuneTileSizesBase<TuneTileSizesPass> {
+  TuneTileSizesPass() = default;
+  TuneTileSizesPass(const TuneTileSizesPass &) = default;
+
+  void runOnOperation() override {
+    ModuleOp module = getOperation();
+    MLIRContext *context = &getContext();
+    llvm::StringMap<TuningEntry> entries;
+    if (!database.empty() &&
+        failed(loadDatabase(database, context, entries)))
+      return signalPassFailure();
+
+    SmallVector<TilingInterface> ops;
+    module.walk([&](TilingInterface op) {
+      auto dpsOp = dyn_cast<DestinationStyleOpInterface>(op.getOperation());
+      if (dpsOp && dpsOp.hasPureTensorSemantics() &&
+          dpsOp.getNumDpsInits() > 0 &&
+          isa<linalg::LinalgOp, LinalgExtOp>(op.getOperation()))
+        ops.push_back(op);
+    });
+
+    bool updated = false;
+    IRRewriter rewriter(context);
+    for (TilingInterface op : ops) {
+      std::optional<TilingProblem> problem =
+          getTilingProblem(op, vectorBits);
+      if (!problem)
+        continue;
+      std::string signature = getSignature(op, *problem);
+      auto it = entries.find(signature);
+      if (it != entries.end()) {
+        StringRef mismatch =
+            getTileSizesMismatch(*problem, it->second.tileSizes);
+        if (!mismatch.empty()) {
+          op->emitWarning() << "retuning '" << signature
+                            << "' whose tile sizes " << mismatch;
+          entries.erase(it);
+          it = entries.end();
+        }
+      }
+      if (it == entries.end()) {
+        SmallVector<Candidate> candidates =
+            rankCandidates(*problem, cacheSize, maxCandidates);
+        if (candidates.empty())
+          continue;
+        TuningEntry entry;
+        entry.signature = signature;
+        ArrayRef<int64_t> best = candidates.front().tileSizes;
+        entry.tileSizes.assign(best.begin(), best.end());
+        for (const Candidate &candidate :
+             ArrayRef<Candidate>(candidates).take_front(numCandidates)) {
+          entry.candidates.emplace_back(candidate.tileSizes.begin(),
+                                        candidate.tileSizes.end());
+        }
+        it = entries.insert({signature, std::move(entry)}).first;
+        updated = true;
+      }
+
+      // A tile as large as its loop leaves the loop untiled.
+      SmallVector<int64_t> tileSizes;
+      for (auto [bound, size] :
+           llvm::zip(problem->bounds, it->second.tileSizes))
+        tileSizes.push_back(size >= bound ? 0 : std::max<int64_t>(size, 1));
+      if (llvm::all_of(tileSizes, [](int64_t size) { return size == 0; }))
+        continue;
+      scf::SCFTilingOptions options;
+      options.setTileSizes(getAsIndexOpFoldResult(context, tileSizes));
+      rewriter.setInsertionPoint(op);
+      FailureOr<scf::SCFTilingResult> tilingResult =
+          scf::tileUsingSCF(rewriter, op, options);
+      if (failed(tilingResult)) {
+        op->emitWarning() << "failed to tile '" << signature << "'";
+        continue;
+      }
+      rewriter.replaceOp(op, tilingResult->replacements);
+    }
+
+    if (updated && !database.empty() &&
+        failed(saveDatabase(database, context, entries)))
+      return signalPassFailure();
+  }
+};
+} // namespace
+
+std::unique_ptr<Pass> mlir::triton::linalg_ext::createTuneTileSizesPass() {
+  return std::make_unique<TuneTileSizesPass>();
+}
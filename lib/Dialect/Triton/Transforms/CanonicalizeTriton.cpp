@@ -348,7 +348,7 @@ struct CanonicalizeTritonPass
   void runOnOperation() override {
     MLIRContext &ctx = getContext();
     // Canonicalize mask-related ops and its connection.
-    getOperation().walk([&](Operation *op) {
+    getOperation()->walk([&](Operation *op) {
       // Only support arth.andi connections now.
       if (auto andOp = llvm::dyn_cast<arith::AndIOp>(op)) {
         MaskOpsOrganizer organizer(andOp);
@@ -14,14 +14,17 @@
 #include "triton-linalg/Utils/Utils.h"
 
 #include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinAttributeInterfaces.h"
 #include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/BuiltinTypeInterfaces.h"
 #include "mlir/IR/BuiltinTypes.h"
 #include "mlir/IR/Location.h"
+#include "mlir/IR/Matchers.h"
 #include "mlir/IR/OpDefinition.h"
 #include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/TypeUtilities.h"
 #include "mlir/IR/Types.h"
 #include "mlir/IR/Value.h"
 #include "mlir/Support/LLVM.h"
@@ -61,6 +64,51 @@ inline raw_ostream &operator<<(raw_ostream &os, ArrayRef<OpFoldResult> vec) {
   return os;
 }
 
+/// Produce result = lhs % rhs(signed). If both OFRs are Integer Attributes,
+/// result is an Integer Attribute.
+OpFoldResult remOFRs(OpFoldResult lhs, OpFoldResult rhs, Location loc,
+                     OpBuilder &builder) {
+  auto lhsIntAttr = getConstantIntValue(lhs);
+  auto rhsIntAttr = getConstantIntValue(rhs);
+  if (lhsIntAttr && rhsIntAttr && rhsIntAttr.value() != 0)
+    return builder.getIndexAttr(lhsIntAttr.value() % rhsIntAttr.value());
+  auto lhsValue = castToIndexType(builder, loc, lhs);
+  auto rhsValue = castToIndexType(builder, loc, rhs);
+  return builder.create<arith::RemSIOp>(loc, lhsValue, rhsValue).getResult();
+}
+
+/// Produce result = lhs `pred` rhs. If both OFRs are Integer Attributes,
+/// result is an index Attribute of 0 or 1, otherwise it is an i1 value.
+OpFoldResult cmpOFRs(arith::CmpIPredicate pred, OpFoldResult lhs,
+                     OpFoldResult rhs, Location loc, OpBuilder &builder) {
+  auto lhsIntAttr = getConstantIntValue(lhs);
+  auto rhsIntAttr = getConstantIntValue(rhs);
+  if (lhsIntAttr && rhsIntAttr) {
+    bool ret = arith::applyCmpPredicate(pred, APInt(64, lhsIntAttr.value()),
+                                        APInt(64, rhsIntAttr.value()));
+    return builder.getIndexAttr(ret);
+  }
+  auto lhsValue = castToIndexType(builder, loc, lhs);
+  auto rhsValue = castToIndexType(builder, loc, rhs);
+  return builder.create<arith::CmpIOp>(loc, pred, lhsValue, rhsValue)
+      .getResult();
+}
+
+/// Produce result = cond ? lhs : rhs, where cond is a constant or an i1
+/// value. If cond is a constant, no instruction is created.
+OpFoldResult selectOFRs(OpFoldResult cond, OpFoldResult lhs, OpFoldResult rhs,
+                        Location loc, OpBuilder &builder) {
+  if (auto condIntAttr = getConstantIntValue(cond))
+    return condIntAttr.value() ? lhs : rhs;
+  if (isEqualConstantIntOrValue(lhs, rhs))
+    return lhs;
+  auto lhsValue = castToIndexType(builder, loc, lhs);
+  auto rhsValue = castToIndexType(builder, loc, rhs);
+  return builder
+      .create<arith::SelectOp>(loc, cond.get<Value>(), lhsValue, rhsValue)
+      .getResult();
+}
+
 struct Scalar;
 struct SimpleRange;
 struct Mask;
@@ -91,9 +139,13 @@ struct SimpleRange : public StateBase {
   bool isTrackingAxis() const { return axis != kUnknownAxis; }
   bool isAxisTrackingInvalid() const { return isTrackingAxis() && !dims[axis]; }
   void dump() const { llvm::errs() << *this << "\n"; }
+  bool isClamped() const { return lower || upper; }
   int64_t axis{kUnknownAxis};
   /// Range lower bound(strat) and upper bound(end)
   OpFoldResult start, end;
+  /// Optional bounds the values are clamped to by maxsi/minsi with a scalar,
+  /// i.e. the values are max(start + i, lower) or min(start + i, upper).
+  OpFoldResult lower, upper;
 
   /// Init axis value, invalid axis value.
   constexpr static int32_t kUnknownAxis = -1;
@@ -125,7 +177,8 @@ inline raw_ostream &operator<<(raw_ostream &os, const Scalar &s) {
 
 inline raw_ostream &operator<<(raw_ostream &os, const SimpleRange &s) {
   os << "SimpleRange { axis : " << s.axis << "; start : " << s.start
-     << "; end : " << s.end << "; dims : " << s.dims << "; }";
+     << "; end : " << s.end << "; lower : " << s.lower
+     << "; upper : " << s.upper << "; dims : " << s.dims << "; }";
   return os;
 }
 
@@ -184,6 +237,11 @@ private:
       return;
     ret.start = computeFn(ret.start, scalar.scalar, loc, rewriter);
     ret.end = computeFn(ret.end, scalar.scalar, loc, rewriter);
+    // Shifting commutes with clamping.
+    if (ret.lower)
+      ret.lower = computeFn(ret.lower, scalar.scalar, loc, rewriter);
+    if (ret.upper)
+      ret.upper = computeFn(ret.upper, scalar.scalar, loc, rewriter);
   }
   void computeScalarAndScalar(Scalar &ret, const Scalar &scalar) {
     ret.scalar = computeFn(ret.scalar, scalar.scalar, loc, rewriter);
@@ -229,6 +287,192 @@ private:
   }
 };
 
+struct UnionVisitor : public VisitorBase {
+  using VisitorBase::VisitorBase;
+  template <typename T1, typename T2>
+  FailureOr<Result> operator()(const T1 &lhs, const T2 &rhs) {
+    if constexpr (std::is_same_v<Mask, T1> && std::is_same_v<Mask, T2>) {
+      return unionImpl(lhs, rhs);
+    }
+    return failure();
+  }
+
+private:
+  /// The union of two boxes is a box only if they are the same on all the
+  /// dims but one, and the two intervals on that dim overlap. The intervals
+  /// overlap for sure if they share a bound, e.g. two `slt` masks both start
+  /// at 0.
+  FailureOr<Result> unionImpl(const Mask &lhs, const Mask &rhs) {
+    if (lhs.getRank() != rhs.getRank()) {
+      return rewriter.notifyMatchFailure(
+          loc, "Unexpected case where lhs and rhs have different ranks");
+    }
+    auto rank = lhs.getRank();
+    Mask ret = lhs;
+    std::optional<int64_t> unionAxis;
+    for (int64_t i = 0; i < rank; i++) {
+      if (lhs.isAxisTrackingInvalid(i) || rhs.isAxisTrackingInvalid(i) ||
+          !lhs.maskStarts[i] || !rhs.maskStarts[i]) {
+        return rewriter.notifyMatchFailure(loc, "Unknown axis mask state");
+      }
+      if (isEqualConstantIntOrValue(lhs.maskStarts[i], rhs.maskStarts[i]) &&
+          isEqualConstantIntOrValue(lhs.maskEnds[i], rhs.maskEnds[i]))
+        continue;
+      if (unionAxis) {
+        return rewriter.notifyMatchFailure(
+            loc, "Union of masks differing on several axes is not a box");
+      }
+      unionAxis = i;
+    }
+    if (!unionAxis)
+      return Result(ret);
+
+    int64_t i = *unionAxis;
+    auto lhsStart = lhs.maskStarts[i], rhsStart = rhs.maskStarts[i];
+    auto lhsEnd = lhs.maskEnds[i], rhsEnd = rhs.maskEnds[i];
+    bool isOverlapped =
+        isEqualConstantIntOrValue(lhsStart, rhsStart) ||
+        isEqualConstantIntOrValue(lhsEnd, rhsEnd);
+    if (!isOverlapped) {
+      auto ls = getConstantIntValue(lhsStart);
+      auto rs = getConstantIntValue(rhsStart);
+      auto le = getConstantIntValue(lhsEnd);
+      auto re = getConstantIntValue(rhsEnd);
+      isOverlapped = ls && rs && le && re &&
+                     std::max(*ls, *rs) <= std::min(*le, *re);
+    }
+    if (!isOverlapped) {
+      return rewriter.notifyMatchFailure(
+          loc, "Unable to prove the union of masks is continuous");
+    }
+    ret.maskStarts[i] = minOFRs(lhsStart, rhsStart, loc, rewriter);
+    ret.maskEnds[i] = maxOFRs(lhsEnd, rhsEnd, loc, rewriter);
+    ret.dims[i] = subOFRs(ret.maskEnds[i], ret.maskStarts[i], loc, rewriter);
+    return Result(ret);
+  }
+};
+
+struct ClampVisitor : public VisitorBase {
+  ClampVisitor(Location loc, RewriterBase &rewriter, bool isMin)
+      : VisitorBase(loc, rewriter), isMin(isMin) {}
+  template <typename T1, typename T2>
+  FailureOr<Result> operator()(const T1 &t1, const T2 &t2) {
+    if constexpr (std::is_same_v<SimpleRange, T1> &&
+                  std::is_same_v<Scalar, T2>) {
+      return clampRange(t1, t2);
+    }
+    if constexpr (std::is_same_v<SimpleRange, T2> &&
+                  std::is_same_v<Scalar, T1>) {
+      return clampRange(t2, t1);
+    }
+    if constexpr (std::is_same_v<Scalar, T1> && std::is_same_v<Scalar, T2>) {
+      auto ret = t1;
+      ret.scalar = isMin ? minOFRs(t1.scalar, t2.scalar, loc, rewriter)
+                         : maxOFRs(t1.scalar, t2.scalar, loc, rewriter);
+      return Result(ret);
+    }
+    return rewriter.notifyMatchFailure(loc, "Unsupported minsi/maxsi");
+  }
+
+private:
+  bool isMin;
+  FailureOr<Result> clampRange(const SimpleRange &range,
+                               const Scalar &scalar) {
+    if (!range.start || (isMin && range.lower) || (!isMin && range.upper)) {
+      return rewriter.notifyMatchFailure(
+          loc, "Unsupported range clamped on both sides");
+    }
+    auto ret = range;
+    if (isMin) {
+      ret.upper = ret.upper ? minOFRs(ret.upper, scalar.scalar, loc, rewriter)
+                            : scalar.scalar;
+    } else {
+      ret.lower = ret.lower ? maxOFRs(ret.lower, scalar.scalar, loc, rewriter)
+                            : scalar.scalar;
+    }
+    return Result(ret);
+  }
+};
+
+struct RemVisitor : public VisitorBase {
+  using VisitorBase::VisitorBase;
+  template <typename T1, typename T2>
+  FailureOr<Result> operator()(const T1 &lhs, const T2 &rhs) {
+    if constexpr (std::is_same_v<SimpleRange, T1> &&
+                  std::is_same_v<Scalar, T2>) {
+      return remRange(lhs, rhs);
+    }
+    if constexpr (std::is_same_v<Scalar, T1> && std::is_same_v<Scalar, T2>) {
+      auto ret = lhs;
+      ret.scalar = remOFRs(lhs.scalar, rhs.scalar, loc, rewriter);
+      return Result(ret);
+    }
+    return rewriter.notifyMatchFailure(loc, "Unsupported remsi");
+  }
+
+private:
+  /// A range stays a range under remsi only if it lies in a single period,
+  /// which is checked on constants.
+  FailureOr<Result> remRange(const SimpleRange &lhs, const Scalar &rhs) {
+    if (!lhs.start || lhs.isClamped())
+      return rewriter.notifyMatchFailure(loc, "Unsupported remsi range");
+    auto start = getConstantIntValue(lhs.start);
+    auto end = getConstantIntValue(lhs.end);
+    auto period = getConstantIntValue(rhs.scalar);
+    if (!start || !end || !period || *start < 0 || *period <= 0 ||
+        *end <= *start || *start / *period != (*end - 1) / *period) {
+      return rewriter.notifyMatchFailure(
+          loc, "Unable to prove the range lies in a single period");
+    }
+    auto ret = lhs;
+    int64_t base = *start - *start % *period;
+    ret.start = rewriter.getIndexAttr(*start - base);
+    ret.end = rewriter.getIndexAttr(*end - base);
+    return Result(ret);
+  }
+};
+
+struct SelectVisitor : public VisitorBase {
+  SelectVisitor(Location loc, RewriterBase &rewriter, Value cond)
+      : VisitorBase(loc, rewriter), cond(cond) {}
+  template <typename T1, typename T2>
+  FailureOr<Result> operator()(const T1 &lhs, const T2 &rhs) {
+    if constexpr (std::is_same_v<Mask, T1> && std::is_same_v<Mask, T2>) {
+      return selectMask(lhs, rhs);
+    }
+    if constexpr (std::is_same_v<Scalar, T1> && std::is_same_v<Scalar, T2>) {
+      auto ret = lhs;
+      ret.scalar = selectOFRs(cond, lhs.scalar, rhs.scalar, loc, rewriter);
+      return Result(ret);
+    }
+    return rewriter.notifyMatchFailure(loc, "Unsupported select");
+  }
+
+private:
+  /// The condition is uniform, so select each bound of the boxes.
+  Value cond;
+  FailureOr<Result> selectMask(const Mask &lhs, const Mask &rhs) {
+    if (lhs.getRank() != rhs.getRank()) {
+      return rewriter.notifyMatchFailure(
+          loc, "Unexpected case where lhs and rhs have different ranks");
+    }
+    auto rank = lhs.getRank();
+    Mask ret(rank);
+    for (int64_t i = 0; i < rank; i++) {
+      if (lhs.isAxisTrackingInvalid(i) || rhs.isAxisTrackingInvalid(i) ||
+          !lhs.maskStarts[i] || !rhs.maskStarts[i]) {
+        continue;
+      }
+      ret.maskStarts[i] =
+          selectOFRs(cond, lhs.maskStarts[i], rhs.maskStarts[i], loc, rewriter);
+      ret.maskEnds[i] =
+          selectOFRs(cond, lhs.maskEnds[i], rhs.maskEnds[i], loc, rewriter);
+      ret.dims[i] = selectOFRs(cond, lhs.dims[i], rhs.dims[i], loc, rewriter);
+    }
+    return Result(ret);
+  }
+};
+
 struct CmpVisitor : public VisitorBase {
   using VisitorBase::VisitorBase;
   CmpVisitor(Location loc, RewriterBase &rewriter, arith::CmpIPredicate cmpTy)
@@ -255,31 +499,40 @@ private:
     for (int32_t i = 0; i < rank; i++) {
       if (i == lhs.axis && !lhs.isAxisTrackingInvalid()) {
         OpFoldResult newDim;
+        // Normalize the predicate to `< bound` or `>= bound`.
+        OpFoldResult bound;
+        bool isLess;
         switch (cmpTy) {
         case arith::CmpIPredicate::slt: {
-          newDim = cmpSlt(ret, lhs, rhs.scalar, i);
+          bound = rhs.scalar;
+          isLess = true;
+          newDim = cmpSlt(ret, lhs, bound, i);
           break;
         }
         case arith::CmpIPredicate::sle: {
-          auto openedUpperBound =
-              addOFRs(rhs.scalar, rewriter.getIndexAttr(1), loc, rewriter);
-          newDim = cmpSlt(ret, lhs, openedUpperBound, i);
+          bound = addOFRs(rhs.scalar, rewriter.getIndexAttr(1), loc, rewriter);
+          isLess = true;
+          newDim = cmpSlt(ret, lhs, bound, i);
           break;
         }
         case arith::CmpIPredicate::sgt: {
-          auto closedLowerBound =
-              addOFRs(rhs.scalar, rewriter.getIndexAttr(1), loc, rewriter);
-          newDim = cmpSgt(ret, lhs, closedLowerBound, i);
+          bound = addOFRs(rhs.scalar, rewriter.getIndexAttr(1), loc, rewriter);
+          isLess = false;
+          newDim = cmpSgt(ret, lhs, bound, i);
           break;
         }
         case arith::CmpIPredicate::sge: {
-          newDim = cmpSgt(ret, lhs, rhs.scalar, i);
+          bound = rhs.scalar;
+          isLess = false;
+          newDim = cmpSgt(ret, lhs, bound, i);
           break;
         }
         default: {
           return rewriter.notifyMatchFailure(loc, "Unsupport compare type");
         }
         }
+        if (lhs.isClamped())
+          newDim = applyClamp(ret, lhs, bound, isLess, i);
         ret.dims[i] = newDim;
       } else {
         ret.setFullDimensionMask(rewriter, lhs.dims[i], i);
@@ -287,6 +540,30 @@ private:
     }
     return Result(ret);
   }
+  /// Compare a clamped range, based on the mask of the unclamped range:
+  ///   min(x, upper) < bound  <=>  x < bound || upper < bound
+  ///   min(x, upper) >= bound <=>  x >= bound && upper >= bound
+  ///   max(x, lower) < bound  <=>  x < bound && lower < bound
+  ///   max(x, lower) >= bound <=>  x >= bound || lower >= bound
+  /// where the scalar condition makes the mask full or empty.
+  OpFoldResult applyClamp(Mask &ret, const SimpleRange &lhs,
+                          OpFoldResult bound, bool isLess, int32_t i) {
+    OpFoldResult clamp = lhs.upper ? lhs.upper : lhs.lower;
+    auto pred =
+        isLess ? arith::CmpIPredicate::slt : arith::CmpIPredicate::sge;
+    OpFoldResult cond = cmpOFRs(pred, clamp, bound, loc, rewriter);
+    bool isUnion = (lhs.upper && isLess) || (lhs.lower && !isLess);
+    if (isUnion) {
+      ret.maskStarts[i] = selectOFRs(cond, rewriter.getIndexAttr(0),
+                                     ret.maskStarts[i], loc, rewriter);
+      ret.maskEnds[i] =
+          selectOFRs(cond, lhs.dims[i], ret.maskEnds[i], loc, rewriter);
+    } else {
+      ret.maskEnds[i] = selectOFRs(cond, ret.maskEnds[i], ret.maskStarts[i],
+                                   loc, rewriter);
+    }
+    return subOFRs(ret.maskEnds[i], ret.maskStarts[i], loc, rewriter);
+  }
   OpFoldResult cmpSlt(Mask &ret, const SimpleRange &lhs, OpFoldResult openedUb,
                       int32_t i) {
     OpFoldResult absoluteStart, absoluteEnd, newDim;
@@ -592,6 +869,100 @@ public:
     return std::visit(MergeVisitor(loc, rewriter), *lhsState, *rhsState);
   }
 
+  /// Operand is the result of ori.
+  /// The result state is the union of the two operands' boxes, which must be
+  /// a box too.
+  FailureOr<Result> parseOp(arith::OrIOp orOp) {
+    auto lhsState = parse(orOp.getLhs());
+    if (failed(lhsState))
+      return failure();
+
+    auto rhsState = parse(orOp.getRhs());
+    if (failed(rhsState))
+      return failure();
+
+    return std::visit(UnionVisitor(loc, rewriter), *lhsState, *rhsState);
+  }
+
+  /// Operand is the result of remsi.
+  /// The range must lie in a single period of the scalar operand.
+  FailureOr<Result> parseOp(arith::RemSIOp remOp) {
+    auto lhsState = parse(remOp.getLhs());
+    if (failed(lhsState))
+      return failure();
+
+    auto rhsState = parse(remOp.getRhs());
+    if (failed(rhsState))
+      return failure();
+
+    return std::visit(RemVisitor(loc, rewriter), *lhsState, *rhsState);
+  }
+
+  /// Operand is the result of minsi/maxsi.
+  /// One of the operands should be a scalar, which clamps the range.
+  template <typename OpTy,
+            typename = std::enable_if_t<
+                std::is_same_v<OpTy, arith::MinSIOp> ||
+                std::is_same_v<OpTy, arith::MaxSIOp>>>
+  FailureOr<Result> parseOp(OpTy clampOp) {
+    auto lhsState = parse(clampOp.getLhs());
+    if (failed(lhsState))
+      return failure();
+
+    auto rhsState = parse(clampOp.getRhs());
+    if (failed(rhsState))
+      return failure();
+
+    bool isMin = std::is_same_v<OpTy, arith::MinSIOp>;
+    return std::visit(ClampVisitor(loc, rewriter, isMin), *lhsState,
+                      *rhsState);
+  }
+
+  /// Operand is the result of select.
+  /// A mask selected with a constant false or true is an andi or ori, and a
+  /// uniform condition selects the bounds of the two operands' boxes.
+  FailureOr<Result> parseOp(arith::SelectOp selectOp) {
+    Value cond = selectOp.getCondition();
+    Value trueValue = selectOp.getTrueValue();
+    Value falseValue = selectOp.getFalseValue();
+    if (getElementTypeOrSelf(selectOp.getType()).isInteger(1) &&
+        cond.getType().isa<ShapedType>()) {
+      if (matchPattern(falseValue, m_Zero()) ||
+          matchPattern(trueValue, m_One())) {
+        auto condState = parse(cond);
+        if (failed(condState))
+          return failure();
+        bool isAnd = matchPattern(falseValue, m_Zero());
+        auto valueState = parse(isAnd ? trueValue : falseValue);
+        if (failed(valueState))
+          return failure();
+        if (isAnd) {
+          return std::visit(MergeVisitor(loc, rewriter), *condState,
+                            *valueState);
+        }
+        return std::visit(UnionVisitor(loc, rewriter), *condState,
+                          *valueState);
+      }
+    }
+
+    // Look through the splat of a scalar condition.
+    if (auto splatOp = cond.getDefiningOp<triton::SplatOp>())
+      cond = splatOp.getSrc();
+    if (cond.getType().isa<ShapedType>())
+      return rewriter.notifyMatchFailure(loc, "Unsupported select condition");
+
+    auto lhsState = parse(trueValue);
+    if (failed(lhsState))
+      return failure();
+
+    auto rhsState = parse(falseValue);
+    if (failed(rhsState))
+      return failure();
+
+    return std::visit(SelectVisitor(loc, rewriter, cond), *lhsState,
+                      *rhsState);
+  }
+
   /// Operand is the result of cmpi. Only support slt/sgt/sle/sgt for now.
   /// For that dimension, calculate this new dim as:
   ///   slt: dim = min(end, value) - start.
@@ -747,7 +1118,8 @@ public:
 
     return llvm::TypeSwitch<Operation *, FailureOr<Result>>(defOp)
         .Case<arith::ConstantOp, arith::AddIOp, arith::AndIOp, arith::CmpIOp,
-              arith::SubIOp, arith::ExtSIOp, arith::TruncIOp,
+              arith::SubIOp, arith::ExtSIOp, arith::TruncIOp, arith::OrIOp,
+              arith::RemSIOp, arith::MinSIOp, arith::MaxSIOp, arith::SelectOp,
               triton::MakeRangeOp, triton::BroadcastOp, triton::ExpandDimsOp,
               triton::SplatOp, triton::TransOp>(
             [&](auto op) { return parseOp(op); })
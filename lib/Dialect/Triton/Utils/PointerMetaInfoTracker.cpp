@@ -40,6 +40,7 @@ template <>
 LogicalResult TensorPointerMetaInfoTracker::parseOp<triton::MakeTensorPtrOp>(
     triton::MakeTensorPtrOp op, Location loc,
     ConversionPatternRewriter &rewriter) {
+  this->makeTensorPtr = op;
   this->base = op.getBase();
   this->order = op.getOrder();
   size_t size = op.getOffsets().size();
@@ -10,11 +10,15 @@
 #include "mlir/IR/Attributes.h"
 #include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/Diagnostics.h"
+#include "mlir/IR/Operation.h"
 #include "llvm/ADT/StringRef.h"
 
 using namespace mlir;
 using namespace mlir::triton;
 
+#include "triton-linalg/Dialect/Utils/MemoryHintsEnums.cpp.inc"
+
 bool mlir::triton::isLinearMemory(::mlir::ModuleOp op) {
   if (auto attr = op->getAttr(getIsLinearMemoryAttrKey())) {
     assert(attr.dyn_cast<BoolAttr>() && "Invalid linear attribute type");
@@ -25,3 +29,20 @@ bool mlir::triton::isLinearMemory(::mlir::ModuleOp op) {
   return false;
 }
 
+LogicalResult mlir::triton::verifyMemoryHints(Operation *op) {
+  if (auto cacheMode = op->getAttrOfType<StringAttr>(getCacheModeAttrKey())) {
+    if (cacheMode.getValue() != "cmnormal" &&
+        cacheMode.getValue() != "cmtransient")
+      return op->emitError("expected legal cache mode but found ")
+             << cacheMode.getValue();
+  }
+  return success();
+}
+
+void mlir::triton::copyMemoryHints(Operation *from, Operation *to) {
+  for (StringRef key : {getCacheModeAttrKey(), getEvictModeAttrKey(),
+                        getIsVolatileAttrKey()}) {
+    if (auto attr = from->getAttr(key))
+      to->setAttr(key, attr);
+  }
+}
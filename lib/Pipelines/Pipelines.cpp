@@ -10,43 +10,63 @@
 #include "triton-linalg/Conversion/Passes.h"
 #include "triton-linalg/Dialect/Triton/Transforms/Passes.h"
 #include "triton-linalg/Dialect/Arith/Transforms/Passes.h"
+#include "triton-linalg/Dialect/LinalgExt/Transforms/Passes.h"
 #include "triton-linalg/Pipelines/Pipelines.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "triton/Dialect/Triton/IR/Dialect.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Pass/PassRegistry.h"
 #include "mlir/Transforms/Passes.h"
 #include "llvm/ADT/StringRef.h"
 #include <functional>
 
-namespace {
-void buildTritonToLinalgPipeline(mlir::OpPassManager &pm) {
-  pm.addPass(mlir::triton::createWrapFuncBodyWithSingleBlockPass());
+void ::mlir::triton::buildTritonToLinalgPipeline(
+    mlir::OpPassManager &pm, const TritonToLinalgPipelineOptions &options) {
+  // Everything but inlining, the function signature conversion and the
+  // lowering of libdevice calls, which declares vector library functions in
+  // the module, is nested under the functions, so that the pass manager
+  // compiles the kernels of a module in parallel.
+  pm.addNestedPass<mlir::triton::FuncOp>(
+      mlir::triton::createWrapFuncBodyWithSingleBlockPass());
   pm.addPass(mlir::createInlinerPass({}, nullptr));
   pm.addPass(mlir::createCanonicalizerPass());
-  pm.addPass(mlir::triton::createCanonicalizeTritonPass());
-  pm.addPass(mlir::triton::arith_ext::createArithCanonicalizerPass());
-  pm.addPass(mlir::triton::createPointerStrengthReductionPass());
+  mlir::OpPassManager &ttFuncPm = pm.nest<mlir::triton::FuncOp>();
+  ttFuncPm.addPass(mlir::triton::createCanonicalizeTritonPass());
+  ttFuncPm.addPass(mlir::triton::arith_ext::createArithCanonicalizerPass());
+  ttFuncPm.addPass(mlir::triton::createPointerStrengthReductionPass());
   // Since canonicalizer pass may convert single block function to multi-blocks,
   // we rerun this pass here.
-  pm.addPass(mlir::triton::createTritonToTensorPass());
-  pm.addPass(mlir::createCanonicalizerPass());
-  pm.addPass(mlir::triton::createTritonToLinalgPass());
-  pm.addNestedPass<mlir::func::FuncOp>(mlir::triton::createExtractLikeMoveBackwardPass());
-  pm.addPass(mlir::createCanonicalizerPass());
-  pm.addPass(mlir::triton::createArithToLinalgPass());
-  pm.addPass(mlir::triton::createMathToLinalgPass());
-  pm.addPass(mlir::createCSEPass());
-  pm.addPass(mlir::createLoopInvariantCodeMotionPass());
-  pm.addPass(mlir::triton::createWrapFuncBodyWithSingleBlockPass());
-  pm.addPass(mlir::triton::arith_ext::createArithCanonicalizerPass());
-}
+  ttFuncPm.addPass(mlir::triton::createTritonToTensorPass());
+  ttFuncPm.addPass(mlir::createCanonicalizerPass());
+  pm.addPass(mlir::triton::createTritonFuncToFuncPass());
+  mlir::OpPassManager &funcPm = pm.nest<mlir::func::FuncOp>();
+  funcPm.addPass(mlir::triton::createTritonToLinalgFuncPass());
+  funcPm.addPass(mlir::triton::createExtractLikeMoveBackwardPass());
+  funcPm.addPass(mlir::createCanonicalizerPass());
+  if (options.sortGatherIndices)
+    funcPm.addPass(mlir::triton::linalg_ext::createSortGatherIndicesPass());
+  if (options.combineAtomicRMW)
+    funcPm.addPass(mlir::triton::linalg_ext::createCombineAtomicRMWPass());
+  funcPm.addPass(mlir::triton::createArithToLinalgPass());
+  funcPm.addPass(mlir::triton::createMathToLinalgPass());
+  pm.addPass(mlir::triton::linalg_ext::createLowerLibdeviceCallPass());
+  mlir::OpPassManager &fusionPm = pm.nest<mlir::func::FuncOp>();
+  fusionPm.addPass(mlir::createCSEPass());
+  fusionPm.addPass(mlir::triton::linalg_ext::createFuseRowNormalizationPass());
+  fusionPm.addPass(mlir::triton::linalg_ext::createFoldSplatOperandsPass());
+  fusionPm.addPass(mlir::triton::linalg_ext::createFuseElementwisePass());
+  fusionPm.addPass(mlir::triton::linalg_ext::createReuseTensorInitsPass());
+  fusionPm.addPass(mlir::createLoopInvariantCodeMotionPass());
+  fusionPm.addPass(mlir::triton::createWrapFuncBodyWithSingleBlockPass());
+  fusionPm.addPass(mlir::triton::arith_ext::createArithCanonicalizerPass());
 }
 
 void ::mlir::triton::registerTritonLinalgPipelines() {
-  PassPipelineRegistration<> triton_to_linalg(
+  PassPipelineRegistration<TritonToLinalgPipelineOptions> triton_to_linalg(
       "triton-to-linalg",
       "Runs the triton to linalg dialect transformation pipeline",
-      [](OpPassManager &passManager) {
-        buildTritonToLinalgPipeline(passManager);
+      [](OpPassManager &passManager,
+         const TritonToLinalgPipelineOptions &options) {
+        buildTritonToLinalgPipeline(passManager, options);
       });
 }
@@ -0,0 +1,74 @@
+# RUN: %PYTHON %s
+
+import os
+import sys
+import tempfile
+import unittest
+from unittest import mock
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), "..", "..", "backend"))
+import compiler  # noqa: E402
+
+
+class LinalgCacheTest(unittest.TestCase):
+
+    def setUp(self):
+        self._dir = tempfile.TemporaryDirectory()
+        self.cache_dir = self._dir.name
+
+    def tearDown(self):
+        self._dir.cleanup()
+
+    def _set_mtime(self, cache, key, mtime_ns):
+        os.utime(cache._path(key), ns=(mtime_ns, mtime_ns))
+
+    def test_put_get(self):
+        cache = compiler.LinalgCache(self.cache_dir)
+        self.assertIsNone(cache.get("a"))
+        cache.put("a", "module {}")
+        self.assertEqual(cache.get("a"), "module {}")
+        cache.put("a", "module {\n}")
+        self.assertEqual(cache.get("a"), "module {\n}")
+        self.assertEqual(cache.stats(), {"hits": 2, "misses": 1, "evictions": 0})
+        # The temporary files are renamed into place.
+        self.assertEqual(sorted(os.listdir(self.cache_dir)), ["a" + compiler._ENTRY_SUFFIX])
+
+    def test_persists_across_instances(self):
+        compiler.LinalgCache(self.cache_dir).put("a", "x" * 10)
+        cache = compiler.LinalgCache(self.cache_dir)
+        self.assertEqual(cache.get("a"), "x" * 10)
+        self.assertEqual(cache._size, 10)
+
+    def test_evicts_least_recently_used(self):
+        cache = compiler.LinalgCache(self.cache_dir, max_size=25)
+        cache.put("a", "x" * 10)
+        cache.put("b", "x" * 10)
+        self._set_mtime(cache, "a", 1_000_000_000)
+        self._set_mtime(cache, "b", 2_000_000_000)
+        # Reading `a` makes `b` the least recently used entry.
+        self.assertIsNotNone(cache.get("a"))
+        cache.put("c", "x" * 10)
+        self.assertIsNone(cache.get("b"))
+        self.assertIsNotNone(cache.get("a"))
+        self.assertIsNotNone(cache.get("c"))
+        self.assertEqual(cache.stats()["evictions"], 1)
+        self.assertEqual(cache._size, 20)
+
+    def test_only_counts_own_evictions(self):
+        cache = compiler.LinalgCache(self.cache_dir, max_size=15)
+        cache.put("a", "x" * 10)
+        # Another process removes the entry between the scan and the unlink.
+        with mock.patch.object(compiler.os, "unlink", side_effect=FileNotFoundError):
+            cache.put("b", "x" * 10)
+        self.assertEqual(cache.stats()["evictions"], 0)
+
+    def test_put_does_not_scan_below_cap(self):
+        cache = compiler.LinalgCache(self.cache_dir, max_size=100)
+        with mock.patch.object(compiler.LinalgCache, "_scan", side_effect=AssertionError):
+            cache.put("a", "x" * 10)
+            cache.put("b", "x" * 10)
+        self.assertEqual(cache._size, 20)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -354,10 +354,12 @@ func.func @arith_select(%arg0: tensor<128xi1>, %arg1: tensor<128xf32>, %arg2: te
 
 // -----
 func.func @arith_select_scalar_condition(%arg0: i1, %arg1: tensor<128xf32>, %arg2: tensor<128xf32>) {
-  // CHECK: %[[INIT1:.*]] = tensor.empty() : tensor<128xi1>
-  // CHECK: %[[FILL:.*]] = linalg.fill ins(%arg0 : i1) outs(%[[INIT1]] : tensor<128xi1>) -> tensor<128xi1>
-  // CHECK: %[[INIT2:.*]] = tensor.empty() : tensor<128xf32>
-  // CHECK: %[[MAPPED:.*]] = linalg.map { arith.select } ins(%[[FILL]], %arg1, %arg2 : tensor<128xi1>, tensor<128xf32>, tensor<128xf32>) outs(%[[INIT2]] : tensor<128xf32>)
+  // CHECK-NOT: linalg.fill
+  // CHECK: %[[INIT:.*]] = tensor.empty() : tensor<128xf32>
+  // CHECK: %[[MAPPED:.*]] = linalg.map ins(%arg1, %arg2 : tensor<128xf32>, tensor<128xf32>) outs(%[[INIT]] : tensor<128xf32>)
+  // CHECK-NEXT: (%[[IN:.*]]: f32, %[[IN1:.*]]: f32) {
+  // CHECK-NEXT: %[[SEL:.*]] = arith.select %arg0, %[[IN]], %[[IN1]] : f32
+  // CHECK-NEXT: linalg.yield %[[SEL]] : f32
   %0 = arith.select %arg0, %arg1, %arg2 : tensor<128xf32>
   return
 }
@@ -367,10 +369,10 @@ func.func @arith_select_scalar_condition(%arg0: i1, %arg1: tensor<128xf32>, %arg
 func.func @arith_select_scalar_condition_dynamic_output(%arg0: i1, %arg1: tensor<?xf32>, %arg2: tensor<?xf32>) {
   // CHECK: %[[C0:.*]] = arith.constant 0 : index
   // CHECK: %[[DIM:.*]] = tensor.dim %arg1, %[[C0]] : tensor<?xf32>
-  // CHECK: %[[INIT1:.*]] = tensor.empty(%[[DIM]]) : tensor<?xi1>
-  // CHECK: %[[FILL:.*]] = linalg.fill ins(%arg0 : i1) outs(%[[INIT1]] : tensor<?xi1>) -> tensor<?xi1>
-  // CHECK: %[[INIT2:.*]] = tensor.empty(%[[DIM]]) : tensor<?xf32>
-  // CHECK: %[[MAPPED:.*]] = linalg.map { arith.select } ins(%[[FILL]], %arg1, %arg2 : tensor<?xi1>, tensor<?xf32>, tensor<?xf32>) outs(%[[INIT2]] : tensor<?xf32>)
+  // CHECK-NOT: linalg.fill
+  // CHECK: %[[INIT:.*]] = tensor.empty(%[[DIM]]) : tensor<?xf32>
+  // CHECK: %[[MAPPED:.*]] = linalg.map ins(%arg1, %arg2 : tensor<?xf32>, tensor<?xf32>) outs(%[[INIT]] : tensor<?xf32>)
+  // CHECK: arith.select %arg0
   %0 = arith.select %arg0, %arg1, %arg2 : tensor<?xf32>
   return
 }
@@ -0,0 +1,93 @@
+// RUN: triton-linalg-opt --convert-triton-to-linalg %s -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @atomic_add_contiguous
+// CHECK: %[[VIEW:.*]] = aux.view
+// CHECK: %[[SRC:.*]] = bufferization.to_tensor %[[VIEW]] restrict writable
+// CHECK: %[[INIT:.*]] = tensor.empty() : tensor<16x32xf32>
+// CHECK: %[[RES:.*]] = linalg_ext.atomic_rmw addf ins(%[[SRC]], %arg1 : tensor<16x32xf32>, tensor<16x32xf32>) outs(%[[INIT]] : tensor<16x32xf32>) -> tensor<16x32xf32>
+// CHECK-NOT: linalg_ext.gather_atomic_rmw
+tt.func @atomic_add_contiguous(%arg0: !tt.ptr<f32>, %arg1: tensor<16x32xf32>) -> tensor<16x32xf32> {
+  %c32_i32 = arith.constant dense<32> : tensor<16x1xi32>
+  %0 = tt.make_range {end = 16 : i32, start = 0 : i32} : tensor<16xi32>
+  %1 = tt.expand_dims %0 {axis = 1 : i32} : tensor<16xi32> -> tensor<16x1xi32>
+  %2 = arith.muli %1, %c32_i32 : tensor<16x1xi32>
+  %3 = tt.broadcast %2 : tensor<16x1xi32> -> tensor<16x32xi32>
+  %4 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+  %5 = tt.expand_dims %4 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+  %6 = tt.broadcast %5 : tensor<1x32xi32> -> tensor<16x32xi32>
+  %7 = arith.addi %3, %6 : tensor<16x32xi32>
+  %8 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<16x32x!tt.ptr<f32>>
+  %9 = tt.addptr %8, %7 : tensor<16x32x!tt.ptr<f32>>, tensor<16x32xi32>
+  %10 = tt.atomic_rmw fadd, acq_rel, gpu, %9, %arg1 : (tensor<16x32x!tt.ptr<f32>>, tensor<16x32xf32>) -> tensor<16x32xf32>
+  tt.return %10 : tensor<16x32xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @atomic_add_contiguous_masked
+// CHECK: %[[VIEW:.*]] = aux.view
+// CHECK: %[[VAL:.*]] = tensor.extract_slice %arg1[0] [%[[SIZE:.*]]] [1] : tensor<128xf32> to tensor<?xf32>
+// CHECK: %[[SRC:.*]] = bufferization.to_tensor %[[VIEW]] restrict writable
+// CHECK: %[[INIT:.*]] = tensor.empty(%[[SIZE]]) : tensor<?xf32>
+// CHECK: %[[RES:.*]] = linalg_ext.atomic_rmw addf ins(%[[SRC]], %[[VAL]] : tensor<?xf32>, tensor<?xf32>) outs(%[[INIT]] : tensor<?xf32>) -> tensor<?xf32>
+// CHECK: linalg_ext.pad ins(%[[RES]] : tensor<?xf32>) outs(%{{.*}} : tensor<128xf32>)
+tt.func @atomic_add_contiguous_masked(%arg0: !tt.ptr<f32>, %arg1: tensor<128xf32>, %arg2: i32) -> tensor<128xf32> {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg2 : i32 -> tensor<128xi32>
+  %2 = arith.cmpi slt, %0, %1 : tensor<128xi32>
+  %3 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %4 = tt.addptr %3, %0 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %5 = tt.atomic_rmw fadd, acq_rel, gpu, %4, %arg1, %2 : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>, tensor<128xi1>) -> tensor<128xf32>
+  tt.return %5 : tensor<128xf32>
+}
+
+// -----
+// Distinct offsets are not combined.
+// CHECK-LABEL: func.func @atomic_add_scattered
+// CHECK-NOT: linalg_ext.atomic_rmw
+// CHECK: linalg_ext.gather_atomic_rmw addf ins(
+tt.func @atomic_add_scattered(%arg0: !tt.ptr<f32>, %arg1: tensor<128xf32>, %arg2: tensor<128xi32>) -> tensor<128xf32> {
+  %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %1 = tt.addptr %0, %arg2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %2 = tt.atomic_rmw fadd, acq_rel, gpu, %1, %arg1 : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> tensor<128xf32>
+  tt.return %2 : tensor<128xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @atomic_add_loaded_offsets
+// CHECK: linalg_ext.gather_atomic_rmw addf {combine_indices} ins(
+tt.func @atomic_add_loaded_offsets(%arg0: !tt.ptr<f32>, %arg1: tensor<128xf32>, %arg2: !tt.ptr<i32>) -> tensor<128xf32> {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg2 : !tt.ptr<i32> -> tensor<128x!tt.ptr<i32>>
+  %2 = tt.addptr %1, %0 : tensor<128x!tt.ptr<i32>>, tensor<128xi32>
+  %3 = tt.load %2 : tensor<128x!tt.ptr<i32>>
+  %4 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %5 = tt.addptr %4, %3 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %6 = tt.atomic_rmw fadd, acq_rel, gpu, %5, %arg1 : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> tensor<128xf32>
+  tt.return %6 : tensor<128xf32>
+}
+
+// -----
+// The offsets repeat along the broadcast dim.
+// CHECK-LABEL: func.func @atomic_add_repeated_offsets
+// CHECK: linalg_ext.gather_atomic_rmw addf {combine_indices} ins(
+tt.func @atomic_add_repeated_offsets(%arg0: !tt.ptr<f32>, %arg1: tensor<16x8xf32>, %arg2: tensor<16xi32>) -> tensor<16x8xf32> {
+  %0 = tt.expand_dims %arg2 {axis = 1 : i32} : tensor<16xi32> -> tensor<16x1xi32>
+  %1 = tt.broadcast %0 : tensor<16x1xi32> -> tensor<16x8xi32>
+  %2 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<16x8x!tt.ptr<f32>>
+  %3 = tt.addptr %2, %1 : tensor<16x8x!tt.ptr<f32>>, tensor<16x8xi32>
+  %4 = tt.atomic_rmw fadd, acq_rel, gpu, %3, %arg1 : (tensor<16x8x!tt.ptr<f32>>, tensor<16x8xf32>) -> tensor<16x8xf32>
+  tt.return %4 : tensor<16x8xf32>
+}
+
+// -----
+// A scalar loaded from memory only moves the base.
+// CHECK-LABEL: func.func @atomic_add_scalar_loaded_base
+// CHECK: linalg_ext.gather_atomic_rmw addf ins(
+tt.func @atomic_add_scalar_loaded_base(%arg0: !tt.ptr<f32>, %arg1: tensor<128xf32>, %arg2: tensor<128xi32>, %arg3: !tt.ptr<i32>) -> tensor<128xf32> {
+  %0 = tt.load %arg3 : !tt.ptr<i32>
+  %1 = tt.addptr %arg0, %0 : !tt.ptr<f32>, i32
+  %2 = tt.splat %1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %3 = tt.addptr %2, %arg2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %4 = tt.atomic_rmw fadd, acq_rel, gpu, %3, %arg1 : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> tensor<128xf32>
+  tt.return %4 : tensor<128xf32>
+}
@@ -0,0 +1,138 @@
+// RUN: triton-linalg-opt --convert-triton-to-linalg %s -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @block_ptr_in_loop
+// CHECK: %[[VIEW:.*]] = aux.view
+// CHECK: scf.for
+// CHECK-NOT: aux.view
+// CHECK: %[[BLOCK:.*]] = memref.subview %[[VIEW]]
+// CHECK: bufferization.to_tensor %[[BLOCK]]
+// CHECK: linalg_ext.pad
+// CHECK: memref.subview
+// CHECK: bufferization.materialize_in_destination
+tt.func @block_ptr_in_loop(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<f32>, %arg2: i64, %arg3: i64) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %c0_i32 = arith.constant 0 : i32
+  %c16_i32 = arith.constant 16 : i32
+  %c1_i64 = arith.constant 1 : i64
+  %0 = scf.for %arg4 = %c0 to %c4 step %c1 iter_args(%arg5 = %c0_i32) -> (i32) {
+    %1 = tt.make_tensor_ptr %arg0, [%arg2, %arg3], [%arg3, %c1_i64], [%c0_i32, %arg5] {order = array<i32: 1, 0>} : <tensor<16x16xf32>>
+    %2 = tt.load %1 {boundaryCheck = array<i32: 0, 1>, padding = 1 : i32} : !tt.ptr<tensor<16x16xf32>>
+    %3 = tt.make_tensor_ptr %arg1, [%arg2, %arg3], [%arg3, %c1_i64], [%c0_i32, %arg5] {order = array<i32: 1, 0>} : <tensor<16x16xf32>>
+    tt.store %3, %2 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<16x16xf32>>
+    %4 = arith.addi %arg5, %c16_i32 : i32
+    scf.yield %4 : i32
+  }
+  tt.return
+}
+
+// -----
+// Without padding option the padded elements are undefined, the in-bounds
+// block is inserted into an empty tensor.
+// CHECK-LABEL: func.func @block_ptr_boundary_check_without_padding
+// CHECK: %[[BLOCK:.*]] = memref.subview
+// CHECK: %[[TENSOR:.*]] = bufferization.to_tensor %[[BLOCK]]
+// CHECK: %[[COPY:.*]] = linalg.copy ins(%[[TENSOR]] : tensor<?xf32>)
+// CHECK: %[[EMPTY:.*]] = tensor.empty() : tensor<8xf32>
+// CHECK-NOT: linalg.fill
+// CHECK-NOT: linalg_ext.pad
+// CHECK: tensor.insert_slice %[[COPY]] into %[[EMPTY]][%{{.*}}] [%{{.*}}] [1]
+tt.func @block_ptr_boundary_check_without_padding(%arg0: !tt.ptr<f32>, %arg1: i64, %arg2: i32) -> tensor<8xf32> {
+  %c1_i64 = arith.constant 1 : i64
+  %0 = tt.make_tensor_ptr %arg0, [%arg1], [%c1_i64], [%arg2] {order = array<i32: 0>} : <tensor<8xf32>>
+  %1 = tt.load %0 {boundaryCheck = array<i32: 0>} : !tt.ptr<tensor<8xf32>>
+  tt.return %1 : tensor<8xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @block_ptr_boundary_check_zero_padding
+// CHECK: %[[BLOCK:.*]] = memref.subview
+// CHECK: %[[TENSOR:.*]] = bufferization.to_tensor %[[BLOCK]]
+// CHECK: %[[COPY:.*]] = linalg.copy ins(%[[TENSOR]] : tensor<?xf32>)
+// CHECK: %[[ZERO:.*]] = arith.constant 0.000000e+00 : f32
+// CHECK-NOT: tensor.insert_slice
+// CHECK: linalg_ext.pad ins(%[[COPY]] : tensor<?xf32>) outs(%{{.*}} : tensor<8xf32>) pvalue(%[[ZERO]] : f32)
+tt.func @block_ptr_boundary_check_zero_padding(%arg0: !tt.ptr<f32>, %arg1: i64, %arg2: i32) -> tensor<8xf32> {
+  %c1_i64 = arith.constant 1 : i64
+  %0 = tt.make_tensor_ptr %arg0, [%arg1], [%c1_i64], [%arg2] {order = array<i32: 0>} : <tensor<8xf32>>
+  %1 = tt.load %0 {boundaryCheck = array<i32: 0>, padding = 1 : i32} : !tt.ptr<tensor<8xf32>>
+  tt.return %1 : tensor<8xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @block_ptr_boundary_check_nan_padding
+// CHECK: %[[BLOCK:.*]] = memref.subview
+// CHECK: %[[TENSOR:.*]] = bufferization.to_tensor %[[BLOCK]]
+// CHECK: %[[COPY:.*]] = linalg.copy ins(%[[TENSOR]] : tensor<?xf32>)
+// CHECK: %[[NAN:.*]] = arith.constant 0x7FC00000 : f32
+// CHECK-NOT: tensor.insert_slice
+// CHECK: linalg_ext.pad ins(%[[COPY]] : tensor<?xf32>) outs(%{{.*}} : tensor<8xf32>) pvalue(%[[NAN]] : f32)
+tt.func @block_ptr_boundary_check_nan_padding(%arg0: !tt.ptr<f32>, %arg1: i64, %arg2: i32) -> tensor<8xf32> {
+  %c1_i64 = arith.constant 1 : i64
+  %0 = tt.make_tensor_ptr %arg0, [%arg1], [%c1_i64], [%arg2] {order = array<i32: 0>} : <tensor<8xf32>>
+  %1 = tt.load %0 {boundaryCheck = array<i32: 0>, padding = 2 : i32} : !tt.ptr<tensor<8xf32>>
+  tt.return %1 : tensor<8xf32>
+}
+
+// -----
+// The block may run past the tensor on a dim without boundary check, so it is
+// viewed at its exact offsets instead of as a subview of the whole tensor.
+// CHECK-LABEL: func.func @block_ptr_unchecked_dim
+// CHECK: scf.for
+// CHECK: %[[VIEW:.*]] = aux.view
+// CHECK-NOT: memref.subview
+// CHECK: bufferization.to_tensor %[[VIEW]]
+tt.func @block_ptr_unchecked_dim(%arg0: !tt.ptr<f32>, %arg1: i64, %arg2: i64) -> tensor<16x16xf32> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %c0_i32 = arith.constant 0 : i32
+  %c16_i32 = arith.constant 16 : i32
+  %c1_i64 = arith.constant 1 : i64
+  %cst = arith.constant dense<0.000000e+00> : tensor<16x16xf32>
+  %0:2 = scf.for %arg3 = %c0 to %c4 step %c1 iter_args(%arg4 = %c0_i32, %arg5 = %cst) -> (i32, tensor<16x16xf32>) {
+    %1 = tt.make_tensor_ptr %arg0, [%arg1, %arg2], [%arg2, %c1_i64], [%c0_i32, %arg4] {order = array<i32: 1, 0>} : <tensor<16x16xf32>>
+    %2 = tt.load %1 {boundaryCheck = array<i32: 1>, padding = 1 : i32} : !tt.ptr<tensor<16x16xf32>>
+    %3 = arith.addf %arg5, %2 : tensor<16x16xf32>
+    %4 = arith.addi %arg4, %c16_i32 : i32
+    scf.yield %4, %3 : i32, tensor<16x16xf32>
+  }
+  tt.return %0#1 : tensor<16x16xf32>
+}
+
+// -----
+// A block starting before the tensor on a boundary-checked dim reads the
+// in-bounds elements from the start of the tensor, and pads the elements
+// before it.
+// CHECK-LABEL: func.func @block_ptr_negative_offset
+// CHECK: %[[VIEW:.*]] = aux.view
+// CHECK: %[[BLOCK:.*]] = memref.subview %[[VIEW]][0] [%[[SIZE:.*]]] [1]
+// CHECK: %[[TENSOR:.*]] = bufferization.to_tensor %[[BLOCK]]
+// CHECK: %[[COPY:.*]] = linalg.copy ins(%[[TENSOR]] : tensor<?xf32>)
+// CHECK: %[[LOW:.*]] = arith.constant 4 : index
+// CHECK: linalg_ext.pad ins(%[[COPY]] : tensor<?xf32>) outs(%{{.*}} : tensor<8xf32>) pvalue(%{{.*}} : f32) low = [%[[LOW]]]
+tt.func @block_ptr_negative_offset(%arg0: !tt.ptr<f32>, %arg1: i64) -> tensor<8xf32> {
+  %c1_i64 = arith.constant 1 : i64
+  %c-4_i32 = arith.constant -4 : i32
+  %0 = tt.make_tensor_ptr %arg0, [%arg1], [%c1_i64], [%c-4_i32] {order = array<i32: 0>} : <tensor<8xf32>>
+  %1 = tt.load %0 {boundaryCheck = array<i32: 0>, padding = 1 : i32} : !tt.ptr<tensor<8xf32>>
+  tt.return %1 : tensor<8xf32>
+}
+
+// -----
+// A negative offset on a dim without boundary check is a valid address below
+// the base pointer, which the exact view reads.
+// CHECK-LABEL: func.func @block_ptr_unchecked_negative_offset
+// CHECK: %[[VIEW:.*]] = aux.view
+// CHECK-SAME: sizes: [8]
+// CHECK-NOT: memref.subview
+// CHECK: bufferization.to_tensor %[[VIEW]]
+// CHECK-NOT: linalg_ext.pad
+tt.func @block_ptr_unchecked_negative_offset(%arg0: !tt.ptr<f32>, %arg1: i64) -> tensor<8xf32> {
+  %c1_i64 = arith.constant 1 : i64
+  %c-4_i32 = arith.constant -4 : i32
+  %0 = tt.make_tensor_ptr %arg0, [%arg1], [%c1_i64], [%c-4_i32] {order = array<i32: 0>} : <tensor<8xf32>>
+  %1 = tt.load %0 : !tt.ptr<tensor<8xf32>>
+  tt.return %1 : tensor<8xf32>
+}
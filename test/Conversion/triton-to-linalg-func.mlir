@@ -0,0 +1,63 @@
+// RUN: triton-linalg-opt %s -split-input-file -pass-pipeline="builtin.module(convert-triton-func-to-func,func.func(convert-triton-to-linalg-func))" | FileCheck %s
+
+// CHECK-LABEL: func.func @func(%arg0: i64) {
+// CHECK-NOT: unrealized_conversion_cast
+tt.func @func(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}) {
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: func.func @optimize_barrier
+// CHECK-SAME: %[[ARG:.*]]: i64
+tt.func @optimize_barrier(%arg0: !tt.ptr<f32>) {
+  // CHECK-NOT: unrealized_conversion_cast
+  // CHECK: aux.optimization_barrier %[[ARG]] : i64
+  aux.optimization_barrier %arg0 : !tt.ptr<f32>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: func.func @callee
+// CHECK-SAME: %[[ARG:.*]]: tensor<2x16xi64>) -> tensor<2x16xi64>
+tt.func @callee(%arg0: tensor<2x16x!tt.ptr<f32>>) -> tensor<2x16x!tt.ptr<f32>> {
+  // CHECK: return %[[ARG]] : tensor<2x16xi64>
+  tt.return %arg0 : tensor<2x16x!tt.ptr<f32>>
+}
+
+// CHECK-LABEL: func.func @caller
+// CHECK-SAME: %[[ARG:.*]]: tensor<2x16xi64>
+tt.func @caller(%arg0: tensor<2x16x!tt.ptr<f32>>) {
+  // CHECK-NOT: unrealized_conversion_cast
+  // CHECK: call @callee(%[[ARG]]) : (tensor<2x16xi64>) -> tensor<2x16xi64>
+  %0 = tt.call @callee(%arg0) : (tensor<2x16x!tt.ptr<f32>>) -> tensor<2x16x!tt.ptr<f32>>
+  tt.return
+}
+
+// -----
+// The axis info hints on the arguments are kept for the function level
+// conversion, the offsets hinted contiguous giving a contiguous load.
+// CHECK-LABEL: func.func @load_hinted_offsets
+// CHECK-SAME: (%{{.*}}: i64, %{{.*}}: tensor<128xi32>) -> tensor<128xf32>
+// CHECK: %[[VIEW:.*]] = aux.view
+// CHECK-SAME: sizes: [128], strides: [1]
+// CHECK: %[[TENSOR:.*]] = bufferization.to_tensor %[[VIEW]]
+// CHECK: linalg.copy ins(%[[TENSOR]] : tensor<128xf32>)
+// CHECK-NOT: linalg_ext.gather
+tt.func @load_hinted_offsets(%arg0: !tt.ptr<f32> {tt.divisibility = 16 : i32}, %arg1: tensor<128xi32> {tt.contiguity = 128 : i32, tt.divisibility = 16 : i32}) -> tensor<128xf32> {
+  %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %1 = tt.addptr %0, %arg1 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %2 = tt.load %1 : tensor<128x!tt.ptr<f32>>
+  tt.return %2 : tensor<128xf32>
+}
+
+// -----
+// Without the hints the offsets are unknown, which gives a gather.
+// CHECK-LABEL: func.func @load_unhinted_offsets
+// CHECK-NOT: linalg.copy
+// CHECK: linalg_ext.gather
+tt.func @load_unhinted_offsets(%arg0: !tt.ptr<f32>, %arg1: tensor<128xi32>) -> tensor<128xf32> {
+  %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %1 = tt.addptr %0, %arg1 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %2 = tt.load %1 : tensor<128x!tt.ptr<f32>>
+  tt.return %2 : tensor<128xf32>
+}
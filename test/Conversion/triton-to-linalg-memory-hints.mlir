@@ -0,0 +1,51 @@
+// RUN: triton-linalg-opt --convert-triton-to-linalg %s -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @contiguous_load_hints
+// CHECK: aux.view {{.*}} {cache_mode = "cmtransient", is_volatile} evict_mode(evict_first)
+// CHECK: aux.view
+// CHECK-NOT: evict_mode
+// CHECK: bufferization.materialize_in_destination
+tt.func @contiguous_load_hints(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<f32>) {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %2 = tt.addptr %1, %0 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %3 = tt.load %2 {cache = 5 : i32, evict = 2 : i32, isVolatile = true} : tensor<128x!tt.ptr<f32>>
+  %4 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %5 = tt.addptr %4, %0 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  tt.store %5, %3 : tensor<128x!tt.ptr<f32>>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: func.func @gather_load_hints
+// CHECK: aux.view {{.*}} {cache_mode = "cmnormal"} evict_mode(evict_last)
+// CHECK: linalg_ext.gather {cache_mode = "cmnormal"{{.*}}} evict_mode(evict_last) dimension_map = [0]
+tt.func @gather_load_hints(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<i32>, %arg2: !tt.ptr<f32>) {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg1 : !tt.ptr<i32> -> tensor<128x!tt.ptr<i32>>
+  %2 = tt.addptr %1, %0 : tensor<128x!tt.ptr<i32>>, tensor<128xi32>
+  %3 = tt.load %2 : tensor<128x!tt.ptr<i32>>
+  %4 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %5 = tt.addptr %4, %3 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %6 = tt.load %5 {cache = 2 : i32, evict = 3 : i32, isVolatile = false} : tensor<128x!tt.ptr<f32>>
+  %7 = tt.splat %arg2 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %8 = tt.addptr %7, %0 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  tt.store %8, %6 : tensor<128x!tt.ptr<f32>>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: func.func @scatter_store_hints
+// CHECK: aux.view {{.*}} {is_volatile}
+// CHECK: aux.view {{.*}} evict_mode(evict_first)
+// CHECK: linalg_ext.scatter {{.*}}evict_mode(evict_first) dimension_map = [0]
+tt.func @scatter_store_hints(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<i32>, %arg2: tensor<128xf32>) {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg1 : !tt.ptr<i32> -> tensor<128x!tt.ptr<i32>>
+  %2 = tt.addptr %1, %0 : tensor<128x!tt.ptr<i32>>, tensor<128xi32>
+  %3 = tt.load %2 {cache = 1 : i32, evict = 1 : i32, isVolatile = true} : tensor<128x!tt.ptr<i32>>
+  %4 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %5 = tt.addptr %4, %3 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  tt.store %5, %arg2 {cache = 1 : i32, evict = 2 : i32} : tensor<128x!tt.ptr<f32>>
+  tt.return
+}
@@ -0,0 +1,38 @@
+// RUN: triton-linalg-opt --convert-triton-to-linalg="emit-remarks" %s -verify-diagnostics -o /dev/null
+// RUN: triton-linalg-opt --convert-triton-to-linalg %s -mlir-pass-statistics -o /dev/null 2>&1 | FileCheck %s
+
+// CHECK-DAG: (S) 1 num-contiguous
+// CHECK-DAG: (S) 2 num-contiguous-missed
+// CHECK-DAG: (S) 2 num-scalar
+// CHECK-DAG: (S) 2 num-scattered
+// CHECK-DAG: (S) 2 num-tensor-pointer
+
+// expected-remark @below {{memory access lowerings: 1 contiguous, 0 scalar, 2 scattered, 0 tensor-pointer}}
+tt.func @indirect_copy(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<i32>, %arg2: !tt.ptr<f32>) {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg1 : !tt.ptr<i32> -> tensor<128x!tt.ptr<i32>>
+  %2 = tt.addptr %1, %0 : tensor<128x!tt.ptr<i32>>, tensor<128xi32>
+  %3 = tt.load %2 : tensor<128x!tt.ptr<i32>>
+  %4 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %5 = tt.addptr %4, %3 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  // expected-remark @below {{memory access misses the contiguous lowering: AxisInfo stride of the pointer is unknown on a dim}}
+  %6 = tt.load %5 : tensor<128x!tt.ptr<f32>>
+  %7 = tt.splat %arg2 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %8 = tt.addptr %7, %3 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  // expected-remark @below {{memory access misses the contiguous lowering: AxisInfo stride of the pointer is unknown on a dim}}
+  tt.store %8, %6 : tensor<128x!tt.ptr<f32>>
+  tt.return
+}
+
+// expected-remark @below {{memory access lowerings: 0 contiguous, 2 scalar, 0 scattered, 2 tensor-pointer}}
+tt.func @scalar_and_block_ptr_copy(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<f32>, %arg2: i64) {
+  %c0_i32 = arith.constant 0 : i32
+  %c1_i64 = arith.constant 1 : i64
+  %0 = tt.load %arg0 : !tt.ptr<f32>
+  tt.store %arg1, %0 : !tt.ptr<f32>
+  %1 = tt.make_tensor_ptr %arg0, [%arg2], [%c1_i64], [%c0_i32] {order = array<i32: 0>} : <tensor<8xf32>>
+  %2 = tt.load %1 {boundaryCheck = array<i32: 0>} : !tt.ptr<tensor<8xf32>>
+  %3 = tt.make_tensor_ptr %arg1, [%arg2], [%c1_i64], [%c0_i32] {order = array<i32: 0>} : <tensor<8xf32>>
+  tt.store %3, %2 {boundaryCheck = array<i32: 0>} : !tt.ptr<tensor<8xf32>>
+  tt.return
+}
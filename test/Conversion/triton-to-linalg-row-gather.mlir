@@ -0,0 +1,87 @@
+// RUN: triton-linalg-opt --convert-triton-to-linalg %s -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @row_gather_load
+// CHECK: %[[VIEW:.*]] = aux.view
+// CHECK: %[[TENSOR:.*]] = bufferization.to_tensor %[[VIEW]]
+// CHECK: %[[ROWS:.*]] = tensor.extract_slice %{{.*}}[0, 0] [16, 1] [1, 1] : tensor<16x32xi32> to tensor<16xi32>
+// CHECK: %[[INDICES:.*]] = tensor.expand_shape %[[ROWS]]
+// CHECK: linalg_ext.gather dimension_map = [0] ranged_data(false) ins(%[[TENSOR]], %[[INDICES]] : tensor<9223372036854775807xf32>, tensor<16x1xi32>) outs(%{{.*}} : tensor<16x32xf32>)
+tt.func @row_gather_load(%arg0: !tt.ptr<f32>, %arg1: tensor<16xi32>, %arg2: i32) -> tensor<16x32xf32> {
+  %0 = tt.splat %arg2 : i32 -> tensor<16xi32>
+  %1 = arith.muli %arg1, %0 : tensor<16xi32>
+  %2 = tt.expand_dims %1 {axis = 1 : i32} : tensor<16xi32> -> tensor<16x1xi32>
+  %3 = tt.broadcast %2 : tensor<16x1xi32> -> tensor<16x32xi32>
+  %4 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+  %5 = tt.expand_dims %4 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+  %6 = tt.broadcast %5 : tensor<1x32xi32> -> tensor<16x32xi32>
+  %7 = arith.addi %3, %6 : tensor<16x32xi32>
+  %8 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<16x32x!tt.ptr<f32>>
+  %9 = tt.addptr %8, %7 : tensor<16x32x!tt.ptr<f32>>, tensor<16x32xi32>
+  %10 = tt.load %9 : tensor<16x32x!tt.ptr<f32>>
+  tt.return %10 : tensor<16x32xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @row_scatter_store
+// CHECK: %[[ROWS:.*]] = tensor.extract_slice %{{.*}}[0, 0] [16, 1] [1, 1] : tensor<16x32xi32> to tensor<16xi32>
+// CHECK: %[[INDICES:.*]] = tensor.expand_shape %[[ROWS]]
+// CHECK: linalg_ext.scatter dimension_map = [0] ranged_data(false) overlap_window(true) ins(%{{.*}}, %[[INDICES]] : tensor<16x32xf32>, tensor<16x1xi32>)
+// CHECK: aux.store
+tt.func @row_scatter_store(%arg0: !tt.ptr<f32>, %arg1: tensor<16xi32>, %arg2: i32, %arg3: tensor<16x32xf32>) {
+  %0 = tt.splat %arg2 : i32 -> tensor<16xi32>
+  %1 = arith.muli %arg1, %0 : tensor<16xi32>
+  %2 = tt.expand_dims %1 {axis = 1 : i32} : tensor<16xi32> -> tensor<16x1xi32>
+  %3 = tt.broadcast %2 : tensor<16x1xi32> -> tensor<16x32xi32>
+  %4 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+  %5 = tt.expand_dims %4 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+  %6 = tt.broadcast %5 : tensor<1x32xi32> -> tensor<16x32xi32>
+  %7 = arith.addi %3, %6 : tensor<16x32xi32>
+  %8 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<16x32x!tt.ptr<f32>>
+  %9 = tt.addptr %8, %7 : tensor<16x32x!tt.ptr<f32>>, tensor<16x32xi32>
+  tt.store %9, %arg3 : tensor<16x32x!tt.ptr<f32>>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: func.func @row_gather_load_indirect
+// CHECK: linalg_ext.gather {sort_indices} dimension_map = [0] ranged_data(false)
+tt.func @row_gather_load_indirect(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<i32>, %arg2: i32) -> tensor<16x32xf32> {
+  %idx = tt.make_range {end = 16 : i32, start = 0 : i32} : tensor<16xi32>
+  %idx_ptr = tt.splat %arg1 : !tt.ptr<i32> -> tensor<16x!tt.ptr<i32>>
+  %idx_ptrs = tt.addptr %idx_ptr, %idx : tensor<16x!tt.ptr<i32>>, tensor<16xi32>
+  %ids = tt.load %idx_ptrs : tensor<16x!tt.ptr<i32>>
+  %0 = tt.splat %arg2 : i32 -> tensor<16xi32>
+  %1 = arith.muli %ids, %0 : tensor<16xi32>
+  %2 = tt.expand_dims %1 {axis = 1 : i32} : tensor<16xi32> -> tensor<16x1xi32>
+  %3 = tt.broadcast %2 : tensor<16x1xi32> -> tensor<16x32xi32>
+  %4 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+  %5 = tt.expand_dims %4 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+  %6 = tt.broadcast %5 : tensor<1x32xi32> -> tensor<16x32xi32>
+  %7 = arith.addi %3, %6 : tensor<16x32xi32>
+  %8 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<16x32x!tt.ptr<f32>>
+  %9 = tt.addptr %8, %7 : tensor<16x32x!tt.ptr<f32>>, tensor<16x32xi32>
+  %10 = tt.load %9 : tensor<16x32x!tt.ptr<f32>>
+  tt.return %10 : tensor<16x32xf32>
+}
+
+// -----
+// A scalar loaded from memory only moves the base, the rows are not sorted.
+// CHECK-LABEL: func.func @row_gather_load_scalar_loaded_base
+// CHECK-NOT: sort_indices
+// CHECK: linalg_ext.gather dimension_map = [0] ranged_data(false)
+tt.func @row_gather_load_scalar_loaded_base(%arg0: !tt.ptr<f32>, %arg1: tensor<16xi32>, %arg2: i32, %arg3: !tt.ptr<i32>) -> tensor<16x32xf32> {
+  %start = tt.load %arg3 : !tt.ptr<i32>
+  %base = tt.addptr %arg0, %start : !tt.ptr<f32>, i32
+  %0 = tt.splat %arg2 : i32 -> tensor<16xi32>
+  %1 = arith.muli %arg1, %0 : tensor<16xi32>
+  %2 = tt.expand_dims %1 {axis = 1 : i32} : tensor<16xi32> -> tensor<16x1xi32>
+  %3 = tt.broadcast %2 : tensor<16x1xi32> -> tensor<16x32xi32>
+  %4 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+  %5 = tt.expand_dims %4 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+  %6 = tt.broadcast %5 : tensor<1x32xi32> -> tensor<16x32xi32>
+  %7 = arith.addi %3, %6 : tensor<16x32xi32>
+  %8 = tt.splat %base : !tt.ptr<f32> -> tensor<16x32x!tt.ptr<f32>>
+  %9 = tt.addptr %8, %7 : tensor<16x32x!tt.ptr<f32>>, tensor<16x32xi32>
+  %10 = tt.load %9 : tensor<16x32x!tt.ptr<f32>>
+  tt.return %10 : tensor<16x32xf32>
+}
@@ -0,0 +1,66 @@
+// RUN: triton-linalg-opt --convert-triton-to-linalg %s -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @scatter_store_strided
+// CHECK: linalg_ext.scatter dimension_map = [0] ranged_data(false) overlap_window(false)
+tt.func @scatter_store_strided(%arg0: !tt.ptr<f32>, %arg1: tensor<16x32xf32>) {
+  %cst = arith.constant dense<0.000000e+00> : tensor<16x32xf32>
+  %c128_i32 = arith.constant dense<128> : tensor<16x1xi32>
+  %c2_i32 = arith.constant dense<2> : tensor<1x32xi32>
+  %0 = tt.make_range {end = 16 : i32, start = 0 : i32} : tensor<16xi32>
+  %1 = tt.expand_dims %0 {axis = 1 : i32} : tensor<16xi32> -> tensor<16x1xi32>
+  %2 = arith.muli %1, %c128_i32 : tensor<16x1xi32>
+  %3 = tt.broadcast %2 : tensor<16x1xi32> -> tensor<16x32xi32>
+  %4 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+  %5 = tt.expand_dims %4 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+  %6 = arith.muli %5, %c2_i32 : tensor<1x32xi32>
+  %7 = tt.broadcast %6 : tensor<1x32xi32> -> tensor<16x32xi32>
+  %8 = arith.addi %3, %7 : tensor<16x32xi32>
+  %9 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<16x32x!tt.ptr<f32>>
+  %10 = tt.addptr %9, %8 : tensor<16x32x!tt.ptr<f32>>, tensor<16x32xi32>
+  %11 = arith.cmpf ogt, %arg1, %cst : tensor<16x32xf32>
+  tt.store %10, %arg1, %11 : tensor<16x32x!tt.ptr<f32>>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: func.func @scatter_store_overlapped
+// CHECK: linalg_ext.scatter dimension_map = [0] ranged_data(false) overlap_window(true)
+tt.func @scatter_store_overlapped(%arg0: !tt.ptr<f32>, %arg1: tensor<16x32xf32>) {
+  %cst = arith.constant dense<0.000000e+00> : tensor<16x32xf32>
+  %c16_i32 = arith.constant dense<16> : tensor<16x1xi32>
+  %0 = tt.make_range {end = 16 : i32, start = 0 : i32} : tensor<16xi32>
+  %1 = tt.expand_dims %0 {axis = 1 : i32} : tensor<16xi32> -> tensor<16x1xi32>
+  %2 = arith.muli %1, %c16_i32 : tensor<16x1xi32>
+  %3 = tt.broadcast %2 : tensor<16x1xi32> -> tensor<16x32xi32>
+  %4 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+  %5 = tt.expand_dims %4 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+  %6 = tt.broadcast %5 : tensor<1x32xi32> -> tensor<16x32xi32>
+  %7 = arith.addi %3, %6 : tensor<16x32xi32>
+  %8 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<16x32x!tt.ptr<f32>>
+  %9 = tt.addptr %8, %7 : tensor<16x32x!tt.ptr<f32>>, tensor<16x32xi32>
+  %10 = arith.cmpf ogt, %arg1, %cst : tensor<16x32xf32>
+  tt.store %9, %arg1, %10 : tensor<16x32x!tt.ptr<f32>>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: func.func @gather_load_masked_region
+// CHECK: %[[INDICES:.*]] = tensor.extract_slice %{{.*}}[0] [%[[SIZE:.*]]] [1] : tensor<128xi32> to tensor<?xi32>
+// CHECK: %[[EXPANDED:.*]] = tensor.expand_shape %[[INDICES]]
+// CHECK: %[[WINDOW:.*]] = tensor.empty(%{{.*}}) : tensor<?x1xf32>
+// CHECK: %[[GATHER:.*]] = linalg_ext.gather {sort_indices} dimension_map = [0] ranged_data(false) ins(%{{.*}}, %[[EXPANDED]] : tensor<{{.*}}xf32>, tensor<?x1xi32>) outs(%[[WINDOW]] : tensor<?x1xf32>)
+// CHECK: %[[REGION:.*]] = tensor.collapse_shape %[[GATHER]]
+// CHECK: linalg_ext.pad ins(%[[REGION]] : tensor<?xf32>) outs(%{{.*}} : tensor<128xf32>) pvalue(%{{.*}} : f32)
+tt.func @gather_load_masked_region(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<i32>, %arg2: i32) -> tensor<128xf32> {
+  %cst = arith.constant dense<0.000000e+00> : tensor<128xf32>
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg2 : i32 -> tensor<128xi32>
+  %2 = arith.cmpi slt, %0, %1 : tensor<128xi32>
+  %3 = tt.splat %arg1 : !tt.ptr<i32> -> tensor<128x!tt.ptr<i32>>
+  %4 = tt.addptr %3, %0 : tensor<128x!tt.ptr<i32>>, tensor<128xi32>
+  %5 = tt.load %4, %2 : tensor<128x!tt.ptr<i32>>
+  %6 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %7 = tt.addptr %6, %5 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %8 = tt.load %7, %2, %cst : tensor<128x!tt.ptr<f32>>
+  tt.return %8 : tensor<128xf32>
+}
@@ -224,6 +224,94 @@ tt.func @dot_allow_tf32_false(%arg0: tensor<64x64xf16>, %arg1: tensor<64x64xf16>
   tt.return
 }
 
+// -----
+// CHECK-LABEL: @dot_i8_widened
+// CHECK-SAME:    %[[ARG0:.*]]: tensor<32x64xi8>, %[[ARG1:.*]]: tensor<64x16xi8>, %[[ARG2:.*]]: tensor<32x16xi32>
+tt.func @dot_i8_widened(%arg0: tensor<32x64xi8>, %arg1: tensor<64x16xi8>, %arg2: tensor<32x16xi32>) {
+  // CHECK: linalg.matmul ins(%[[ARG0]], %[[ARG1]] : tensor<32x64xi8>, tensor<64x16xi8>) outs(%[[ARG2]] : tensor<32x16xi32>) -> tensor<32x16xi32>
+  %0 = arith.extsi %arg0 : tensor<32x64xi8> to tensor<32x64xi32>
+  %1 = arith.extsi %arg1 : tensor<64x16xi8> to tensor<64x16xi32>
+  %2 = tt.dot %0, %1, %arg2 {inputPrecision = 2 : i32, maxNumImpreciseAcc = 0 : i32} : tensor<32x64xi32> * tensor<64x16xi32> -> tensor<32x16xi32>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: @dot_bf16_widened
+// CHECK-SAME:    %[[ARG0:.*]]: tensor<32x64xbf16>, %[[ARG1:.*]]: tensor<64x16xf32>, %[[ARG2:.*]]: tensor<32x16xf32>
+tt.func @dot_bf16_widened(%arg0: tensor<32x64xbf16>, %arg1: tensor<64x16xf32>, %arg2: tensor<32x16xf32>) {
+  // CHECK: linalg.matmul {__allow_tf32__} ins(%[[ARG0]], %[[ARG1]] : tensor<32x64xbf16>, tensor<64x16xf32>) outs(%[[ARG2]] : tensor<32x16xf32>) -> tensor<32x16xf32>
+  %0 = arith.extf %arg0 : tensor<32x64xbf16> to tensor<32x64xf32>
+  %1 = tt.dot %0, %arg1, %arg2 {inputPrecision = 0 : i32, maxNumImpreciseAcc = 0 : i32} : tensor<32x64xf32> * tensor<64x16xf32> -> tensor<32x16xf32>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: @dot_batched
+// CHECK-SAME:    %[[ARG0:.*]]: tensor<2x32x64xf16>, %[[ARG1:.*]]: tensor<2x64x16xf16>, %[[ARG2:.*]]: tensor<2x32x16xf32>
+tt.func @dot_batched(%arg0: tensor<2x32x64xf16>, %arg1: tensor<2x64x16xf16>, %arg2: tensor<2x32x16xf32>) {
+  // CHECK: linalg.batch_matmul ins(%[[ARG0]], %[[ARG1]] : tensor<2x32x64xf16>, tensor<2x64x16xf16>) outs(%[[ARG2]] : tensor<2x32x16xf32>) -> tensor<2x32x16xf32>
+  %0 = tt.dot %arg0, %arg1, %arg2 {inputPrecision = 2 : i32, maxNumImpreciseAcc = 0 : i32} : tensor<2x32x64xf16> * tensor<2x64x16xf16> -> tensor<2x32x16xf32>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: @dot_tf32x3
+// CHECK-SAME:    %[[ARG0:.*]]: tensor<32x64xf32>, %[[ARG1:.*]]: tensor<64x16xf32>, %[[ARG2:.*]]: tensor<32x16xf32>
+tt.func @dot_tf32x3(%arg0: tensor<32x64xf32>, %arg1: tensor<64x16xf32>, %arg2: tensor<32x16xf32>) {
+  // CHECK: %[[A_BIG:.*]] = linalg.map ins(%[[ARG0]] : tensor<32x64xf32>)
+  // CHECK:   arith.bitcast %{{.*}} : f32 to i32
+  // CHECK:   arith.andi %{{.*}}, %{{.*}} : i32
+  // CHECK:   arith.bitcast %{{.*}} : i32 to f32
+  // CHECK: %[[A_SMALL:.*]] = linalg.map { arith.subf } ins(%[[ARG0]], %[[A_BIG]] : tensor<32x64xf32>, tensor<32x64xf32>)
+  // CHECK: %[[B_BIG:.*]] = linalg.map ins(%[[ARG1]] : tensor<64x16xf32>)
+  // CHECK: %[[B_SMALL:.*]] = linalg.map { arith.subf } ins(%[[ARG1]], %[[B_BIG]] : tensor<64x16xf32>, tensor<64x16xf32>)
+  // CHECK: %[[ACC0:.*]] = linalg.matmul {__allow_tf32__} ins(%[[A_SMALL]], %[[B_BIG]] : tensor<32x64xf32>, tensor<64x16xf32>) outs(%[[ARG2]] : tensor<32x16xf32>)
+  // CHECK: %[[ACC1:.*]] = linalg.matmul {__allow_tf32__} ins(%[[A_BIG]], %[[B_SMALL]] : tensor<32x64xf32>, tensor<64x16xf32>) outs(%[[ACC0]] : tensor<32x16xf32>)
+  // CHECK: linalg.matmul {__allow_tf32__} ins(%[[A_BIG]], %[[B_BIG]] : tensor<32x64xf32>, tensor<64x16xf32>) outs(%[[ACC1]] : tensor<32x16xf32>)
+  %0 = tt.dot %arg0, %arg1, %arg2 {inputPrecision = 1 : i32, maxNumImpreciseAcc = 0 : i32} : tensor<32x64xf32> * tensor<64x16xf32> -> tensor<32x16xf32>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: @dot_trans_b
+// CHECK-SAME:    %[[ARG0:.*]]: tensor<32x64xf16>, %[[ARG1:.*]]: tensor<16x64xf16>, %[[ARG2:.*]]: tensor<32x16xf32>
+tt.func @dot_trans_b(%arg0: tensor<32x64xf16>, %arg1: tensor<16x64xf16>, %arg2: tensor<32x16xf32>) {
+  // CHECK: linalg.matmul_transpose_b ins(%[[ARG0]], %[[ARG1]] : tensor<32x64xf16>, tensor<16x64xf16>) outs(%[[ARG2]] : tensor<32x16xf32>) -> tensor<32x16xf32>
+  %0 = tt.trans %arg1 {order = array<i32: 1, 0>} : tensor<16x64xf16> -> tensor<64x16xf16>
+  %1 = tt.dot %arg0, %0, %arg2 {inputPrecision = 2 : i32, maxNumImpreciseAcc = 0 : i32} : tensor<32x64xf16> * tensor<64x16xf16> -> tensor<32x16xf32>
+  tt.return
+}
+
+// -----
+// CHECK-LABEL: @dot_trans_a_widened
+// CHECK-SAME:    %[[ARG0:.*]]: tensor<2x64x32xi8>, %[[ARG1:.*]]: tensor<2x64x16xi8>, %[[ARG2:.*]]: tensor<2x32x16xi32>
+tt.func @dot_trans_a_widened(%arg0: tensor<2x64x32xi8>, %arg1: tensor<2x64x16xi8>, %arg2: tensor<2x32x16xi32>) {
+  // CHECK: linalg.batch_matmul_transpose_a ins(%[[ARG0]], %[[ARG1]] : tensor<2x64x32xi8>, tensor<2x64x16xi8>) outs(%[[ARG2]] : tensor<2x32x16xi32>) -> tensor<2x32x16xi32>
+  %0 = tt.trans %arg0 {order = array<i32: 0, 2, 1>} : tensor<2x64x32xi8> -> tensor<2x32x64xi8>
+  %1 = arith.extsi %0 : tensor<2x32x64xi8> to tensor<2x32x64xi32>
+  %2 = arith.extsi %arg1 : tensor<2x64x16xi8> to tensor<2x64x16xi32>
+  %3 = tt.dot %1, %2, %arg2 {inputPrecision = 2 : i32, maxNumImpreciseAcc = 0 : i32} : tensor<2x32x64xi32> * tensor<2x64x16xi32> -> tensor<2x32x16xi32>
+  tt.return
+}
+
+// -----
+// CHECK-DAG: #[[MAP_A:.*]] = affine_map<(d0, d1, d2) -> (d2, d0)>
+// CHECK-DAG: #[[MAP_B:.*]] = affine_map<(d0, d1, d2) -> (d1, d2)>
+// CHECK-DAG: #[[MAP_C:.*]] = affine_map<(d0, d1, d2) -> (d0, d1)>
+// CHECK-LABEL: @dot_trans_both
+// CHECK-SAME:    %[[ARG0:.*]]: tensor<64x32xf16>, %[[ARG1:.*]]: tensor<16x64xf16>, %[[ARG2:.*]]: tensor<32x16xf32>
+tt.func @dot_trans_both(%arg0: tensor<64x32xf16>, %arg1: tensor<16x64xf16>, %arg2: tensor<32x16xf32>) {
+  // CHECK: linalg.generic {indexing_maps = [#[[MAP_A]], #[[MAP_B]], #[[MAP_C]]], iterator_types = ["parallel", "parallel", "reduction"]} ins(%[[ARG0]], %[[ARG1]] : tensor<64x32xf16>, tensor<16x64xf16>) outs(%[[ARG2]] : tensor<32x16xf32>)
+  // CHECK:   arith.extf
+  // CHECK:   arith.extf
+  // CHECK:   arith.mulf
+  // CHECK:   arith.addf
+  %0 = tt.trans %arg0 {order = array<i32: 1, 0>} : tensor<64x32xf16> -> tensor<32x64xf16>
+  %1 = tt.trans %arg1 {order = array<i32: 1, 0>} : tensor<16x64xf16> -> tensor<64x16xf16>
+  %2 = tt.dot %0, %1, %arg2 {inputPrecision = 2 : i32, maxNumImpreciseAcc = 0 : i32} : tensor<32x64xf16> * tensor<64x16xf16> -> tensor<32x16xf32>
+  tt.return
+}
+
 // -----
 // CHECK-LABEL: @bitcast_scalar
 tt.func @bitcast_scalar(%arg0: i32) {
@@ -261,6 +349,18 @@ tt.func @bitcast_ptr(%arg0: tensor<128x!tt.ptr<f32>>) {
   tt.return
 }
 
+// -----
+// CHECK-LABEL: @extern_elementwise
+// CHECK-SAME: %[[ARG0:.*]]: tensor<128xf32>, %[[ARG1:.*]]: f32
+tt.func @extern_elementwise(%arg0: tensor<128xf32>, %arg1: f32) {
+  // CHECK: %[[INIT:.*]] = tensor.empty() : tensor<128xf32>
+  // CHECK: linalg_ext.libdevice_call {libname = "libdevice", libpath = "", pure} ins(%[[ARG0]] : tensor<128xf32>) outs(%[[INIT]] : tensor<128xf32>) symbol = "__nv_tanhf" -> tensor<128xf32>
+  %0 = tt.extern_elementwise %arg0 {libname = "libdevice", libpath = "", pure = true, symbol = "__nv_tanhf"} : (tensor<128xf32>) -> tensor<128xf32>
+  // CHECK: tt.extern_elementwise %[[ARG1]] {libname = "libdevice", libpath = "", pure = true, symbol = "__nv_tanhf"} : (f32) -> f32
+  %1 = tt.extern_elementwise %arg1 {libname = "libdevice", libpath = "", pure = true, symbol = "__nv_tanhf"} : (f32) -> f32
+  tt.return
+}
+
 // -----
 tt.func @reduce_min_2d_f16(%arg0: tensor<1x2048xf16>) {
   // CHECK-LABEL:   func.func @reduce_min_2d_f16(
@@ -632,13 +732,13 @@ tt.func @reduce_no_payload_2d_i32(%arg0: tensor<1x2048xi32>) {
 // -----
 // CHECK-LABEL: @reduce_mix_3d_f32
 tt.func @reduce_mix_3d_f32(%arg0: tensor<1x2048x32xf32>, %arg1: tensor<1x2048x32xf32>) {
-  // CHECK: %[[ARG0_FIRST:.*]] = tensor.extract_slice %arg0[0, 0, 0] [1, 1, 32] [1, 1, 1] : tensor<1x2048x32xf32> to tensor<1x1x32xf32>
-  // CHECK-NEXT: %[[ARG0_COLLAPSE:.*]] = tensor.collapse_shape %[[ARG0_FIRST]] {{\[}}[0, 1], [2]] : tensor<1x1x32xf32> into tensor<1x32xf32>
-  // CHECK-NEXT: %[[ARG0_SLICE:.*]] = tensor.extract_slice %arg0[0, 1, 0] [1, 2047, 32] [1, 1, 1] : tensor<1x2048x32xf32> to tensor<1x2047x32xf32>
-  // CHECK-NEXT: %[[ARG1_FIRST:.*]] = tensor.extract_slice %arg1[0, 0, 0] [1, 1, 32] [1, 1, 1] : tensor<1x2048x32xf32> to tensor<1x1x32xf32>
-  // CHECK-NEXT: %[[ARG1_COLLAPSE:.*]] = tensor.collapse_shape %[[ARG1_FIRST]] {{\[}}[0, 1], [2]] : tensor<1x1x32xf32> into tensor<1x32xf32>
-  // CHECK-NEXT: %[[ARG1_SLICE:.*]] = tensor.extract_slice %arg1[0, 1, 0] [1, 2047, 32] [1, 1, 1] : tensor<1x2048x32xf32> to tensor<1x2047x32xf32>
-  // CHECK-NEXT: %[[REDUCE:.*]]:2 = linalg.reduce ins(%[[ARG0_SLICE]], %[[ARG1_SLICE]] : tensor<1x2047x32xf32>, tensor<1x2047x32xf32>) outs(%[[ARG0_COLLAPSE]], %[[ARG1_COLLAPSE]] : tensor<1x32xf32>, tensor<1x32xf32>) dimensions = [1]
+  // CHECK: %[[ZERO:.*]] = arith.constant 0.000000e+00 : f32
+  // CHECK-NEXT: %[[EMPTY0:.*]] = tensor.empty() : tensor<1x32xf32>
+  // CHECK-NEXT: %[[INIT0:.*]] = linalg.fill ins(%[[ZERO]] : f32) outs(%[[EMPTY0]] : tensor<1x32xf32>) -> tensor<1x32xf32>
+  // CHECK-NEXT: %[[NEG_INF:.*]] = arith.constant 0xFF800000 : f32
+  // CHECK-NEXT: %[[EMPTY1:.*]] = tensor.empty() : tensor<1x32xf32>
+  // CHECK-NEXT: %[[INIT1:.*]] = linalg.fill ins(%[[NEG_INF]] : f32) outs(%[[EMPTY1]] : tensor<1x32xf32>) -> tensor<1x32xf32>
+  // CHECK-NEXT: %[[REDUCE:.*]]:2 = linalg.reduce ins(%arg0, %arg1 : tensor<1x2048x32xf32>, tensor<1x2048x32xf32>) outs(%[[INIT0]], %[[INIT1]] : tensor<1x32xf32>, tensor<1x32xf32>) dimensions = [1]
   // CHECK-NEXT: (%[[IN1:.*]]: f32, %[[IN2:.*]]: f32, %[[INIT1:.*]]: f32, %[[INIT2:.*]]: f32) {
   // CHECK-NEXT: %[[ADD:.*]] = arith.addf %[[IN1]], %[[INIT1]] : f32
   // CHECK-NEXT: %[[MAX:.*]] = arith.maximumf %[[IN2]], %[[INIT2]] : f32
@@ -722,6 +822,84 @@ tt.func @reduce_multi_statement_argmax_f32(%arg0: tensor<2x2x256xf32>, %arg1: te
   tt.return
 }
 
+// -----
+// A nan element is picked, so a row of nans does not keep the identity.
+tt.func @reduce_argmax_tie_break_left_f32(%arg0: tensor<2x256xf32>, %arg1: tensor<2x256xi32>) -> (tensor<2xf32>, tensor<2xi32>) {
+  // CHECK-LABEL:   func.func @reduce_argmax_tie_break_left_f32(
+  // CHECK-SAME:                                                %[[VAL_0:.*]]: tensor<2x256xf32>,
+  // CHECK-SAME:                                                %[[VAL_1:.*]]: tensor<2x256xi32>)
+  // CHECK-NOT:       tensor.extract_slice
+  // CHECK:           %[[NEG_INF:.*]] = arith.constant 0xFF800000 : f32
+  // CHECK:           %[[INIT0:.*]] = linalg.fill ins(%[[NEG_INF]] : f32)
+  // CHECK:           %[[MAX_INT:.*]] = arith.constant 2147483647 : i32
+  // CHECK:           %[[INIT1:.*]] = linalg.fill ins(%[[MAX_INT]] : i32)
+  // CHECK:           %{{.*}}:2 = linalg.reduce ins(%[[VAL_0]], %[[VAL_1]] : tensor<2x256xf32>, tensor<2x256xi32>) outs(%[[INIT0]], %[[INIT1]] : tensor<2xf32>, tensor<2xi32>) dimensions = [1]
+  %0:2 = "tt.reduce"(%arg0, %arg1) ({
+  ^bb0(%arg2: f32, %arg3: i32, %arg4: f32, %arg5: i32):
+    %1 = arith.cmpf oeq, %arg2, %arg4 : f32
+    %2 = arith.cmpi slt, %arg3, %arg5 : i32
+    %3 = arith.andi %1, %2 : i1
+    %4 = arith.cmpf ogt, %arg2, %arg4 : f32
+    %5 = arith.cmpf une, %arg2, %arg2 : f32
+    %6 = arith.ori %4, %5 : i1
+    %7 = arith.ori %6, %3 : i1
+    %8 = arith.select %7, %arg2, %arg4 : f32
+    %9 = arith.select %7, %arg3, %arg5 : i32
+    tt.reduce.return %8, %9 : f32, i32
+  }) {axis = 1 : i32} : (tensor<2x256xf32>, tensor<2x256xi32>) -> (tensor<2xf32>, tensor<2xi32>)
+  tt.return %0#0, %0#1 : tensor<2xf32>, tensor<2xi32>
+}
+
+// -----
+// Without a nan check, a row of nans never beats -inf and would yield the
+// identity index, so the first elements are sliced as the inits.
+tt.func @reduce_argmax_tie_break_left_all_nan_f32(%arg0: tensor<2x256xf32>, %arg1: tensor<2x256xi32>) -> (tensor<2xf32>, tensor<2xi32>) {
+  // CHECK-LABEL:   func.func @reduce_argmax_tie_break_left_all_nan_f32(
+  // CHECK-SAME:                                                        %[[VAL_0:.*]]: tensor<2x256xf32>,
+  // CHECK-SAME:                                                        %[[VAL_1:.*]]: tensor<2x256xi32>)
+  // CHECK-NOT:       linalg.fill
+  // CHECK:           %[[FIRST0:.*]] = tensor.extract_slice %[[VAL_0]][0, 0] [2, 1] [1, 1]
+  // CHECK:           %[[FIRST1:.*]] = tensor.extract_slice %[[VAL_1]][0, 0] [2, 1] [1, 1]
+  // CHECK:           %{{.*}}:2 = linalg.reduce
+  %0:2 = "tt.reduce"(%arg0, %arg1) ({
+  ^bb0(%arg2: f32, %arg3: i32, %arg4: f32, %arg5: i32):
+    %1 = arith.cmpf oeq, %arg2, %arg4 : f32
+    %2 = arith.cmpi slt, %arg3, %arg5 : i32
+    %3 = arith.andi %1, %2 : i1
+    %4 = arith.cmpf ogt, %arg2, %arg4 : f32
+    %5 = arith.ori %4, %3 : i1
+    %6 = arith.select %5, %arg2, %arg4 : f32
+    %7 = arith.select %5, %arg3, %arg5 : i32
+    tt.reduce.return %6, %7 : f32, i32
+  }) {axis = 1 : i32} : (tensor<2x256xf32>, tensor<2x256xi32>) -> (tensor<2xf32>, tensor<2xi32>)
+  tt.return %0#0, %0#1 : tensor<2xf32>, tensor<2xi32>
+}
+
+// -----
+tt.func @reduce_argmin_tie_break_left_i32(%arg0: tensor<256xi32>, %arg1: tensor<256xi32>) -> (i32, i32) {
+  // CHECK-LABEL:   func.func @reduce_argmin_tie_break_left_i32(
+  // CHECK-NOT:       tensor.extract_slice
+  // CHECK:           %[[MAX_INT:.*]] = arith.constant 2147483647 : i32
+  // CHECK:           linalg.fill ins(%[[MAX_INT]] : i32)
+  // CHECK:           %[[MAX_INT2:.*]] = arith.constant 2147483647 : i32
+  // CHECK:           linalg.fill ins(%[[MAX_INT2]] : i32)
+  // CHECK:           %[[REDUCE:.*]]:2 = linalg.reduce
+  // CHECK:           tensor.extract %[[REDUCE]]#0[] : tensor<i32>
+  // CHECK:           tensor.extract %[[REDUCE]]#1[] : tensor<i32>
+  %0:2 = "tt.reduce"(%arg0, %arg1) ({
+  ^bb0(%arg2: i32, %arg3: i32, %arg4: i32, %arg5: i32):
+    %1 = arith.cmpi eq, %arg2, %arg4 : i32
+    %2 = arith.cmpi slt, %arg3, %arg5 : i32
+    %3 = arith.andi %1, %2 : i1
+    %4 = arith.cmpi slt, %arg2, %arg4 : i32
+    %5 = arith.ori %4, %3 : i1
+    %6 = arith.select %5, %arg2, %arg4 : i32
+    %7 = arith.select %5, %arg3, %arg5 : i32
+    tt.reduce.return %6, %7 : i32, i32
+  }) {axis = 0 : i32} : (tensor<256xi32>, tensor<256xi32>) -> (i32, i32)
+  tt.return %0#0, %0#1 : i32, i32
+}
+
 // -----
 // CHECK-LABEL: @for_iter_args
 // CHECK-SAME: %[[ARG0:.*]]: i64, %[[ARG1:.*]]: tensor<128x64xi32>
@@ -877,7 +1055,79 @@ func.func @cmp2fill_ub(%arg: i32) -> tensor<128xi1> {
   return %2 : tensor<128xi1>
 }
 
+// -----
+// CHECK-LABEL: func.func @cmp2fill_minsi
+// CHECK: %[[INIT:.*]] = tensor.empty(%{{.*}}) : tensor<?xi1>
+// CHECK: %[[TRUE:.*]] = linalg.fill ins(%{{.*}} : i1) outs(%[[INIT]] : tensor<?xi1>)
+// CHECK: linalg_ext.pad ins(%[[TRUE]] : tensor<?xi1>) outs(%{{.*}} : tensor<128xi1>)
+// CHECK-NOT: arith.cmpi
+func.func @cmp2fill_minsi(%arg0: i32, %arg1: i32) -> tensor<128xi1> {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg0 : i32 -> tensor<128xi32>
+  %2 = arith.minsi %0, %1 : tensor<128xi32>
+  %3 = tt.splat %arg1 : i32 -> tensor<128xi32>
+  %4 = arith.cmpi slt, %2, %3 : tensor<128xi32>
+  return %4 : tensor<128xi1>
+}
 
+// -----
+// CHECK-LABEL: func.func @cmp2fill_remsi
+// CHECK: %[[INIT:.*]] = tensor.empty(%{{.*}}) : tensor<?xi1>
+// CHECK: %[[TRUE:.*]] = linalg.fill ins(%{{.*}} : i1) outs(%[[INIT]] : tensor<?xi1>)
+// CHECK: linalg_ext.pad ins(%[[TRUE]] : tensor<?xi1>) outs(%{{.*}} : tensor<64xi1>)
+// CHECK-NOT: arith.cmpi
+func.func @cmp2fill_remsi(%arg0: i32) -> tensor<64xi1> {
+  %cst = arith.constant dense<128> : tensor<64xi32>
+  %0 = tt.make_range {end = 192 : i32, start = 128 : i32} : tensor<64xi32>
+  %1 = arith.remsi %0, %cst : tensor<64xi32>
+  %2 = tt.splat %arg0 : i32 -> tensor<64xi32>
+  %3 = arith.cmpi slt, %1, %2 : tensor<64xi32>
+  return %3 : tensor<64xi1>
+}
+
+// -----
+// CHECK-LABEL: @select_ori_conversion
+// CHECK-SAME:    (%[[ARG0:.*]]: tensor<16x32xf32>, %[[ARG1:.*]]: tensor<16x32xf32>
+// CHECK: %[[EXTRACTSLICE:.*]] = tensor.extract_slice %[[ARG0]][0, 0] [%[[SIZE0:.*]], %[[SIZE1:.*]]] [1, 1] : tensor<16x32xf32> to tensor<?x?xf32>
+// CHECK-NEXT: tensor.insert_slice %[[EXTRACTSLICE]] into %[[ARG1]][0, 0] [%[[SIZE0]], %[[SIZE1]]] [1, 1] : tensor<?x?xf32> into tensor<16x32xf32>
+// CHECK-NOT: arith.ori
+func.func @select_ori_conversion(%arg0: tensor<16x32xf32>, %arg1: tensor<16x32xf32>, %arg2: i32, %arg3: i32, %arg4: i32) -> tensor<16x32xf32> {
+  %0 = tt.make_range {end = 16 : i32, start = 0 : i32} : tensor<16xi32>
+  %1 = tt.expand_dims %0 {axis = 1 : i32} : tensor<16xi32> -> tensor<16x1xi32>
+  %2 = tt.broadcast %1 : tensor<16x1xi32> -> tensor<16x32xi32>
+  %3 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+  %4 = tt.expand_dims %3 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+  %5 = tt.broadcast %4 : tensor<1x32xi32> -> tensor<16x32xi32>
+  %6 = tt.splat %arg2 : i32 -> tensor<16x32xi32>
+  %7 = tt.splat %arg3 : i32 -> tensor<16x32xi32>
+  %8 = tt.splat %arg4 : i32 -> tensor<16x32xi32>
+  %9 = arith.cmpi slt, %2, %6 : tensor<16x32xi32>
+  %10 = arith.cmpi slt, %5, %7 : tensor<16x32xi32>
+  %11 = arith.andi %9, %10 : tensor<16x32xi1>
+  %12 = arith.cmpi slt, %5, %8 : tensor<16x32xi32>
+  %13 = arith.andi %9, %12 : tensor<16x32xi1>
+  %14 = arith.ori %11, %13 : tensor<16x32xi1>
+  %15 = arith.select %14, %arg0, %arg1 : tensor<16x32xi1>, tensor<16x32xf32>
+  return %15 : tensor<16x32xf32>
+}
+
+// -----
+// CHECK-LABEL: @select_uniform_cond_conversion
+// CHECK-SAME:    (%[[ARG0:.*]]: tensor<128xf32>, %[[ARG1:.*]]: tensor<128xf32>, %[[ARG2:.*]]: i32, %[[ARG3:.*]]: i32, %[[COND:.*]]: i1)
+// CHECK: %[[SIZE:.*]] = arith.select %[[COND]]
+// CHECK: %[[EXTRACTSLICE:.*]] = tensor.extract_slice %[[ARG0]]
+// CHECK-NEXT: tensor.insert_slice %[[EXTRACTSLICE]] into %[[ARG1]]
+// CHECK-NOT: linalg.map { arith.select }
+func.func @select_uniform_cond_conversion(%arg0: tensor<128xf32>, %arg1: tensor<128xf32>, %arg2: i32, %arg3: i32, %cond: i1) -> tensor<128xf32> {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg2 : i32 -> tensor<128xi32>
+  %2 = tt.splat %arg3 : i32 -> tensor<128xi32>
+  %3 = arith.cmpi slt, %0, %1 : tensor<128xi32>
+  %4 = arith.cmpi slt, %0, %2 : tensor<128xi32>
+  %5 = arith.select %cond, %3, %4 : tensor<128xi1>
+  %6 = arith.select %5, %arg0, %arg1 : tensor<128xi1>, tensor<128xf32>
+  return %6 : tensor<128xf32>
+}
 
 // -----
 // CHECK-LABEL: @select_conversion
@@ -1389,6 +1639,24 @@ tt.func @scan_add_2d_i32(%arg0: tensor<1x2048xi32>) -> tensor<1x2048xi32> {
   tt.return  %0 : tensor<1x2048xi32>
 }
 
+// -----
+// CHECK-LABEL: @scan_add_2d_i32_reverse(
+// CHECK-SAME:                           %[[INPUT:.*]]: tensor<1x2048xi32>) -> tensor<1x2048xi32> {
+tt.func @scan_add_2d_i32_reverse(%arg0: tensor<1x2048xi32>) -> tensor<1x2048xi32> {
+  // CHECK: %[[SCAN_INPUT:.*]] = tensor.extract_slice %[[INPUT]][0, 0] [1, 2047] [1, 1] : tensor<1x2048xi32> to tensor<1x2047xi32>
+  // CHECK: %[[INIT:.*]] = tensor.extract_slice %[[INPUT]][0, 2047] [1, 1] [1, 1] : tensor<1x2048xi32> to tensor<1x1xi32>
+  // CHECK: %[[SCAN:.*]]:2 = linalg_ext.scan {reverse} ins(%[[SCAN_INPUT]] : tensor<1x2047xi32>)
+  // CHECK: %[[INERT_SLICE:.*]] = tensor.insert_slice %[[SCAN]]#0 into %[[INPUT]][0, 0] [1, 2047] [1, 1] : tensor<1x2047xi32> into tensor<1x2048xi32>
+  // CHECK-NEXT: return %[[INERT_SLICE]] : tensor<1x2048xi32>
+
+  %0 = "tt.scan" (%arg0) ({
+  ^bb0(%arg1: i32, %arg2: i32):
+    %1 = arith.addi %arg1, %arg2 : i32
+    tt.scan.return %1 : i32
+  }) {axis = 1 : i32, reverse = true} : (tensor<1x2048xi32>) -> tensor<1x2048xi32>
+  tt.return  %0 : tensor<1x2048xi32>
+}
+
 // -----
 // CHECK-LABEL: @scan_min_2d_f16(
 // CHECK-SAME:                   %[[INPUT:.*]]: tensor<1x2048xf16>) -> tensor<1x2048xf16> {
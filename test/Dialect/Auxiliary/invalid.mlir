@@ -87,6 +87,17 @@ func.func @view_invalid_cache_mode(%in: !llvm.ptr) {
   return
 }
 
+// -----
+
+func.func @view_invalid_evict_mode(%in: !llvm.ptr) {
+  %out = aux.view %in to
+           offset: [0], sizes: [9, 42], strides: [42, 1]
+           // expected-error @+1 {{invalid evict_mode attribute specification: "evict_never"}}
+           evict_mode("evict_never")
+         : !llvm.ptr to memref<9x42xf32>
+  return
+}
+
 // -----
 func.func @print_wrong_num(%arg0: tensor<128xi8>, %arg1: tensor<64xi8>) -> tensor<128xi8> {
   // expected-error @+1 {{'aux.print' op only accepts 1 input operand atmost!}}
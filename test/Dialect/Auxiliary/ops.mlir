@@ -41,6 +41,17 @@ func.func @view_with_cache_mode(%in:  !llvm.ptr, %offset: index)
   return %out : memref<10x?xf32, strided<[?, 1], offset: ?>>
 }
 
+// -----
+// CHECK-LABEL: func @view_with_memory_hints
+// CHECK: aux.view {{.*}} {cache_mode = "cmtransient", is_volatile} evict_mode(evict_first)
+func.func @view_with_memory_hints(%in:  !llvm.ptr, %offset: index)
+    -> memref<10x?xf32, strided<[?, 1], offset: ?>> {
+  %out = aux.view %in to
+           offset: [%offset], sizes: [10, 10], strides: [1, 1] {cache_mode = "cmtransient", is_volatile} evict_mode(evict_first)
+           :  !llvm.ptr to memref<10x?xf32, strided<[?, 1], offset: ?>>
+  return %out : memref<10x?xf32, strided<[?, 1], offset: ?>>
+}
+
 // -----
 func.func @optimization_barrier(%arg0: tensor<2x2xf32>, %arg1: memref<2x2xf32>, %arg2: index, %arg3: !llvm.ptr) {
   // CHECK: aux.optimization_barrier %arg0
@@ -0,0 +1,57 @@
+// RUN: triton-linalg-opt %s -linalg-ext-combine-atomic-rmw -split-input-file | FileCheck %s
+// RUN: triton-linalg-opt %s -linalg-ext-combine-atomic-rmw="max-batch-size=8" -split-input-file | FileCheck %s --check-prefix=LIMIT
+
+// CHECK-LABEL: func.func @atomic_addf_combine_indices
+// CHECK-SAME: %[[VALUE:.*]]: tensor<16x1xf32>, %[[INDICES:.*]]: tensor<16x1xi32>, %[[MASK:.*]]: tensor<16xi8>, %[[SRC:.*]]: tensor<1024xf32>, %[[WINDOW:.*]]: tensor<16x1xf32>
+// CHECK: %[[FLAT:.*]] = tensor.collapse_shape %[[INDICES]] {{\[}}[0, 1]] : tensor<16x1xi32> into tensor<16xi32>
+// CHECK: %[[FIRST:.*]] = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel", "reduction"]
+// CHECK-SAME: ins(%[[FLAT]], %[[FLAT]], %[[MASK]], %[[MASK]] : tensor<16xi32>, tensor<16xi32>, tensor<16xi8>, tensor<16xi8>)
+// CHECK: arith.minsi
+// CHECK: %[[COMBINED:.*]]:2 = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel", "reduction", "parallel"]
+// CHECK-SAME: ins(%[[FLAT]], %[[FLAT]], %[[MASK]], %[[MASK]], %[[VALUE]] : tensor<16xi32>, tensor<16xi32>, tensor<16xi8>, tensor<16xi8>, tensor<16x1xf32>)
+// CHECK: arith.addf
+// CHECK: arith.addf
+// CHECK: %[[NEW_MASK:.*]] = linalg.generic
+// CHECK-SAME: ins(%[[MASK]], %[[FIRST]] : tensor<16xi8>, tensor<16xindex>)
+// CHECK: %[[ATOMIC:.*]]:2 = linalg_ext.gather_atomic_rmw addf ins(%[[COMBINED]]#1, %[[INDICES]], %[[NEW_MASK]] : tensor<16x1xf32>, tensor<16x1xi32>, tensor<16xi8>) outs(%[[SRC]], %{{.*}} : tensor<1024xf32>, tensor<16x1xf32>)
+// CHECK: %[[RES:.*]] = linalg.generic
+// CHECK-SAME: ins(%[[WINDOW]], %[[COMBINED]]#0 : tensor<16x1xf32>, tensor<16x1xf32>)
+// CHECK: tensor.extract %[[FIRST]]
+// CHECK: tensor.extract %[[ATOMIC]]#1
+// CHECK: arith.addf
+// CHECK: return %[[ATOMIC]]#0, %[[RES]]
+
+// LIMIT-LABEL: func.func @atomic_addf_combine_indices
+// LIMIT-NOT: linalg.generic
+// LIMIT: linalg_ext.gather_atomic_rmw addf {combine_indices}
+func.func @atomic_addf_combine_indices(%value: tensor<16x1xf32>, %indices: tensor<16x1xi32>, %mask: tensor<16xi8>, %src: tensor<1024xf32>, %window: tensor<16x1xf32>) -> (tensor<1024xf32>, tensor<16x1xf32>) {
+  %0:2 = linalg_ext.gather_atomic_rmw addf {combine_indices}
+           ins(%value, %indices, %mask : tensor<16x1xf32>, tensor<16x1xi32>, tensor<16xi8>)
+           outs(%src, %window : tensor<1024xf32>, tensor<16x1xf32>) -> tensor<1024xf32>, tensor<16x1xf32>
+  return %0#0, %0#1 : tensor<1024xf32>, tensor<16x1xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @atomic_maxs_combine_indices_without_mask
+// CHECK: arith.constant dense<1> : tensor<16xi8>
+// CHECK: arith.maxsi
+// CHECK: linalg_ext.gather_atomic_rmw maxs
+func.func @atomic_maxs_combine_indices_without_mask(%value: tensor<16x1xi32>, %indices: tensor<16x1xi32>, %src: tensor<1024xi32>, %window: tensor<16x1xi32>) -> (tensor<1024xi32>, tensor<16x1xi32>) {
+  %0:2 = linalg_ext.gather_atomic_rmw maxs {combine_indices}
+           ins(%value, %indices : tensor<16x1xi32>, tensor<16x1xi32>)
+           outs(%src, %window : tensor<1024xi32>, tensor<16x1xi32>) -> tensor<1024xi32>, tensor<16x1xi32>
+  return %0#0, %0#1 : tensor<1024xi32>, tensor<16x1xi32>
+}
+
+// -----
+// CHECK-LABEL: func.func @atomic_xchg_combine_indices
+// CHECK-NOT: linalg.generic
+// CHECK: linalg_ext.gather_atomic_rmw xchg {combine_indices}
+func.func @atomic_xchg_combine_indices(%value: tensor<16x1xf32>, %indices: tensor<16x1xi32>, %src: tensor<1024xf32>, %window: tensor<16x1xf32>) -> (tensor<1024xf32>, tensor<16x1xf32>) {
+  %0:2 = linalg_ext.gather_atomic_rmw xchg {combine_indices}
+           ins(%value, %indices : tensor<16x1xf32>, tensor<16x1xi32>)
+           outs(%src, %window : tensor<1024xf32>, tensor<16x1xf32>) -> tensor<1024xf32>, tensor<16x1xf32>
+  return %0#0, %0#1 : tensor<1024xf32>, tensor<16x1xf32>
+}
@@ -0,0 +1,67 @@
+// RUN: triton-linalg-opt %s -linalg-ext-conv-to-im2col-matmul="tile-rows=2" -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @conv
+// CHECK-SAME: %[[INPUT:.*]]: tensor<2x1x6x6x4xf32>, %[[FILTER:.*]]: tensor<2x8x3x3x4xf32>, %[[INIT:.*]]: tensor<2x1x4x4x8xf32>
+// CHECK-DAG: %[[C0:.*]] = arith.constant 0 : index
+// CHECK-DAG: %[[C2:.*]] = arith.constant 2 : index
+// CHECK-DAG: %[[C4:.*]] = arith.constant 4 : index
+// CHECK: %[[FILTER_MAT:.*]] = tensor.collapse_shape %[[FILTER]] {{\[}}[0], [1], [2, 3, 4]] : tensor<2x8x3x3x4xf32> into tensor<2x8x36xf32>
+// CHECK: %[[RES:.*]] = scf.for %[[OH:.*]] = %[[C0]] to %[[C4]] step %[[C2]] iter_args(%[[ACC:.*]] = %[[INIT]]) -> (tensor<2x1x4x4x8xf32>)
+// CHECK: %[[ROWS:.*]] = tensor.extract_slice %[[INPUT]][0, 0, %[[OH]], 0, 0] [2, 1, 4, 6, 4] [1, 1, 1, 1, 1] : tensor<2x1x6x6x4xf32> to tensor<2x1x4x6x4xf32>
+// CHECK: %[[ROWS_4D:.*]] = tensor.collapse_shape %[[ROWS]] {{\[}}[0, 1], [2], [3], [4]] : tensor<2x1x4x6x4xf32> into tensor<2x4x6x4xf32>
+// CHECK: %[[EMPTY:.*]] = tensor.empty() : tensor<2x2x4x3x3x4xf32>
+// CHECK: %[[PATCHES:.*]] = linalg_ext.im2col {strides = dense<1> : tensor<2xi64>} ins(%[[ROWS_4D]] : tensor<2x4x6x4xf32>) outs(%[[EMPTY]] : tensor<2x2x4x3x3x4xf32>)
+// CHECK: %[[EXPANDED:.*]] = tensor.expand_shape %[[PATCHES]] {{\[}}[0, 1], [2], [3], [4], [5], [6]]
+// CHECK: %[[PATCHES_MAT:.*]] = tensor.collapse_shape %[[EXPANDED]] {{\[}}[0], [1, 2, 3], [4, 5, 6]] : tensor<2x1x2x4x3x3x4xf32> into tensor<2x8x36xf32>
+// CHECK: %[[TILE:.*]] = tensor.extract_slice %[[ACC]][0, 0, %[[OH]], 0, 0] [2, 1, 2, 4, 8] [1, 1, 1, 1, 1] : tensor<2x1x4x4x8xf32> to tensor<2x1x2x4x8xf32>
+// CHECK: %[[TILE_MAT:.*]] = tensor.collapse_shape %[[TILE]] {{\[}}[0], [1, 2, 3], [4]] : tensor<2x1x2x4x8xf32> into tensor<2x8x8xf32>
+// CHECK: %[[MM:.*]] = linalg.batch_matmul_transpose_b ins(%[[PATCHES_MAT]], %[[FILTER_MAT]] : tensor<2x8x36xf32>, tensor<2x8x36xf32>) outs(%[[TILE_MAT]] : tensor<2x8x8xf32>)
+// CHECK: %[[MM_TILE:.*]] = tensor.expand_shape %[[MM]] {{\[}}[0], [1, 2, 3], [4]]
+// CHECK: %[[UPDATED:.*]] = tensor.insert_slice %[[MM_TILE]] into %[[ACC]][0, 0, %[[OH]], 0, 0] [2, 1, 2, 4, 8] [1, 1, 1, 1, 1] : tensor<2x1x2x4x8xf32> into tensor<2x1x4x4x8xf32>
+// CHECK: scf.yield %[[UPDATED]]
+// CHECK: return %[[RES]]
+func.func @conv(%input: tensor<2x1x6x6x4xf32>, %filter: tensor<2x8x3x3x4xf32>, %init: tensor<2x1x4x4x8xf32>) -> tensor<2x1x4x4x8xf32> {
+  %0 = linalg_ext.batch_conv_2d_nhwc_fhwc
+      ins(%input, %filter : tensor<2x1x6x6x4xf32>, tensor<2x8x3x3x4xf32>)
+      outs(%init : tensor<2x1x4x4x8xf32>) -> tensor<2x1x4x4x8xf32>
+  return %0 : tensor<2x1x4x4x8xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @conv_strided
+// CHECK-SAME: %[[INPUT:.*]]: tensor<1x2x9x9x4xf16>
+// CHECK-DAG: %[[C2:.*]] = arith.constant 2 : index
+// CHECK-DAG: %[[C3:.*]] = arith.constant 3 : index
+// CHECK: scf.for %[[OH:.*]] = %{{.*}} to %[[C3]] step %{{.*}}
+// CHECK: %[[ROW:.*]] = arith.muli %[[OH]], %[[C2]] : index
+// CHECK: tensor.extract_slice %[[INPUT]][0, 0, %[[ROW]], 0, 0] [1, 2, 3, 9, 4] [1, 1, 1, 1, 1] : tensor<1x2x9x9x4xf16> to tensor<1x2x3x9x4xf16>
+// CHECK: linalg_ext.im2col {strides = dense<2> : tensor<2xi64>} ins(%{{.*}} : tensor<2x3x9x4xf16>) outs(%{{.*}} : tensor<2x1x4x3x3x4xf16>)
+// CHECK: linalg.batch_matmul_transpose_b ins(%{{.*}}, %{{.*}} : tensor<1x8x36xf16>, tensor<1x16x36xf16>) outs(%{{.*}} : tensor<1x8x16xf32>)
+func.func @conv_strided(%input: tensor<1x2x9x9x4xf16>, %filter: tensor<1x16x3x3x4xf16>, %init: tensor<1x2x3x4x16xf32>) -> tensor<1x2x3x4x16xf32> {
+  %0 = linalg_ext.batch_conv_2d_nhwc_fhwc {dilations = dense<1> : tensor<2xi64>, strides = dense<2> : tensor<2xi64>}
+      ins(%input, %filter : tensor<1x2x9x9x4xf16>, tensor<1x16x3x3x4xf16>)
+      outs(%init : tensor<1x2x3x4x16xf32>) -> tensor<1x2x3x4x16xf32>
+  return %0 : tensor<1x2x3x4x16xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @conv_dilated
+// CHECK: linalg_ext.batch_conv_2d_nhwc_fhwc
+// CHECK-NOT: linalg_ext.im2col
+func.func @conv_dilated(%input: tensor<1x1x8x8x4xf32>, %filter: tensor<1x8x3x3x4xf32>, %init: tensor<1x1x4x4x8xf32>) -> tensor<1x1x4x4x8xf32> {
+  %0 = linalg_ext.batch_conv_2d_nhwc_fhwc {dilations = dense<2> : tensor<2xi64>, strides = dense<1> : tensor<2xi64>}
+      ins(%input, %filter : tensor<1x1x8x8x4xf32>, tensor<1x8x3x3x4xf32>)
+      outs(%init : tensor<1x1x4x4x8xf32>) -> tensor<1x1x4x4x8xf32>
+  return %0 : tensor<1x1x4x4x8xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @conv_dynamic
+// CHECK: linalg_ext.batch_conv_2d_nhwc_fhwc
+// CHECK-NOT: linalg_ext.im2col
+func.func @conv_dynamic(%input: tensor<?x?x?x?x?xf32>, %filter: tensor<?x?x?x?x?xf32>, %init: tensor<?x?x?x?x?xf32>) -> tensor<?x?x?x?x?xf32> {
+  %0 = linalg_ext.batch_conv_2d_nhwc_fhwc
+      ins(%input, %filter : tensor<?x?x?x?x?xf32>, tensor<?x?x?x?x?xf32>)
+      outs(%init : tensor<?x?x?x?x?xf32>) -> tensor<?x?x?x?x?xf32>
+  return %0 : tensor<?x?x?x?x?xf32>
+}
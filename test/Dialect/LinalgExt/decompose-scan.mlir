@@ -0,0 +1,79 @@
+// RUN: triton-linalg-opt %s -linalg-ext-decompose-scan="tile-size=4" -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @scan_1d
+// CHECK-SAME: %[[INPUT:.*]]: tensor<16xf32>, %[[OUTPUT:.*]]: tensor<16xf32>, %[[INIT:.*]]: tensor<f32>
+// CHECK: %[[TILED:.*]] = tensor.expand_shape %[[INPUT]] {{\[}}[0, 1]] {{.*}}: tensor<16xf32> into tensor<4x4xf32>
+// CHECK: %[[HEAD:.*]] = tensor.extract_slice %[[TILED]][0, 0] [4, 1] [1, 1] : tensor<4x4xf32> to tensor<4xf32>
+// CHECK: %[[REST:.*]] = tensor.extract_slice %[[TILED]][0, 1] [4, 3] [1, 1] : tensor<4x4xf32> to tensor<4x3xf32>
+// CHECK: %[[LOCAL:.*]]:2 = linalg_ext.scan ins(%[[REST]] : tensor<4x3xf32>) outs(%{{.*}}, %[[HEAD]] : tensor<4x3xf32>, tensor<4xf32>) dimensions = [1]
+// CHECK: %[[CARRY:.*]]:2 = linalg_ext.scan ins(%[[LOCAL]]#1 : tensor<4xf32>) outs(%{{.*}}, %[[INIT]] : tensor<4xf32>, tensor<f32>) dimensions = [0]
+// CHECK: tensor.insert_slice %[[HEAD]] into %{{.*}}[0, 0] [4, 1] [1, 1] : tensor<4xf32> into tensor<4x4xf32>
+// CHECK: tensor.insert_slice %[[LOCAL]]#0 into %{{.*}}[0, 1] [4, 3] [1, 1] : tensor<4x3xf32> into tensor<4x4xf32>
+// CHECK: tensor.insert_slice %[[INIT]] into %{{.*}}[0] [1] [1] : tensor<f32> into tensor<4xf32>
+// CHECK: %[[SHIFTED:.*]] = tensor.extract_slice %[[CARRY]]#0[0] [3] [1] : tensor<4xf32> to tensor<3xf32>
+// CHECK: tensor.insert_slice %[[SHIFTED]] into %{{.*}}[1] [3] [1] : tensor<3xf32> into tensor<4xf32>
+// CHECK: %[[FIXED:.*]] = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel", "parallel"]
+// CHECK: arith.addf
+// CHECK: %[[RES:.*]] = tensor.collapse_shape %[[FIXED]] {{\[}}[0, 1]] : tensor<4x4xf32> into tensor<16xf32>
+// CHECK: return %[[RES]], %[[CARRY]]#1
+func.func @scan_1d(%input: tensor<16xf32>, %output: tensor<16xf32>, %init: tensor<f32>) -> (tensor<16xf32>, tensor<f32>) {
+  %0:2 = linalg_ext.scan ins(%input : tensor<16xf32>) outs(%output, %init : tensor<16xf32>, tensor<f32>) dimensions = [0] {
+  ^bb0(%in: f32, %out: f32, %ini: f32):
+    %1 = arith.addf %in, %ini : f32
+    linalg_ext.yield %1, %1 : f32, f32
+  } -> tensor<16xf32>, tensor<f32>
+  return %0#0, %0#1 : tensor<16xf32>, tensor<f32>
+}
+
+// -----
+// CHECK-LABEL: func.func @scan_reverse_2d
+// CHECK-SAME: %[[INPUT:.*]]: tensor<2x8xi32>, %[[OUTPUT:.*]]: tensor<2x8xi32>, %[[INIT:.*]]: tensor<2xi32>
+// CHECK: %[[TILED:.*]] = tensor.expand_shape %[[INPUT]] {{\[}}[0], [1, 2]] {{.*}}: tensor<2x8xi32> into tensor<2x2x4xi32>
+// CHECK: %[[HEAD:.*]] = tensor.extract_slice %[[TILED]][0, 0, 3] [2, 2, 1] [1, 1, 1] : tensor<2x2x4xi32> to tensor<2x2xi32>
+// CHECK: %[[REST:.*]] = tensor.extract_slice %[[TILED]][0, 0, 0] [2, 2, 3] [1, 1, 1] : tensor<2x2x4xi32> to tensor<2x2x3xi32>
+// CHECK: %[[LOCAL:.*]]:2 = linalg_ext.scan {reverse} ins(%[[REST]] : tensor<2x2x3xi32>) outs(%{{.*}}, %[[HEAD]] : tensor<2x2x3xi32>, tensor<2x2xi32>) dimensions = [2]
+// CHECK: %[[CARRY:.*]]:2 = linalg_ext.scan {reverse} ins(%[[LOCAL]]#1 : tensor<2x2xi32>) outs(%{{.*}}, %[[INIT]] : tensor<2x2xi32>, tensor<2xi32>) dimensions = [1]
+// CHECK: tensor.insert_slice %[[INIT]] into %{{.*}}[0, 1] [2, 1] [1, 1] : tensor<2xi32> into tensor<2x2xi32>
+// CHECK: %[[SHIFTED:.*]] = tensor.extract_slice %[[CARRY]]#0[0, 1] [2, 1] [1, 1] : tensor<2x2xi32> to tensor<2x1xi32>
+// CHECK: tensor.insert_slice %[[SHIFTED]] into %{{.*}}[0, 0] [2, 1] [1, 1] : tensor<2x1xi32> into tensor<2x2xi32>
+// CHECK: linalg.generic
+// CHECK: arith.muli
+// CHECK: tensor.collapse_shape %{{.*}} {{\[}}[0], [1, 2]] : tensor<2x2x4xi32> into tensor<2x8xi32>
+func.func @scan_reverse_2d(%input: tensor<2x8xi32>, %output: tensor<2x8xi32>, %init: tensor<2xi32>) -> (tensor<2x8xi32>, tensor<2xi32>) {
+  %0:2 = linalg_ext.scan {reverse} ins(%input : tensor<2x8xi32>) outs(%output, %init : tensor<2x8xi32>, tensor<2xi32>) dimensions = [1] {
+  ^bb0(%in: i32, %out: i32, %ini: i32):
+    %1 = arith.muli %in, %ini : i32
+    linalg_ext.yield %1, %1 : i32, i32
+  } -> tensor<2x8xi32>, tensor<2xi32>
+  return %0#0, %0#1 : tensor<2x8xi32>, tensor<2xi32>
+}
+
+// -----
+// CHECK-LABEL: func.func @scan_multi_operands
+// CHECK: %[[LOCAL:.*]]:4 = linalg_ext.scan ins(%{{.*}}, %{{.*}} : tensor<2x3xf32>, tensor<2x3xi32>)
+// CHECK: %[[CARRY:.*]]:4 = linalg_ext.scan ins(%[[LOCAL]]#2, %[[LOCAL]]#3 : tensor<2xf32>, tensor<2xi32>)
+// CHECK: %[[FIXED:.*]]:2 = linalg.generic
+// CHECK: return %{{.*}}, %{{.*}}, %[[CARRY]]#2, %[[CARRY]]#3
+func.func @scan_multi_operands(%input0: tensor<8xf32>, %input1: tensor<8xi32>, %output0: tensor<8xf32>, %output1: tensor<8xi32>, %init0: tensor<f32>, %init1: tensor<i32>) -> (tensor<8xf32>, tensor<8xi32>, tensor<f32>, tensor<i32>) {
+  %0:4 = linalg_ext.scan ins(%input0, %input1 : tensor<8xf32>, tensor<8xi32>) outs(%output0, %output1, %init0, %init1 : tensor<8xf32>, tensor<8xi32>, tensor<f32>, tensor<i32>) dimensions = [0] {
+  ^bb0(%in0: f32, %in1: i32, %out0: f32, %out1: i32, %ini0: f32, %ini1: i32):
+    %1 = arith.addf %in0, %ini0 : f32
+    %2 = arith.addi %in1, %ini1 : i32
+    linalg_ext.yield %1, %2, %1, %2 : f32, i32, f32, i32
+  } -> tensor<8xf32>, tensor<8xi32>, tensor<f32>, tensor<i32>
+  return %0#0, %0#1, %0#2, %0#3 : tensor<8xf32>, tensor<8xi32>, tensor<f32>, tensor<i32>
+}
+
+// -----
+// CHECK-LABEL: func.func @scan_not_divisible
+// CHECK: linalg_ext.scan
+// CHECK-NOT: linalg.generic
+func.func @scan_not_divisible(%input: tensor<15xf32>, %output: tensor<15xf32>, %init: tensor<f32>) -> (tensor<15xf32>, tensor<f32>) {
+  %0:2 = linalg_ext.scan ins(%input : tensor<15xf32>) outs(%output, %init : tensor<15xf32>, tensor<f32>) dimensions = [0] {
+  ^bb0(%in: f32, %out: f32, %ini: f32):
+    %1 = arith.addf %in, %ini : f32
+    linalg_ext.yield %1, %1 : f32, f32
+  } -> tensor<15xf32>, tensor<f32>
+  return %0#0, %0#1 : tensor<15xf32>, tensor<f32>
+}
@@ -0,0 +1,73 @@
+// RUN: triton-linalg-opt %s -linalg-ext-fold-splat-operands -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @map_splat
+// CHECK-SAME: %[[ARG0:.*]]: tensor<128xf32>, %[[ARG1:.*]]: f32
+// CHECK-NOT: linalg.fill
+// CHECK: %[[EMPTY:.*]] = tensor.empty() : tensor<128xf32>
+// CHECK: %[[RES:.*]] = linalg.map ins(%[[ARG0]] : tensor<128xf32>) outs(%[[EMPTY]] : tensor<128xf32>)
+// CHECK-NEXT: (%[[IN:.*]]: f32) {
+// CHECK-NEXT: %[[ADD:.*]] = arith.addf %[[IN]], %[[ARG1]] : f32
+// CHECK-NEXT: linalg.yield %[[ADD]] : f32
+// CHECK: return %[[RES]]
+func.func @map_splat(%arg0: tensor<128xf32>, %arg1: f32) -> tensor<128xf32> {
+  %0 = tensor.empty() : tensor<128xf32>
+  %1 = linalg.fill ins(%arg1 : f32) outs(%0 : tensor<128xf32>) -> tensor<128xf32>
+  %2 = tensor.empty() : tensor<128xf32>
+  %3 = linalg.map { arith.addf } ins(%arg0, %1 : tensor<128xf32>, tensor<128xf32>) outs(%2 : tensor<128xf32>)
+  return %3 : tensor<128xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @generic_splat
+// CHECK-SAME: %[[ARG0:.*]]: tensor<16x32xf32>
+// CHECK: %[[CST:.*]] = arith.constant 2.000000e+00 : f32
+// CHECK-NOT: linalg.fill
+// CHECK: linalg.generic
+// CHECK-SAME: ins(%[[ARG0]] : tensor<16x32xf32>)
+// CHECK-NEXT: ^bb0(%[[IN:.*]]: f32, %{{.*}}: f32):
+// CHECK-NEXT: %[[MUL:.*]] = arith.mulf %[[IN]], %[[CST]] : f32
+// CHECK-NEXT: linalg.yield %[[MUL]] : f32
+#map = affine_map<(d0, d1) -> (d0, d1)>
+func.func @generic_splat(%arg0: tensor<16x32xf32>) -> tensor<16x32xf32> {
+  %cst = arith.constant 2.000000e+00 : f32
+  %0 = tensor.empty() : tensor<16x32xf32>
+  %1 = linalg.fill ins(%cst : f32) outs(%0 : tensor<16x32xf32>) -> tensor<16x32xf32>
+  %2 = tensor.empty() : tensor<16x32xf32>
+  %3 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = ["parallel", "parallel"]} ins(%arg0, %1 : tensor<16x32xf32>, tensor<16x32xf32>) outs(%2 : tensor<16x32xf32>) {
+  ^bb0(%in: f32, %in_0: f32, %out: f32):
+    %4 = arith.mulf %in, %in_0 : f32
+    linalg.yield %4 : f32
+  } -> tensor<16x32xf32>
+  return %3 : tensor<16x32xf32>
+}
+
+// -----
+// One input is kept when all of them are splats, and a fill used as the init
+// is kept.
+// CHECK-LABEL: func.func @all_splats
+// CHECK-SAME: %[[ARG0:.*]]: f32, %[[ARG1:.*]]: f32
+// CHECK: %[[LHS:.*]] = linalg.fill ins(%[[ARG0]] : f32)
+// CHECK: %[[INIT:.*]] = linalg.fill ins(%[[ARG1]] : f32)
+// CHECK: linalg.map ins(%[[LHS]] : tensor<64xf32>) outs(%[[INIT]] : tensor<64xf32>)
+// CHECK-NEXT: (%[[IN:.*]]: f32) {
+// CHECK-NEXT: arith.subf %[[IN]], %[[ARG1]] : f32
+func.func @all_splats(%arg0: f32, %arg1: f32) -> tensor<64xf32> {
+  %0 = tensor.empty() : tensor<64xf32>
+  %1 = linalg.fill ins(%arg0 : f32) outs(%0 : tensor<64xf32>) -> tensor<64xf32>
+  %2 = linalg.fill ins(%arg1 : f32) outs(%0 : tensor<64xf32>) -> tensor<64xf32>
+  %3 = linalg.map { arith.subf } ins(%1, %2 : tensor<64xf32>, tensor<64xf32>) outs(%2 : tensor<64xf32>)
+  return %3 : tensor<64xf32>
+}
+
+// -----
+// The fill converting its value to the element type is kept.
+// CHECK-LABEL: func.func @converting_fill
+// CHECK: %[[FILL:.*]] = linalg.fill ins(%{{.*}} : f16) outs(%{{.*}} : tensor<64xf32>)
+// CHECK: linalg.map { arith.addf } ins(%{{.*}}, %[[FILL]] : tensor<64xf32>, tensor<64xf32>)
+func.func @converting_fill(%arg0: tensor<64xf32>, %arg1: f16) -> tensor<64xf32> {
+  %0 = tensor.empty() : tensor<64xf32>
+  %1 = linalg.fill ins(%arg1 : f16) outs(%0 : tensor<64xf32>) -> tensor<64xf32>
+  %2 = tensor.empty() : tensor<64xf32>
+  %3 = linalg.map { arith.addf } ins(%arg0, %1 : tensor<64xf32>, tensor<64xf32>) outs(%2 : tensor<64xf32>)
+  return %3 : tensor<64xf32>
+}
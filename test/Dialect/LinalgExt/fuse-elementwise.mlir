@@ -0,0 +1,93 @@
+// RUN: triton-linalg-opt %s -linalg-ext-fuse-elementwise -split-input-file | FileCheck %s
+// RUN: triton-linalg-opt %s -linalg-ext-fuse-elementwise="max-recomputed-ops=0" -split-input-file | FileCheck %s --check-prefix=GUARD
+
+// CHECK-LABEL: func.func @chain
+// CHECK-SAME: %[[ARG0:.*]]: tensor<16x32xf32>, %[[ARG1:.*]]: tensor<16xf32>
+// CHECK-NOT: linalg.map
+// CHECK-NOT: linalg.broadcast
+// CHECK-NOT: linalg.fill
+// CHECK: %[[RES:.*]] = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel", "parallel"]
+// CHECK: arith.mulf
+// CHECK: math.exp
+// CHECK: arith.addf
+// CHECK: linalg.yield
+// CHECK-NOT: linalg.generic
+// CHECK: return %[[RES]]
+func.func @chain(%arg0: tensor<16x32xf32>, %arg1: tensor<16xf32>) -> tensor<16x32xf32> {
+  %cst = arith.constant 1.000000e+00 : f32
+  %0 = tensor.empty() : tensor<16x32xf32>
+  %1 = linalg.broadcast ins(%arg1 : tensor<16xf32>) outs(%0 : tensor<16x32xf32>) dimensions = [1]
+  %2 = tensor.empty() : tensor<16x32xf32>
+  %3 = linalg.map { arith.mulf } ins(%arg0, %1 : tensor<16x32xf32>, tensor<16x32xf32>) outs(%2 : tensor<16x32xf32>)
+  %4 = tensor.empty() : tensor<16x32xf32>
+  %5 = linalg.map { math.exp } ins(%3 : tensor<16x32xf32>) outs(%4 : tensor<16x32xf32>)
+  %6 = tensor.empty() : tensor<16x32xf32>
+  %7 = linalg.fill ins(%cst : f32) outs(%6 : tensor<16x32xf32>) -> tensor<16x32xf32>
+  %8 = tensor.empty() : tensor<16x32xf32>
+  %9 = linalg.map { arith.addf } ins(%5, %7 : tensor<16x32xf32>, tensor<16x32xf32>) outs(%8 : tensor<16x32xf32>)
+  return %9 : tensor<16x32xf32>
+}
+
+// -----
+// The producer has several uses, with a single payload op. Its payload is
+// computed once, in the single op left.
+// CHECK-LABEL: func.func @multi_use
+// CHECK-NOT: linalg.map
+// CHECK: %[[RES:.*]]:2 = linalg.generic
+// CHECK: math.exp
+// CHECK-DAG: arith.addf
+// CHECK-DAG: arith.mulf
+// CHECK-NOT: math.exp
+// CHECK: linalg.yield
+// CHECK-NOT: linalg.generic
+// CHECK: return %[[RES]]#{{.*}}, %[[RES]]#
+// GUARD-LABEL: func.func @multi_use
+// GUARD: %[[EXP:.*]] = linalg.map { math.exp }
+// GUARD: linalg.map { arith.addf } ins(%[[EXP]]
+// GUARD: linalg.map { arith.mulf } ins(%[[EXP]]
+func.func @multi_use(%arg0: tensor<128xf32>, %arg1: tensor<128xf32>) -> (tensor<128xf32>, tensor<128xf32>) {
+  %0 = tensor.empty() : tensor<128xf32>
+  %1 = linalg.map { math.exp } ins(%arg0 : tensor<128xf32>) outs(%0 : tensor<128xf32>)
+  %2 = tensor.empty() : tensor<128xf32>
+  %3 = linalg.map { arith.addf } ins(%1, %arg1 : tensor<128xf32>, tensor<128xf32>) outs(%2 : tensor<128xf32>)
+  %4 = tensor.empty() : tensor<128xf32>
+  %5 = linalg.map { arith.mulf } ins(%1, %arg1 : tensor<128xf32>, tensor<128xf32>) outs(%4 : tensor<128xf32>)
+  return %3, %5 : tensor<128xf32>, tensor<128xf32>
+}
+
+// -----
+// The fill is the init of a reduction, which is not an elementwise consumer.
+// CHECK-LABEL: func.func @fill_init
+// CHECK: %[[FILL:.*]] = linalg.fill
+// CHECK: linalg.reduce { arith.addf } ins(%{{.*}} : tensor<16x32xf32>) outs(%[[FILL]] : tensor<16xf32>)
+func.func @fill_init(%arg0: tensor<16x32xf32>) -> tensor<16xf32> {
+  %cst = arith.constant 0.000000e+00 : f32
+  %0 = tensor.empty() : tensor<16xf32>
+  %1 = linalg.fill ins(%cst : f32) outs(%0 : tensor<16xf32>) -> tensor<16xf32>
+  %2 = linalg.reduce { arith.addf } ins(%arg0 : tensor<16x32xf32>) outs(%1 : tensor<16xf32>) dimensions = [1]
+  return %2 : tensor<16xf32>
+}
+
+// -----
+// A use of the producer before the consumer is not dominated by the fused op,
+// so it keeps reading the producer.
+// CHECK-LABEL: func.func @use_before_consumer
+// CHECK: %[[EXP:.*]] = linalg.generic
+// CHECK: math.exp
+// CHECK: %[[SUM:.*]] = linalg.reduce { arith.addf } ins(%[[EXP]] : tensor<16x32xf32>)
+// CHECK: %[[RES:.*]]:2 = linalg.generic
+// CHECK: math.exp
+// CHECK: arith.addf
+// CHECK: return %[[SUM]], %[[RES]]#1
+func.func @use_before_consumer(%arg0: tensor<16x32xf32>, %arg1: tensor<16x32xf32>) -> (tensor<16xf32>, tensor<16x32xf32>) {
+  %cst = arith.constant 0.000000e+00 : f32
+  %0 = tensor.empty() : tensor<16x32xf32>
+  %1 = linalg.map { math.exp } ins(%arg0 : tensor<16x32xf32>) outs(%0 : tensor<16x32xf32>)
+  %2 = tensor.empty() : tensor<16xf32>
+  %3 = linalg.fill ins(%cst : f32) outs(%2 : tensor<16xf32>) -> tensor<16xf32>
+  %4 = linalg.reduce { arith.addf } ins(%1 : tensor<16x32xf32>) outs(%3 : tensor<16xf32>) dimensions = [1]
+  %5 = tensor.empty() : tensor<16x32xf32>
+  %6 = linalg.map { arith.addf } ins(%1, %arg1 : tensor<16x32xf32>, tensor<16x32xf32>) outs(%5 : tensor<16x32xf32>)
+  return %4, %6 : tensor<16xf32>, tensor<16x32xf32>
+}
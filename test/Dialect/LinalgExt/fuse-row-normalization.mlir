@@ -0,0 +1,126 @@
+// RUN: triton-linalg-opt %s -linalg-ext-fuse-row-normalization -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @softmax
+// CHECK-SAME: %[[X:.*]]: tensor<4x128xf32>
+// CHECK-DAG: %[[NEG_INF:.*]] = linalg.fill ins(%{{.*}} : f32) outs(%{{.*}} : tensor<4xf32>)
+// CHECK-DAG: %[[ZERO:.*]] = linalg.fill ins(%{{.*}} : f32) outs(%{{.*}} : tensor<4xf32>)
+// CHECK: %[[STATS:.*]]:2 = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel", "reduction"]
+// CHECK-SAME: ins(%[[X]] : tensor<4x128xf32>) outs(%[[NEG_INF]], %[[ZERO]] : tensor<4xf32>, tensor<4xf32>)
+// CHECK: arith.maximumf
+// CHECK: math.exp
+// CHECK: math.exp
+// CHECK: linalg.yield
+// CHECK: %[[RES:.*]] = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel", "parallel"]
+// CHECK-SAME: ins(%[[X]], %[[STATS]]#0, %[[STATS]]#1 : tensor<4x128xf32>, tensor<4xf32>, tensor<4xf32>)
+// CHECK: arith.subf
+// CHECK: math.exp
+// CHECK: arith.divf
+// CHECK-NOT: linalg.reduce
+// CHECK-NOT: linalg.broadcast
+// CHECK: return %[[RES]]
+func.func @softmax(%x: tensor<4x128xf32>) -> tensor<4x128xf32> {
+  %cst = arith.constant 0xFF800000 : f32
+  %cst_0 = arith.constant 0.000000e+00 : f32
+  %0 = tensor.empty() : tensor<4xf32>
+  %1 = linalg.fill ins(%cst : f32) outs(%0 : tensor<4xf32>) -> tensor<4xf32>
+  %max = linalg.reduce ins(%x : tensor<4x128xf32>) outs(%1 : tensor<4xf32>) dimensions = [1]
+    (%in: f32, %init: f32) {
+      %10 = arith.maximumf %in, %init : f32
+      linalg.yield %10 : f32
+    }
+  %2 = tensor.expand_shape %max [[0, 1]] output_shape [4, 1] : tensor<4xf32> into tensor<4x1xf32>
+  %3 = tensor.collapse_shape %2 [[0, 1]] : tensor<4x1xf32> into tensor<4xf32>
+  %4 = tensor.empty() : tensor<4x128xf32>
+  %5 = linalg.broadcast ins(%3 : tensor<4xf32>) outs(%4 : tensor<4x128xf32>) dimensions = [1]
+  %6 = linalg.map { arith.subf } ins(%x, %5 : tensor<4x128xf32>, tensor<4x128xf32>) outs(%4 : tensor<4x128xf32>)
+  %7 = linalg.map { math.exp } ins(%6 : tensor<4x128xf32>) outs(%4 : tensor<4x128xf32>)
+  %8 = linalg.fill ins(%cst_0 : f32) outs(%0 : tensor<4xf32>) -> tensor<4xf32>
+  %sum = linalg.reduce ins(%7 : tensor<4x128xf32>) outs(%8 : tensor<4xf32>) dimensions = [1]
+    (%in: f32, %init: f32) {
+      %10 = arith.addf %in, %init : f32
+      linalg.yield %10 : f32
+    }
+  %9 = linalg.broadcast ins(%sum : tensor<4xf32>) outs(%4 : tensor<4x128xf32>) dimensions = [1]
+  %res = linalg.map { arith.divf } ins(%7, %9 : tensor<4x128xf32>, tensor<4x128xf32>) outs(%4 : tensor<4x128xf32>)
+  return %res : tensor<4x128xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @softmax_max_not_neutral
+// CHECK-NOT: linalg.generic
+func.func @softmax_max_not_neutral(%x: tensor<4x128xf32>) -> tensor<4x128xf32> {
+  %cst = arith.constant 0.000000e+00 : f32
+  %0 = tensor.empty() : tensor<4xf32>
+  %1 = linalg.fill ins(%cst : f32) outs(%0 : tensor<4xf32>) -> tensor<4xf32>
+  %max = linalg.reduce ins(%x : tensor<4x128xf32>) outs(%1 : tensor<4xf32>) dimensions = [1]
+    (%in: f32, %init: f32) {
+      %10 = arith.maximumf %in, %init : f32
+      linalg.yield %10 : f32
+    }
+  %4 = tensor.empty() : tensor<4x128xf32>
+  %5 = linalg.broadcast ins(%max : tensor<4xf32>) outs(%4 : tensor<4x128xf32>) dimensions = [1]
+  %6 = linalg.map { arith.subf } ins(%x, %5 : tensor<4x128xf32>, tensor<4x128xf32>) outs(%4 : tensor<4x128xf32>)
+  %7 = linalg.map { math.exp } ins(%6 : tensor<4x128xf32>) outs(%4 : tensor<4x128xf32>)
+  %sum = linalg.reduce ins(%7 : tensor<4x128xf32>) outs(%1 : tensor<4xf32>) dimensions = [1]
+    (%in: f32, %init: f32) {
+      %10 = arith.addf %in, %init : f32
+      linalg.yield %10 : f32
+    }
+  %9 = linalg.broadcast ins(%sum : tensor<4xf32>) outs(%4 : tensor<4x128xf32>) dimensions = [1]
+  %res = linalg.map { arith.divf } ins(%7, %9 : tensor<4x128xf32>, tensor<4x128xf32>) outs(%4 : tensor<4x128xf32>)
+  return %res : tensor<4x128xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @layernorm
+// CHECK-SAME: %[[X:.*]]: tensor<4x128xf32>
+// CHECK: %[[STATS:.*]]:3 = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel", "reduction"]
+// CHECK-SAME: ins(%[[X]] : tensor<4x128xf32>)
+// CHECK-SAME: outs(%{{.*}}, %{{.*}}, %{{.*}} : tensor<4xf32>, tensor<4xf32>, tensor<4xf32>)
+// CHECK-NEXT: ^bb0(%[[IN:.*]]: f32, %[[MEAN:.*]]: f32, %[[M2:.*]]: f32, %[[COUNT:.*]]: f32):
+// CHECK-NOT: linalg.index
+// CHECK: %[[ONE:.*]] = arith.constant 1.000000e+00 : f32
+// CHECK: %[[NEW_COUNT:.*]] = arith.addf %[[COUNT]], %[[ONE]] : f32
+// CHECK: %[[DELTA:.*]] = arith.subf %[[IN]], %[[MEAN]] : f32
+// CHECK: %[[STEP:.*]] = arith.divf %[[DELTA]], %[[NEW_COUNT]] : f32
+// CHECK: %[[NEW_MEAN:.*]] = arith.addf %[[MEAN]], %[[STEP]] : f32
+// CHECK: linalg.yield %[[NEW_MEAN]], %{{.*}}, %[[NEW_COUNT]] : f32, f32, f32
+// CHECK: %[[VAR:.*]] = linalg.map { arith.divf } ins(%[[STATS]]#1, %{{.*}} : tensor<4xf32>, tensor<4xf32>)
+// CHECK: %[[RSTD:.*]] = linalg.map { math.rsqrt } ins(%[[VAR]] : tensor<4xf32>)
+// CHECK: %[[RES:.*]] = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel", "parallel"]
+// CHECK-SAME: ins(%[[X]], %[[STATS]]#0, %[[RSTD]] : tensor<4x128xf32>, tensor<4xf32>, tensor<4xf32>)
+// CHECK: arith.subf
+// CHECK: arith.mulf
+// CHECK-NOT: linalg.reduce
+// CHECK: return %[[RES]]
+func.func @layernorm(%x: tensor<4x128xf32>) -> tensor<4x128xf32> {
+  %cst = arith.constant 0.000000e+00 : f32
+  %cst_0 = arith.constant 1.280000e+02 : f32
+  %0 = tensor.empty() : tensor<4xf32>
+  %1 = linalg.fill ins(%cst : f32) outs(%0 : tensor<4xf32>) -> tensor<4xf32>
+  %2 = linalg.reduce ins(%x : tensor<4x128xf32>) outs(%1 : tensor<4xf32>) dimensions = [1]
+    (%in: f32, %init: f32) {
+      %10 = arith.addf %in, %init : f32
+      linalg.yield %10 : f32
+    }
+  %n = linalg.fill ins(%cst_0 : f32) outs(%0 : tensor<4xf32>) -> tensor<4xf32>
+  %mean = linalg.map { arith.divf } ins(%2, %n : tensor<4xf32>, tensor<4xf32>) outs(%0 : tensor<4xf32>)
+  %3 = tensor.empty() : tensor<4x128xf32>
+  %4 = linalg.broadcast ins(%mean : tensor<4xf32>) outs(%3 : tensor<4x128xf32>) dimensions = [1]
+  %xc = linalg.map { arith.subf } ins(%x, %4 : tensor<4x128xf32>, tensor<4x128xf32>) outs(%3 : tensor<4x128xf32>)
+  %5 = linalg.map { arith.mulf } ins(%xc, %xc : tensor<4x128xf32>, tensor<4x128xf32>) outs(%3 : tensor<4x128xf32>)
+  %6 = linalg.reduce ins(%5 : tensor<4x128xf32>) outs(%1 : tensor<4xf32>) dimensions = [1]
+    (%in: f32, %init: f32) {
+      %10 = arith.addf %in, %init : f32
+      linalg.yield %10 : f32
+    }
+  %var = linalg.map { arith.divf } ins(%6, %n : tensor<4xf32>, tensor<4xf32>) outs(%0 : tensor<4xf32>)
+  %rstd = linalg.map { math.rsqrt } ins(%var : tensor<4xf32>) outs(%0 : tensor<4xf32>)
+  %7 = linalg.broadcast ins(%rstd : tensor<4xf32>) outs(%3 : tensor<4x128xf32>) dimensions = [1]
+  %res = linalg.map { arith.mulf } ins(%xc, %7 : tensor<4x128xf32>, tensor<4x128xf32>) outs(%3 : tensor<4x128xf32>)
+  return %res : tensor<4x128xf32>
+}
@@ -599,6 +599,21 @@ func.func @scatter_indice_type_mismatch(
   return %0 : tensor<?x?xi64>
 }
 
+// -----
+func.func @gather_invalid_evict_mode(
+    %init : tensor<4x2x4xf32>, %indices : tensor<4x1xi32>,
+    %input : tensor<16x8xf32>) -> tensor<4x2x4xf32> {
+  // expected-error @+1 {{invalid evict_mode attribute specification: "evict_never"}}
+  %0 = linalg_ext.gather evict_mode("evict_never") dimension_map = [1]
+    ranged_data(true)
+      ins(%input, %indices : tensor<16x8xf32>, tensor<4x1xi32>)
+      outs(%init : tensor<4x2x4xf32>) {
+      ^bb0(%arg1: f32, %arg2: f32):
+        linalg_ext.yield %arg1 : f32
+      } -> tensor<4x2x4xf32>
+  return %0 : tensor<4x2x4xf32>
+}
+
 // -----
 func.func @gather_extra_outputs(
     %init : tensor<?x?x1xf32>, %indices : tensor<?x1xi32>,
@@ -1209,3 +1224,11 @@ func.func @scan_multi_operands(%input0: tensor<16x32x64xf32>,
       }
   func.return
 }
+
+// -----
+
+func.func @atomic_rmw_shape_mismatch(%input: tensor<128xf32>, %val: tensor<64xf32>, %init: tensor<128xf32>) -> tensor<128xf32> {
+  // expected-error @+1 {{'linalg_ext.atomic_rmw' op expected input, val and init to have compatible shapes}}
+  %0 = linalg_ext.atomic_rmw addf ins(%input, %val : tensor<128xf32>, tensor<64xf32>) outs(%init : tensor<128xf32>) -> tensor<128xf32>
+  return %0 : tensor<128xf32>
+}
@@ -0,0 +1,17 @@
+// RUN: triton-linalg-opt %s -linalg-ext-lower-libdevice-call -split-input-file -verify-diagnostics
+
+func.func @fma_arity(%arg0: tensor<64xf32>, %arg1: tensor<64xf32>) -> tensor<64xf32> {
+  %0 = tensor.empty() : tensor<64xf32>
+  // expected-error @+1 {{op 'math.fma' does not compute the elements of libdevice symbol '__nv_fmaf' from 2 operands}}
+  %1 = linalg_ext.libdevice_call ins(%arg0, %arg1 : tensor<64xf32>, tensor<64xf32>) outs(%0 : tensor<64xf32>) symbol = "__nv_fmaf" -> tensor<64xf32>
+  return %1 : tensor<64xf32>
+}
+
+// -----
+func.func @exp_integer(%arg0: tensor<64xi32>) -> tensor<64xi32> {
+  %0 = tensor.empty() : tensor<64xi32>
+  // expected-error @+2 {{'math.exp' op operand #0 must be floating-point-like}}
+  // expected-error @+1 {{op 'math.exp' does not compute the elements of libdevice symbol '__nv_expf'}}
+  %1 = linalg_ext.libdevice_call ins(%arg0 : tensor<64xi32>) outs(%0 : tensor<64xi32>) symbol = "__nv_expf" -> tensor<64xi32>
+  return %1 : tensor<64xi32>
+}
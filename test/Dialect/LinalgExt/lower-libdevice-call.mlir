@@ -0,0 +1,79 @@
+// RUN: triton-linalg-opt %s -linalg-ext-lower-libdevice-call -split-input-file | FileCheck %s --check-prefixes=CHECK,DEFAULT
+// RUN: triton-linalg-opt %s -linalg-ext-lower-libdevice-call="registry=%S/Inputs/libdevice-registry.json" -split-input-file | FileCheck %s --check-prefixes=CHECK,VECLIB
+
+// CHECK-LABEL: func.func @exp
+// CHECK-SAME: %[[ARG0:.*]]: tensor<16x32xf32>
+// CHECK: %[[INIT:.*]] = tensor.empty() : tensor<16x32xf32>
+// CHECK: %[[RES:.*]] = linalg.map { math.exp } ins(%[[ARG0]] : tensor<16x32xf32>) outs(%[[INIT]] : tensor<16x32xf32>)
+// CHECK: return %[[RES]]
+func.func @exp(%arg0: tensor<16x32xf32>) -> tensor<16x32xf32> {
+  %0 = tensor.empty() : tensor<16x32xf32>
+  %1 = linalg_ext.libdevice_call ins(%arg0 : tensor<16x32xf32>) outs(%0 : tensor<16x32xf32>) symbol = "__nv_expf" -> tensor<16x32xf32>
+  return %1 : tensor<16x32xf32>
+}
+
+// -----
+// The registry expands tanh to its polynomial approximation.
+// CHECK-LABEL: func.func @tanh
+// CHECK: linalg.map
+// DEFAULT-SAME: { math.tanh }
+// VECLIB-NOT: math.tanh
+// VECLIB: linalg.yield
+func.func @tanh(%arg0: tensor<128xf32>) -> tensor<128xf32> {
+  %0 = tensor.empty() : tensor<128xf32>
+  %1 = linalg_ext.libdevice_call ins(%arg0 : tensor<128xf32>) outs(%0 : tensor<128xf32>) symbol = "__nv_tanhf" -> tensor<128xf32>
+  return %1 : tensor<128xf32>
+}
+
+// -----
+// The registry calls a vector function on the rows, whose tails are masked.
+// VECLIB: func.func private @_ZGVbN4v_erff(vector<4xf32>) -> vector<4xf32>
+// CHECK-LABEL: func.func @erf
+// CHECK-SAME: %[[ARG0:.*]]: tensor<16x30xf32>
+// CHECK: %[[INIT:.*]] = tensor.empty() : tensor<16x30xf32>
+// DEFAULT: linalg.map { math.erf } ins(%[[ARG0]] : tensor<16x30xf32>) outs(%[[INIT]] : tensor<16x30xf32>)
+// VECLIB-DAG: %[[C0:.*]] = arith.constant 0 : index
+// VECLIB-DAG: %[[C1:.*]] = arith.constant 1 : index
+// VECLIB-DAG: %[[C4:.*]] = arith.constant 4 : index
+// VECLIB-DAG: %[[C16:.*]] = arith.constant 16 : index
+// VECLIB-DAG: %[[C30:.*]] = arith.constant 30 : index
+// VECLIB: %[[RES:.*]] = scf.for %[[I:.*]] = %[[C0]] to %[[C16]] step %[[C1]] iter_args(%[[ACC:.*]] = %[[INIT]]) -> (tensor<16x30xf32>)
+// VECLIB: scf.for %[[J:.*]] = %[[C0]] to %[[C30]] step %[[C4]] iter_args(%[[ROW:.*]] = %[[ACC]]) -> (tensor<16x30xf32>)
+// VECLIB: %[[IN:.*]] = vector.transfer_read %[[ARG0]][%[[I]], %[[J]]], %{{.*}} : tensor<16x30xf32>, vector<4xf32>
+// VECLIB: %[[OUT:.*]] = func.call @_ZGVbN4v_erff(%[[IN]]) : (vector<4xf32>) -> vector<4xf32>
+// VECLIB: %[[UPDATED:.*]] = vector.transfer_write %[[OUT]], %[[ROW]][%[[I]], %[[J]]] : vector<4xf32>, tensor<16x30xf32>
+// VECLIB: scf.yield %[[UPDATED]]
+// VECLIB: return %[[RES]]
+func.func @erf(%arg0: tensor<16x30xf32>) -> tensor<16x30xf32> {
+  %0 = tensor.empty() : tensor<16x30xf32>
+  %1 = linalg_ext.libdevice_call ins(%arg0 : tensor<16x30xf32>) outs(%0 : tensor<16x30xf32>) symbol = "__nv_erff" -> tensor<16x30xf32>
+  return %1 : tensor<16x30xf32>
+}
+
+// -----
+// A scalar input is captured by the map, or broadcast to a vector.
+// VECLIB: func.func private @_ZGVbN4vv_powf(vector<4xf32>, vector<4xf32>) -> vector<4xf32>
+// CHECK-LABEL: func.func @pow_scalar
+// CHECK-SAME: %[[ARG0:.*]]: tensor<64xf32>, %[[ARG1:.*]]: f32
+// DEFAULT: linalg.map ins(%[[ARG0]] : tensor<64xf32>)
+// DEFAULT-NEXT: (%[[IN:.*]]: f32) {
+// DEFAULT-NEXT: math.powf %[[IN]], %[[ARG1]] : f32
+// VECLIB: scf.for
+// VECLIB: %[[BASE:.*]] = vector.transfer_read %[[ARG0]]
+// VECLIB: %[[EXP:.*]] = vector.broadcast %[[ARG1]] : f32 to vector<4xf32>
+// VECLIB: func.call @_ZGVbN4vv_powf(%[[BASE]], %[[EXP]])
+func.func @pow_scalar(%arg0: tensor<64xf32>, %arg1: f32) -> tensor<64xf32> {
+  %0 = tensor.empty() : tensor<64xf32>
+  %1 = linalg_ext.libdevice_call ins(%arg0, %arg1 : tensor<64xf32>, f32) outs(%0 : tensor<64xf32>) symbol = "__nv_powf" -> tensor<64xf32>
+  return %1 : tensor<64xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @unknown_symbol
+// CHECK: linalg_ext.libdevice_call
+// CHECK-SAME: symbol = "__my_gelu"
+func.func @unknown_symbol(%arg0: tensor<64xf32>) -> tensor<64xf32> {
+  %0 = tensor.empty() : tensor<64xf32>
+  %1 = linalg_ext.libdevice_call ins(%arg0 : tensor<64xf32>) outs(%0 : tensor<64xf32>) symbol = "__my_gelu" -> tensor<64xf32>
+  return %1 : tensor<64xf32>
+}
@@ -343,6 +343,20 @@ func.func @atomic_cas(%arg0: tensor<128xi32>, %cmp: tensor<128xi32>, %val: tenso
   return %0: tensor<128xi32>
 }
 
+// -----
+// CHECK: linalg_ext.atomic_rmw addf
+func.func @atomic_rmw(%arg0: tensor<?xf32>, %val: tensor<?xf32>, %init: tensor<?xf32>) -> tensor<?xf32> {
+  %0 = linalg_ext.atomic_rmw addf ins(%arg0, %val : tensor<?xf32>, tensor<?xf32>) outs(%init : tensor<?xf32>) -> tensor<?xf32>
+  return %0: tensor<?xf32>
+}
+
+// -----
+// CHECK: linalg_ext.atomic_rmw maxs
+func.func @atomic_rmw_memref(%arg0: memref<16x32xi32, strided<[64, 1], offset: ?>>, %val: memref<16x32xi32>, %init: memref<16x32xi32>) {
+  linalg_ext.atomic_rmw maxs ins(%arg0, %val : memref<16x32xi32, strided<[64, 1], offset: ?>>, memref<16x32xi32>) outs(%init : memref<16x32xi32>)
+  return
+}
+
 // -----
 // CHECK: linalg_ext.gather_atomic_cas
 func.func @gather_atomic_cas(%in: tensor<?xi32>, %cmp: tensor<128xi32>, %val: tensor<128xi32>, %indice: tensor<128xi64>, %init: tensor<128xi32>) -> tensor<128xi32> {
@@ -350,6 +364,45 @@ func.func @gather_atomic_cas(%in: tensor<?xi32>, %cmp: tensor<128xi32>, %val: te
   return %4: tensor<128xi32>
 }
 
+// -----
+// CHECK-LABEL: func @gather_with_memory_hints
+// CHECK: linalg_ext.gather {cache_mode = "cmtransient", is_volatile} evict_mode(evict_first)
+func.func @gather_with_memory_hints(%A : tensor<4x1xi32>, %B: tensor<4x2x4xf32>, %C: tensor<16x8xf32>) -> tensor<4x2x4xf32> {
+  %gather = linalg_ext.gather {cache_mode = "cmtransient", is_volatile} evict_mode(evict_first)
+              dimension_map = [1]
+              ranged_data(true)
+              ins(%C, %A: tensor<16x8xf32>, tensor<4x1xi32>)
+              outs(%B: tensor<4x2x4xf32>) {
+                ^bb0(%arg0 :f32, %arg1: f32):
+                  linalg_ext.yield %arg0 : f32
+              } -> tensor<4x2x4xf32>
+  return %gather : tensor<4x2x4xf32>
+}
+
+// -----
+// CHECK-LABEL: func @scatter_with_memory_hints
+// CHECK: linalg_ext.scatter evict_mode(evict_last)
+func.func @scatter_with_memory_hints(%A : tensor<4x1xi32>, %B: tensor<4x2x4xf32>, %C: tensor<16x8xf32>) -> tensor<16x8xf32> {
+  %scatter = linalg_ext.scatter evict_mode(evict_last)
+              dimension_map = [1]
+              ranged_data(true)
+              overlap_window(false)
+              ins(%B, %A: tensor<4x2x4xf32>, tensor<4x1xi32>)
+              outs(%C: tensor<16x8xf32>) {
+                ^bb0(%arg0 :f32, %arg1: f32):
+                  linalg_ext.yield %arg0 : f32
+              } -> tensor<16x8xf32>
+  return %scatter : tensor<16x8xf32>
+}
+
+// -----
+// CHECK-LABEL: func @atomic_cas_with_memory_hints
+// CHECK: linalg_ext.atomic_cas {cache_mode = "cmnormal"}
+func.func @atomic_cas_with_memory_hints(%arg0: tensor<128xi32>, %cmp: tensor<128xi32>, %val: tensor<128xi32>, %init: tensor<128xi32>) -> tensor<128xi32> {
+  %0 = linalg_ext.atomic_cas {cache_mode = "cmnormal"} ins(%arg0, %cmp, %val : tensor<128xi32>, tensor<128xi32>, tensor<128xi32>) outs(%init : tensor<128xi32>) -> tensor<128xi32>
+  return %0: tensor<128xi32>
+}
+
 // -----
 // CHECK: linalg_ext.libdevice_call
 func.func @libdevice_call_tensor(%arg1: tensor<16x32x64xf32>, %arg2: tensor<16x32x64xf32>,
@@ -0,0 +1,54 @@
+// RUN: triton-linalg-opt %s -linalg-ext-reuse-tensor-inits -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @elementwise_in_place
+// CHECK-SAME: %[[ARG0:.*]]: tensor<128xf32>
+// CHECK: %[[EMPTY:.*]] = tensor.empty() : tensor<128xf32>
+// CHECK: %[[EXP:.*]] = linalg.map { math.exp } ins(%[[ARG0]] : tensor<128xf32>) outs(%[[EMPTY]] : tensor<128xf32>)
+// CHECK: %[[ADD:.*]] = linalg.map { arith.addf } ins(%[[EXP]], %[[EXP]] : tensor<128xf32>, tensor<128xf32>) outs(%[[EXP]] : tensor<128xf32>)
+// CHECK: %[[MUL:.*]] = linalg.map { arith.mulf } ins(%[[ADD]], %[[ARG0]] : tensor<128xf32>, tensor<128xf32>) outs(%[[ADD]] : tensor<128xf32>)
+// CHECK-NOT: tensor.empty
+// CHECK: return %[[MUL]]
+func.func @elementwise_in_place(%arg0: tensor<128xf32>) -> tensor<128xf32> {
+  %0 = tensor.empty() : tensor<128xf32>
+  %1 = linalg.map { math.exp } ins(%arg0 : tensor<128xf32>) outs(%0 : tensor<128xf32>)
+  %2 = tensor.empty() : tensor<128xf32>
+  %3 = linalg.map { arith.addf } ins(%1, %1 : tensor<128xf32>, tensor<128xf32>) outs(%2 : tensor<128xf32>)
+  %4 = tensor.empty() : tensor<128xf32>
+  %5 = linalg.map { arith.mulf } ins(%3, %arg0 : tensor<128xf32>, tensor<128xf32>) outs(%4 : tensor<128xf32>)
+  return %5 : tensor<128xf32>
+}
+
+// -----
+// The input of the reduction is dead after it, and reused by the broadcast.
+// CHECK-LABEL: func.func @reuse_dead_tensor
+// CHECK: %[[EXP:.*]] = linalg.map { math.exp }
+// CHECK: %[[FILL:.*]] = linalg.fill
+// CHECK: %[[SUM:.*]] = linalg.reduce { arith.addf } ins(%[[EXP]] : tensor<16x32xf32>) outs(%[[FILL]] : tensor<16xf32>)
+// CHECK: linalg.broadcast ins(%[[SUM]] : tensor<16xf32>) outs(%[[EXP]] : tensor<16x32xf32>)
+func.func @reuse_dead_tensor(%arg0: tensor<16x32xf32>) -> tensor<16x32xf32> {
+  %cst = arith.constant 0.000000e+00 : f32
+  %0 = tensor.empty() : tensor<16x32xf32>
+  %1 = linalg.map { math.exp } ins(%arg0 : tensor<16x32xf32>) outs(%0 : tensor<16x32xf32>)
+  %2 = tensor.empty() : tensor<16xf32>
+  %3 = linalg.fill ins(%cst : f32) outs(%2 : tensor<16xf32>) -> tensor<16xf32>
+  %4 = linalg.reduce { arith.addf } ins(%1 : tensor<16x32xf32>) outs(%3 : tensor<16xf32>) dimensions = [1]
+  %5 = tensor.empty() : tensor<16x32xf32>
+  %6 = linalg.broadcast ins(%4 : tensor<16xf32>) outs(%5 : tensor<16x32xf32>) dimensions = [1]
+  return %6 : tensor<16x32xf32>
+}
+
+// -----
+// A live tensor, a transposed input and a read init are not reused.
+// CHECK-LABEL: func.func @no_reuse
+// CHECK: %[[EXP:.*]] = linalg.map { math.exp }
+// CHECK: %[[EMPTY:.*]] = tensor.empty() : tensor<32x32xf32>
+// CHECK: %[[TRANS:.*]] = linalg.transpose ins(%[[EXP]] : tensor<32x32xf32>) outs(%[[EMPTY]] : tensor<32x32xf32>)
+// CHECK: linalg.matmul ins(%[[TRANS]], %[[EXP]] : tensor<32x32xf32>, tensor<32x32xf32>) outs(%{{.*}} : tensor<32x32xf32>)
+func.func @no_reuse(%arg0: tensor<32x32xf32>, %arg1: tensor<32x32xf32>) -> tensor<32x32xf32> {
+  %0 = tensor.empty() : tensor<32x32xf32>
+  %1 = linalg.map { math.exp } ins(%arg0 : tensor<32x32xf32>) outs(%0 : tensor<32x32xf32>)
+  %2 = tensor.empty() : tensor<32x32xf32>
+  %3 = linalg.transpose ins(%1 : tensor<32x32xf32>) outs(%2 : tensor<32x32xf32>) permutation = [1, 0]
+  %4 = linalg.matmul ins(%3, %1 : tensor<32x32xf32>, tensor<32x32xf32>) outs(%arg1 : tensor<32x32xf32>) -> tensor<32x32xf32>
+  return %4 : tensor<32x32xf32>
+}
@@ -0,0 +1,76 @@
+// RUN: triton-linalg-opt %s -linalg-ext-sort-gather-indices -split-input-file | FileCheck %s
+// RUN: triton-linalg-opt %s -linalg-ext-sort-gather-indices="bucket-size=16" -split-input-file | FileCheck %s --check-prefix=BUCKET
+// RUN: triton-linalg-opt %s -linalg-ext-sort-gather-indices="max-batch-size=8" -split-input-file | FileCheck %s --check-prefix=LIMIT
+
+// CHECK-LABEL: func.func @gather_sort_indices
+// CHECK-SAME: %[[INPUT:.*]]: tensor<1024x8xf32>, %[[INDICES:.*]]: tensor<16x1xi32>, %[[MASK:.*]]: tensor<16xi1>, %[[INIT:.*]]: tensor<16x1x8xf32>
+// CHECK: %[[FLAT:.*]] = tensor.collapse_shape %[[INDICES]] {{\[}}[0, 1]] : tensor<16x1xi32> into tensor<16xi32>
+// CHECK: %[[STATS:.*]]:2 = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel", "reduction"]
+// CHECK-SAME: ins(%[[FLAT]], %[[FLAT]], %[[MASK]], %[[MASK]] : tensor<16xi32>, tensor<16xi32>, tensor<16xi1>, tensor<16xi1>)
+// CHECK-SAME: outs(%{{.*}}, %{{.*}} : tensor<16xi64>, tensor<16xindex>)
+// CHECK: %[[IOTA:.*]] = linalg.generic
+// CHECK-SAME: outs(%{{.*}} : tensor<16x1xi64>)
+// CHECK: %[[RANK:.*]] = tensor.expand_shape %[[STATS]]#0 {{\[}}[0, 1]]
+// CHECK: %[[PERM:.*]] = linalg_ext.scatter dimension_map = [0] ranged_data(true) overlap_window(false)
+// CHECK-SAME: ins(%[[IOTA]], %[[RANK]] : tensor<16x1xi64>, tensor<16x1xi64>)
+// CHECK: %[[SORTED:.*]]:2 = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel"]
+// CHECK-SAME: ins(%[[PERM]] : tensor<16xi64>)
+// CHECK: tensor.extract %[[FLAT]]
+// CHECK: tensor.extract %[[MASK]]
+// CHECK: tensor.extract %[[STATS]]#1
+// CHECK: %[[SORTED_INDICES:.*]] = tensor.expand_shape %[[SORTED]]#0 {{\[}}[0, 1]]
+// CHECK: %[[WINDOW:.*]] = linalg_ext.gather dimension_map = [0] ranged_data(false)
+// CHECK-SAME: ins(%[[INPUT]], %[[SORTED_INDICES]], %[[SORTED]]#1 : tensor<1024x8xf32>, tensor<16x1xi32>, tensor<16xi1>)
+// CHECK: %[[RES:.*]] = linalg.generic
+// CHECK-SAME: iterator_types = ["parallel", "parallel", "parallel"]
+// CHECK-SAME: ins(%[[INIT]] : tensor<16x1x8xf32>)
+// CHECK: tensor.extract %[[WINDOW]]
+// CHECK: return %[[RES]]
+
+// BUCKET-LABEL: func.func @gather_sort_indices
+// BUCKET: arith.floordivsi
+// BUCKET: arith.floordivsi
+
+// LIMIT-LABEL: func.func @gather_sort_indices
+// LIMIT-NOT: linalg.generic
+// LIMIT: linalg_ext.gather {sort_indices}
+func.func @gather_sort_indices(%input: tensor<1024x8xf32>, %indices: tensor<16x1xi32>, %mask: tensor<16xi1>, %init: tensor<16x1x8xf32>) -> tensor<16x1x8xf32> {
+  %0 = linalg_ext.gather {sort_indices} dimension_map = [0] ranged_data(false)
+         ins(%input, %indices, %mask : tensor<1024x8xf32>, tensor<16x1xi32>, tensor<16xi1>)
+         outs(%init : tensor<16x1x8xf32>) {
+         ^bb0(%arg0: f32, %arg1: f32):
+           linalg_ext.yield %arg0 : f32
+         } -> tensor<16x1x8xf32>
+  return %0 : tensor<16x1x8xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @gather_without_sort_indices
+// CHECK-NOT: linalg.generic
+// CHECK: linalg_ext.gather dimension_map = [0]
+func.func @gather_without_sort_indices(%input: tensor<1024x8xf32>, %indices: tensor<16x1xi32>, %init: tensor<16x1x8xf32>) -> tensor<16x1x8xf32> {
+  %0 = linalg_ext.gather dimension_map = [0] ranged_data(false)
+         ins(%input, %indices : tensor<1024x8xf32>, tensor<16x1xi32>)
+         outs(%init : tensor<16x1x8xf32>) {
+         ^bb0(%arg0: f32, %arg1: f32):
+           linalg_ext.yield %arg0 : f32
+         } -> tensor<16x1x8xf32>
+  return %0 : tensor<16x1x8xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @gather_sort_indices_not_copy
+// CHECK-NOT: linalg.generic
+// CHECK: linalg_ext.gather {sort_indices}
+func.func @gather_sort_indices_not_copy(%input: tensor<1024x8xf32>, %indices: tensor<16x1xi32>, %init: tensor<16x1x8xf32>) -> tensor<16x1x8xf32> {
+  %0 = linalg_ext.gather {sort_indices} dimension_map = [0] ranged_data(false)
+         ins(%input, %indices : tensor<1024x8xf32>, tensor<16x1xi32>)
+         outs(%init : tensor<16x1x8xf32>) {
+         ^bb0(%arg0: f32, %arg1: f32):
+           %1 = arith.addf %arg0, %arg1 : f32
+           linalg_ext.yield %1 : f32
+         } -> tensor<16x1x8xf32>
+  return %0 : tensor<16x1x8xf32>
+}
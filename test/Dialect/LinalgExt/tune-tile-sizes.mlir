@@ -0,0 +1,102 @@
+// RUN: triton-linalg-opt %s -linalg-ext-tune-tile-sizes -split-input-file | FileCheck %s
+// RUN: cp %S/Inputs/tuning-database.json %t.json
+// RUN: triton-linalg-opt %s -linalg-ext-tune-tile-sizes="database=%t.json num-candidates=2" -split-input-file | FileCheck %s --check-prefix=TUNED
+// RUN: FileCheck %s --input-file=%t.json --check-prefix=DB
+// RUN: cp %S/Inputs/tuning-database.json %t.warn.json
+// RUN: triton-linalg-opt %s -linalg-ext-tune-tile-sizes="database=%t.warn.json" -split-input-file -verify-diagnostics -o /dev/null
+
+// The model tiles the rows, the untiled rhs being read by every tile.
+// CHECK-LABEL: func.func @matmul
+// CHECK-SAME: %[[ARG0:.*]]: tensor<64x64xf32>, %[[ARG1:.*]]: tensor<64x64xf32>, %[[ARG2:.*]]: tensor<64x64xf32>
+// CHECK-DAG: %[[C0:.*]] = arith.constant 0 : index
+// CHECK-DAG: %[[C32:.*]] = arith.constant 32 : index
+// CHECK-DAG: %[[C64:.*]] = arith.constant 64 : index
+// CHECK: %[[RES:.*]] = scf.for %[[I:.*]] = %[[C0]] to %[[C64]] step %[[C32]] iter_args(%[[ACC:.*]] = %[[ARG2]]) -> (tensor<64x64xf32>)
+// CHECK: %[[LHS:.*]] = tensor.extract_slice %[[ARG0]][%[[I]], 0] [32, 64] [1, 1]
+// CHECK: %[[OUT:.*]] = tensor.extract_slice %[[ACC]][%[[I]], 0] [32, 64] [1, 1]
+// CHECK: %[[MM:.*]] = linalg.matmul ins(%[[LHS]], %[[ARG1]] : tensor<32x64xf32>, tensor<64x64xf32>) outs(%[[OUT]] : tensor<32x64xf32>)
+// CHECK: %[[UPDATED:.*]] = tensor.insert_slice %[[MM]] into %[[ACC]][%[[I]], 0] [32, 64] [1, 1]
+// CHECK: scf.yield %[[UPDATED]]
+// CHECK: return %[[RES]]
+// The database holds measured tile sizes.
+// TUNED-LABEL: func.func @matmul
+// TUNED: scf.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C16:.*]] iter_args
+// TUNED: scf.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C32:.*]] iter_args
+// TUNED: linalg.matmul ins(%{{.*}}, %{{.*}} : tensor<16x64xf32>, tensor<64x32xf32>) outs(%{{.*}} : tensor<16x32xf32>)
+func.func @matmul(%arg0: tensor<64x64xf32>, %arg1: tensor<64x64xf32>, %arg2: tensor<64x64xf32>) -> tensor<64x64xf32> {
+  %0 = linalg.matmul ins(%arg0, %arg1 : tensor<64x64xf32>, tensor<64x64xf32>) outs(%arg2 : tensor<64x64xf32>) -> tensor<64x64xf32>
+  return %0 : tensor<64x64xf32>
+}
+
+// -----
+// The rows are kept whole for the vector lanes.
+// CHECK-LABEL: func.func @map
+// CHECK: scf.for %{{.*}} = %{{.*}} to %{{.*}} step %[[C8:.*]] iter_args
+// CHECK: linalg.map { arith.addf } ins(%{{.*}}, %{{.*}} : tensor<8x256xf32>, tensor<8x256xf32>) outs(%{{.*}} : tensor<8x256xf32>)
+// TUNED-LABEL: func.func @map
+// TUNED: linalg.map { arith.addf } ins(%{{.*}}, %{{.*}} : tensor<8x256xf32>, tensor<8x256xf32>)
+func.func @map(%arg0: tensor<256x256xf32>, %arg1: tensor<256x256xf32>) -> tensor<256x256xf32> {
+  %0 = tensor.empty() : tensor<256x256xf32>
+  %1 = linalg.map { arith.addf } ins(%arg0, %arg1 : tensor<256x256xf32>, tensor<256x256xf32>) outs(%0 : tensor<256x256xf32>)
+  return %1 : tensor<256x256xf32>
+}
+
+// -----
+// CHECK-LABEL: func.func @dynamic
+// CHECK-NOT: scf.for
+// CHECK: linalg.map
+func.func @dynamic(%arg0: tensor<?xf32>, %arg1: tensor<?xf32>) -> tensor<?xf32> {
+  %0 = linalg.map { math.exp } ins(%arg0 : tensor<?xf32>) outs(%arg1 : tensor<?xf32>)
+  return %0 : tensor<?xf32>
+}
+
+// -----
+// The stored tile sizes tiling the scanned loop are retuned, the model
+// leaving the scan whole.
+// CHECK-LABEL: func.func @scan
+// CHECK-NOT: scf.for
+// CHECK: linalg_ext.scan ins(%{{.*}} : tensor<16x64xf32>)
+// TUNED-LABEL: func.func @scan
+// TUNED-NOT: scf.for
+// TUNED: linalg_ext.scan ins(%{{.*}} : tensor<16x64xf32>)
+func.func @scan(%input: tensor<16x64xf32>, %output: tensor<16x64xf32>, %init: tensor<16xf32>) -> tensor<16x64xf32> {
+  // expected-warning @below {{retuning 'linalg_ext.scan[16x64:pr](f32,f32,f32)' whose tile sizes tile a loop which cannot be tiled}}
+  %0:2 = linalg_ext.scan ins(%input : tensor<16x64xf32>) outs(%output, %init : tensor<16x64xf32>, tensor<16xf32>) dimensions = [1] {
+  ^bb0(%in: f32, %out: f32, %ini: f32):
+    %1 = arith.addf %in, %ini : f32
+    linalg_ext.yield %1, %1 : f32, f32
+  } -> tensor<16x64xf32>, tensor<16xf32>
+  return %0#0 : tensor<16x64xf32>
+}
+
+// The model entries are added to the database, along with their best
+// candidates.
+// DB: "candidates": [
+// DB-NEXT: [
+// DB-NEXT: 8,
+// DB-NEXT: 256
+// DB-NEXT: ],
+// DB-NEXT: [
+// DB-NEXT: 16,
+// DB-NEXT: 128
+// DB-NEXT: ]
+// DB-NEXT: ],
+// DB-NEXT: "measured": false,
+// DB-NEXT: "signature": "linalg.map[256x256:pp](f32,f32,f32)",
+// DB-NEXT: "tile_sizes": [
+// DB-NEXT: 8,
+// DB-NEXT: 256
+// DB-NEXT: ]
+// DB: "measured": true,
+// DB-NEXT: "signature": "linalg.matmul[64x64x64:ppr](f32,f32,f32)",
+// DB-NEXT: "tile_sizes": [
+// DB-NEXT: 16,
+// DB-NEXT: 32,
+// DB-NEXT: 64
+// DB-NEXT: ]
+// DB: "measured": false,
+// DB-NEXT: "signature": "linalg_ext.scan[16x64:pr](f32,f32,f32)",
+// DB-NEXT: "tile_sizes": [
+// DB-NEXT: 16,
+// DB-NEXT: 64
+// DB-NEXT: ]
@@ -0,0 +1,27 @@
+// RUN: triton-linalg-opt %s -triton-to-linalg | FileCheck %s
+// RUN: triton-linalg-opt %s -triton-to-linalg="combine-atomic-rmw=true" | FileCheck %s --check-prefix=COMBINE
+
+// The offsets of the atomic are loaded from memory, so the atomic is marked
+// to be combined. It is only combined with the combine-atomic-rmw option.
+// CHECK-LABEL: func.func @atomic_add_loaded_offsets
+// CHECK-NOT: linalg.generic
+// CHECK: linalg_ext.gather_atomic_rmw addf {combine_indices}
+// COMBINE-LABEL: func.func @atomic_add_loaded_offsets
+// COMBINE: linalg.generic
+// COMBINE-SAME: iterator_types = ["parallel", "reduction"]
+// COMBINE: arith.minsi
+// COMBINE-NOT: combine_indices
+// COMBINE: linalg_ext.gather_atomic_rmw addf ins(
+tt.func public @atomic_add_loaded_offsets(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<f32>, %arg2: !tt.ptr<i32>) {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg2 : !tt.ptr<i32> -> tensor<128x!tt.ptr<i32>>
+  %2 = tt.addptr %1, %0 : tensor<128x!tt.ptr<i32>>, tensor<128xi32>
+  %3 = tt.load %2 : tensor<128x!tt.ptr<i32>>
+  %4 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %5 = tt.addptr %4, %0 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %6 = tt.load %5 : tensor<128x!tt.ptr<f32>>
+  %7 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %8 = tt.addptr %7, %3 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %9 = tt.atomic_rmw fadd, acq_rel, gpu, %8, %6 : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> tensor<128xf32>
+  tt.return
+}
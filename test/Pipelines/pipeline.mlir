@@ -1,5 +1,15 @@
 // RUN: triton-linalg-opt %s -triton-to-linalg -split-input-file | FileCheck %s
 
+// CHECK-LABEL: func.func @add_kernel_01234
+// CHECK: aux.view
+// CHECK: linalg.copy
+// CHECK: aux.view
+// CHECK: linalg.copy
+// CHECK: arith.addf
+// CHECK: aux.view
+// CHECK: bufferization.materialize_in_destination
+// CHECK-NOT: linalg_ext.gather
+// CHECK-NOT: linalg_ext.scatter
 tt.func public @add_kernel_01234(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<f32>, %arg2: !tt.ptr<f32>, %arg3: i32) {
   %c1024_i32 = arith.constant 1024 : i32
   %0 = tt.get_program_id x : i32
@@ -21,3 +31,35 @@ tt.func public @add_kernel_01234(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<f32>, %arg2
   tt.store %15, %13, %6 {cache = 1 : i32, evict = 1 : i32} : tensor<1024x!tt.ptr<f32>>
   tt.return
 }
+
+// -----
+// The exp has a use in the reduction before its elementwise consumer, which
+// keeps reading it once the exp is fused into the consumer.
+// CHECK-LABEL: func.func @exp_sum_kernel
+// CHECK: %[[X:.*]] = linalg.copy
+// CHECK: %[[EXP:.*]] = linalg.generic
+// CHECK: math.exp
+// CHECK: linalg.reduce {{.*}}ins(%[[EXP]] : tensor<128xf32>)
+// CHECK: linalg.generic
+// CHECK-SAME: ins(%[[X]], %[[X]] : tensor<128xf32>, tensor<128xf32>)
+// CHECK: math.exp
+// CHECK: arith.mulf
+// CHECK: bufferization.materialize_in_destination
+tt.func public @exp_sum_kernel(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<f32>, %arg2: !tt.ptr<f32>) {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %2 = tt.addptr %1, %0 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %3 = tt.load %2 : tensor<128x!tt.ptr<f32>>
+  %4 = math.exp %3 : tensor<128xf32>
+  %5 = "tt.reduce"(%4) ({
+  ^bb0(%arg3: f32, %arg4: f32):
+    %9 = arith.addf %arg3, %arg4 : f32
+    tt.reduce.return %9 : f32
+  }) {axis = 0 : i32} : (tensor<128xf32>) -> f32
+  tt.store %arg1, %5 : !tt.ptr<f32>
+  %6 = arith.mulf %4, %3 : tensor<128xf32>
+  %7 = tt.splat %arg2 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %8 = tt.addptr %7, %0 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  tt.store %8, %6 : tensor<128x!tt.ptr<f32>>
+  tt.return
+}
@@ -0,0 +1,26 @@
+// RUN: triton-linalg-opt %s -triton-to-linalg | FileCheck %s
+// RUN: triton-linalg-opt %s -triton-to-linalg="sort-gather-indices=true" | FileCheck %s --check-prefix=SORT
+
+// The offsets of the gather are loaded from memory, so the gather is marked
+// to be sorted. It is only sorted with the sort-gather-indices option.
+// CHECK-LABEL: func.func @gather_loaded_offsets
+// CHECK-NOT: linalg_ext.scatter
+// CHECK: linalg_ext.gather {sort_indices}
+// SORT-LABEL: func.func @gather_loaded_offsets
+// SORT-NOT: sort_indices
+// SORT: linalg_ext.scatter
+// SORT: linalg_ext.gather
+// SORT-NOT: sort_indices
+tt.func public @gather_loaded_offsets(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<i32>, %arg2: !tt.ptr<f32>) {
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  %1 = tt.splat %arg1 : !tt.ptr<i32> -> tensor<128x!tt.ptr<i32>>
+  %2 = tt.addptr %1, %0 : tensor<128x!tt.ptr<i32>>, tensor<128xi32>
+  %3 = tt.load %2 : tensor<128x!tt.ptr<i32>>
+  %4 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %5 = tt.addptr %4, %3 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  %6 = tt.load %5 : tensor<128x!tt.ptr<f32>>
+  %7 = tt.splat %arg2 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+  %8 = tt.addptr %7, %0 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+  tt.store %8, %6 : tensor<128x!tt.ptr<f32>>
+  tt.return
+}